@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "broadcast_ring.hpp"
+#include "market_data.hpp"
+#include "market_data_generator.hpp"
+
+/**
+    One producer fanning generated PackedMarketUpdates out to 1, 2 and 4
+    consumers through a BroadcastRing, Gated and Lossy. Each consumer does a little work per
+    update (a running notional) so they fall behind now and then.
+
+    Reports producer throughput and, per configuration, the worst
+    consumer's max lag and (Lossy) how much it lost.
+*/
+
+static constexpr size_t RING_SIZE = 4096;
+static constexpr uint64_t ITEMS = 5'000'000;
+
+using Ring = BroadcastRing<PackedMarketUpdate, RING_SIZE>;
+static constexpr size_t POOL_SIZE = 4096;
+
+static void run(const std::vector<PackedMarketUpdate>& pool, BroadcastMode mode, int numConsumers) {
+    auto ring = std::make_unique<Ring>(mode);
+    std::vector<int> ids;
+    for (int c = 0; c < numConsumers; ++c) ids.push_back(ring->subscribe());
+
+    std::atomic<bool> done{false};
+    std::vector<double> notionals(numConsumers);
+    std::vector<std::thread> consumers;
+
+    for (int c = 0; c < numConsumers; ++c) {
+        consumers.emplace_back([&, c] {
+            double notional = 0;
+            auto work = [&](const PackedMarketUpdate& update) { notional += double(update.price) * update.quantity; };
+            while (!done.load(std::memory_order_acquire) || ring->lag(ids[c]) > 0) {
+                if (ring->consume(ids[c], work) == 0) std::this_thread::yield();
+            }
+            notionals[c] = notional;
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < ITEMS; ++i) {
+        PackedMarketUpdate* slot;
+        while (!(slot = ring->claim())) std::this_thread::yield();
+        *slot = pool[i & (POOL_SIZE - 1)];
+        ring->commit();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    done.store(true, std::memory_order_release);
+    for (auto& consumer : consumers) consumer.join();
+
+    uint64_t maxLag = 0, dropped = 0;
+    for (int id : ids) {
+        BroadcastStats stats = ring->stats(id);
+        maxLag = std::max(maxLag, stats.maxLag);
+        dropped = std::max(dropped, stats.dropped);
+    }
+
+    printf("%-6s %d consumer(s) %8.1f Mupdates/s   worst max lag %5llu   worst dropped %8llu\n",
+           mode == BroadcastMode::Gated ? "gated" : "lossy", numConsumers, ITEMS / seconds / 1e6,
+           static_cast<unsigned long long>(maxLag), static_cast<unsigned long long>(dropped));
+}
+
+int main() {
+    printf("%u hardware threads, %zu-slot ring, %llu updates per run\n",
+           std::thread::hardware_concurrency(), RING_SIZE, static_cast<unsigned long long>(ITEMS));
+
+    SymbolRegistry registry;
+    MarketDataGenerator generator(GeneratorConfig{.rate = 0}, registry);
+    std::vector<PackedMarketUpdate> pool(POOL_SIZE);
+    for (PackedMarketUpdate& update : pool) generator.next(update);
+
+    for (BroadcastMode mode : {BroadcastMode::Gated, BroadcastMode::Lossy}) {
+        for (int consumers : {1, 2, 4}) {
+            run(pool, mode, consumers);
+        }
+    }
+    return 0;
+}
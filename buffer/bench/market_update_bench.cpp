@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "market_data.hpp"
+#include "market_data_generator.hpp"
+#include "ring_buffer.hpp"
+
+/**
+    MarketUpdate (48 bytes, symbol string, doubles) against
+    PackedMarketUpdate (32 bytes, symbol id, fixed point) through the same
+    SPSC RingBuffer between two threads, plus the cost of converting
+    between them.
+*/
+
+static constexpr size_t RING_SIZE = 1024;
+static constexpr uint64_t ITEMS = 20'000'000;
+static constexpr size_t POOL_SIZE = 4096;
+
+template<typename Update, typename Make>
+static double throughput(Make&& make) {
+    auto ring = std::make_unique<RingBuffer<Update, RING_SIZE>>();
+    uint64_t checksum = 0;
+
+    std::thread consumer([&] {
+        for (uint64_t i = 0; i < ITEMS; ++i) {
+            const Update* update;
+            while (!(update = ring->peek())) {
+                ring->release();
+                std::this_thread::yield();
+            }
+            checksum += update->timestamp;
+            if ((i & 63) == 63) ring->release();
+        }
+        ring->release();
+    });
+
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < ITEMS; ++i) {
+        Update* slot;
+        while (!(slot = ring->claim())) {
+            ring->commit();
+            std::this_thread::yield();
+        }
+        make(*slot, i);
+        if ((i & 63) == 63) ring->commit();
+    }
+    ring->commit();
+    consumer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (checksum != ITEMS * (ITEMS - 1) / 2) fprintf(stderr, "checksum mismatch\n");
+    return ITEMS / seconds;
+}
+
+int main() {
+    // A pool of generated updates, copied into the ring in turn: both
+    // forms carry the same content and pay only for their size
+    SymbolRegistry registry;
+    MarketDataGenerator generator(GeneratorConfig{.rate = 0}, registry);
+    std::vector<PackedMarketUpdate> packs(POOL_SIZE);
+    std::vector<MarketUpdate> updates(POOL_SIZE);
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        generator.next(packs[i]);
+        updates[i] = unpack(packs[i], registry);
+    }
+
+    double wide = throughput<MarketUpdate>([&](MarketUpdate& slot, uint64_t i) {
+        slot = updates[i & (POOL_SIZE - 1)];
+        slot.timestamp = i;
+    });
+    double packed = throughput<PackedMarketUpdate>([&](PackedMarketUpdate& slot, uint64_t i) {
+        slot = packs[i & (POOL_SIZE - 1)];
+        slot.timestamp = i;
+    });
+
+    printf("%u hardware threads, %zu-slot ring, %llu updates\n", std::thread::hardware_concurrency(), RING_SIZE,
+           static_cast<unsigned long long>(ITEMS));
+    printf("%-20s %3zu bytes  %8.1f M updates/s  %7.2f GB/s\n", "MarketUpdate", sizeof(MarketUpdate),
+           wide / 1e6, wide * sizeof(MarketUpdate) / 1e9);
+    printf("%-20s %3zu bytes  %8.1f M updates/s  %7.2f GB/s\n", "PackedMarketUpdate", sizeof(PackedMarketUpdate),
+           packed / 1e6, packed * sizeof(PackedMarketUpdate) / 1e9);
+
+    // Conversion cost, for consumers that want the wide form back
+    static constexpr int ROUNDS = 2000;
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < updates.size(); ++i) {
+            uint32_t id = packs[i].symbol_id;
+            packs[i] = pack(updates[i], id, registry.info(id), uint32_t(i));
+        }
+    }
+    double packNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    double sum = 0;
+    for (int r = 0; r < ROUNDS / 10; ++r) {
+        for (const PackedMarketUpdate& p : packs) sum += unpack(p, registry).price;
+    }
+    double unpackNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    printf("pack   %6.2f ns/update (registry lookup included)\n", packNs / (double(ROUNDS) * updates.size()));
+    printf("unpack %6.2f ns/update (registry lookup included)   [%g]\n",
+           unpackNs / (double(ROUNDS / 10) * updates.size()), sum > 0 ? 1.0 : 0.0);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "mpmc_queue.hpp"
+
+/**
+    Fan-in/fan-out throughput from 1 to 16 threads: MpmcQueue with P
+    producers and C consumers, MpscQueue with P producers and one consumer,
+    and a mutex around std::queue as the baseline either would replace.
+    Each configuration moves the same number of items in total; threads
+    are not pinned, so results past the machine's core count show the cost
+    of oversubscription.
+*/
+
+static constexpr size_t QUEUE_SIZE = 4096;
+static constexpr uint64_t ITEMS = 4'000'000;
+
+class MutexQueue {
+    private:
+        std::mutex mutex_;
+        std::queue<uint64_t> queue_;
+
+    public:
+        bool push(uint64_t item) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.size() >= QUEUE_SIZE) return false;
+            queue_.push(item);
+            return true;
+        }
+
+        bool pop(uint64_t& item) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty()) return false;
+            item = queue_.front();
+            queue_.pop();
+            return true;
+        }
+};
+
+template<typename Queue>
+static double run(int producers, int consumers) {
+    auto queue = std::make_unique<Queue>();
+    std::atomic<uint64_t> popped{0};
+    std::atomic<bool> go{false};
+    const uint64_t perProducer = ITEMS / producers;
+    const uint64_t total = perProducer * producers;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                while (!queue->push(i)) std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            uint64_t item;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                if (queue->pop(item)) {
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    return total / seconds / 1e6;
+}
+
+int main() {
+    printf("%u hardware threads, %zu-slot queues, %llu items per run (Mops/s)\n",
+           std::thread::hardware_concurrency(), QUEUE_SIZE, static_cast<unsigned long long>(ITEMS));
+    printf("%-8s %10s %10s %10s\n", "threads", "mpmc P=C", "mpsc P:1", "mutex P=C");
+
+    for (int threads : {2, 4, 8, 16}) {
+        int half = threads / 2;
+        printf("%-8d %10.1f %10.1f %10.1f\n", threads,
+               run<MpmcQueue<uint64_t, QUEUE_SIZE>>(half, half),
+               run<MpscQueue<uint64_t, QUEUE_SIZE>>(threads - 1, 1),
+               run<MutexQueue>(half, half));
+    }
+    return 0;
+}
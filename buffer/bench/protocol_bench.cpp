@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "market_data_generator.hpp"
+#include "protocol.hpp"
+
+/**
+    Cost of the binary protocol per message: encode into a buffer, decode
+    (validation and CRC32C included) out of it, and decode plus a book
+    touch, against the README target of message processing < 10 us at
+    p99. Messages are a generated feed mapped onto the four types. Every
+    message is timed on its own, clock reads included, so the tail shows;
+    the CRC32C engines are compared separately by throughput.
+*/
+
+static constexpr size_t POOL_SIZE = 4096;
+static constexpr int ROUNDS = 100;
+
+struct Result {
+    double mean, p50, p99, p999, max;
+};
+
+template<typename F>
+static Result measure(F&& call) {
+    std::vector<double> samples;
+    samples.reserve(POOL_SIZE * ROUNDS);
+
+    double total = 0;
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < POOL_SIZE; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            call(i);
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            samples.push_back(ns);
+            total += ns;
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[size_t(q * (samples.size() - 1))]; };
+    return {total / samples.size(), at(0.5), at(0.99), at(0.999), samples.back()};
+}
+
+static void report(const char* name, const Result& r) {
+    printf("%-18s mean %7.1f ns  p50 %7.1f  p99 %7.1f  p99.9 %8.1f  max %9.1f   p99 %s 10 us\n", name, r.mean,
+           r.p50, r.p99, r.p999, r.max, r.p99 < 10'000 ? "<" : ">=");
+}
+
+int main() {
+    // Quotes become adds, deletions deletes, every third quote on a level
+    // a modify of it; prints are trades
+    SymbolRegistry registry;
+    MarketDataGenerator generator(GeneratorConfig{.rate = 0}, registry);
+    std::vector<AnyMessage> messages(POOL_SIZE);
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        PackedMarketUpdate update;
+        generator.next(update);
+        MessageHeader header{0, 0, MessageType::Add, update.side, update.sequence, update.symbol_id, update.timestamp};
+        uint64_t order = uint64_t(update.price) << 8 | update.symbol_id;
+
+        AnyMessage& message = messages[i];
+        if (update.side == Side::Trade) {
+            message.trade = TradeMessage{header, order, update.price, update.quantity};
+            message.header.type = MessageType::Trade;
+        } else if (update.quantity == 0) {
+            message.remove = DeleteMessage{header, order};
+            message.header.type = MessageType::Delete;
+        } else if (i % 3 == 0) {
+            message.modify = ModifyMessage{header, order, update.price, update.quantity};
+            message.header.type = MessageType::Modify;
+        } else {
+            message.add = AddMessage{header, order, update.price, update.quantity};
+        }
+    }
+
+    // The pool encoded back to back, as a stream carries it
+    std::vector<char> wire(POOL_SIZE * MAX_MESSAGE_SIZE);
+    std::vector<size_t> offsets(POOL_SIZE);
+    size_t used = 0;
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        offsets[i] = used;
+        const AnyMessage& message = messages[i];
+        switch (message.header.type) {
+            case MessageType::Add: used += encode(message.add, wire.data() + used); break;
+            case MessageType::Modify: used += encode(message.modify, wire.data() + used); break;
+            case MessageType::Delete: used += encode(message.remove, wire.data() + used); break;
+            case MessageType::Trade: used += encode(message.trade, wire.data() + used); break;
+        }
+    }
+
+    char out[MAX_MESSAGE_SIZE];
+    uint64_t sink = 0;
+    Result encoded = measure([&](size_t i) {
+        const AnyMessage& message = messages[i];
+        switch (message.header.type) {
+            case MessageType::Add: sink += encode(message.add, out); break;
+            case MessageType::Modify: sink += encode(message.modify, out); break;
+            case MessageType::Delete: sink += encode(message.remove, out); break;
+            case MessageType::Trade: sink += encode(message.trade, out); break;
+        }
+    });
+
+    AnyMessage decoded;
+    size_t failures = 0;
+    Result plain = measure([&](size_t i) {
+        failures += decode(wire.data() + offsets[i], used - offsets[i], decoded) != DecodeError::None;
+    });
+
+    // Decode and apply: the level's resting quantity per symbol and type
+    std::vector<int64_t> book(registry.size() * 8);
+    Result processed = measure([&](size_t i) {
+        if (decode(wire.data() + offsets[i], used - offsets[i], decoded) != DecodeError::None) {
+            failures++;
+            return;
+        }
+        int64_t& level = book[decoded.header.symbol_id * 8 + uint8_t(decoded.header.type)];
+        level += decoded.header.type == MessageType::Delete ? -1 : decoded.add.quantity;
+    });
+
+    printf("%zu messages, %zu bytes on the wire (%.1f bytes/message), %d rounds\n", POOL_SIZE, used,
+           double(used) / POOL_SIZE, ROUNDS);
+    report("encode", encoded);
+    report("decode", plain);
+    report("decode + apply", processed);
+
+    // CRC32C engines over the whole stream
+    auto rate = [&](auto&& crc) {
+        uint32_t value = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; ++r) value = crc(wire.data(), used, value);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        sink += value;
+        return used * double(ROUNDS) / seconds / 1e9;
+    };
+    printf("crc32c table     %7.2f GB/s\n", rate([](const char* data, size_t size, uint32_t crc) {
+        return crc32cTable(data, size, crc);
+    }));
+#if defined(__x86_64__)
+    if (hasHardwareCrc32c()) {
+        printf("crc32c sse4.2    %7.2f GB/s\n", rate([](const char* data, size_t size, uint32_t crc) {
+            return crc32cHardware(data, size, crc);
+        }));
+    }
+#endif
+
+    if (failures) fprintf(stderr, "%zu messages failed to decode\n", failures);
+    printf("[%llu]\n", static_cast<unsigned long long>(sink + book[0]));
+    return failures == 0 ? 0 : 1;
+}
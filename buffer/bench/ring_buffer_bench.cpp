@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <span>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_buffer.hpp"
+
+/**
+    SPSC handoff between two pinned threads, current RingBuffer against the
+    modulo/shared-counter version it replaced (kept below verbatim).
+
+    throughput: producer pushes flat out, consumer pops flat out; "bulk"
+                moves the same items 32 at a time through push_bulk/pop_bulk
+    latency:    one item in flight; the consumer stamps the time it saw the
+                item against the time the producer pushed it
+
+    usage: ring_buffer_bench [producer_cpu consumer_cpu]   (default 0 1)
+*/
+
+static constexpr size_t RING_SIZE = 1024;
+static constexpr uint64_t THROUGHPUT_ITEMS = 20'000'000;
+static constexpr int LATENCY_SAMPLES = 200'000;
+
+template<typename T, size_t Size>
+class LegacyRingBuffer {
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+        static constexpr size_t BUFFER_SIZE = Size;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_count_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> pop_count_{0};
+
+        alignas(CACHE_LINE_SIZE) std::array<T, BUFFER_SIZE> buffer_;
+
+    public:
+        bool push(const T& item) {
+            uint64_t current_tail = tail_.load(std::memory_order_relaxed);
+            uint64_t next_tail = (current_tail + 1) % BUFFER_SIZE;
+
+            if (next_tail == head_.load(std::memory_order_acquire))
+                return false;
+
+            buffer_[current_tail] = item;
+            tail_.store(next_tail, std::memory_order_release);
+            push_count_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool pop(T& item) {
+            uint64_t current_head = head_.load(std::memory_order_relaxed);
+
+            if (current_head == tail_.load(std::memory_order_acquire))
+                return false;
+
+            item = buffer_[current_head];
+            head_.store((current_head + 1) % BUFFER_SIZE, std::memory_order_release);
+            pop_count_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+};
+
+static void pin(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "warning: could not pin to cpu %d\n", cpu);
+    }
+}
+
+static uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template<typename Ring>
+static double throughput(int producerCpu, int consumerCpu) {
+    auto ring = std::make_unique<Ring>();
+    uint64_t checksum = 0;
+
+    std::thread consumer([&] {
+        pin(consumerCpu);
+        uint64_t value;
+        for (uint64_t i = 0; i < THROUGHPUT_ITEMS; ++i) {
+            while (!ring->pop(value)) std::this_thread::yield();
+            checksum += value;
+        }
+    });
+
+    pin(producerCpu);
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < THROUGHPUT_ITEMS; ++i) {
+        while (!ring->push(i)) std::this_thread::yield();
+    }
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    if (checksum != THROUGHPUT_ITEMS * (THROUGHPUT_ITEMS - 1) / 2) {
+        fprintf(stderr, "checksum mismatch\n");
+        std::exit(1);
+    }
+    return THROUGHPUT_ITEMS / seconds;
+}
+
+// push_bulk/pop_bulk in batches of BATCH, one index store per batch
+template<size_t BATCH>
+static double bulkThroughput(int producerCpu, int consumerCpu) {
+    auto ring = std::make_unique<RingBuffer<uint64_t, RING_SIZE>>();
+    uint64_t checksum = 0;
+
+    std::thread consumer([&] {
+        pin(consumerCpu);
+        std::array<uint64_t, BATCH> out;
+        for (uint64_t received = 0; received < THROUGHPUT_ITEMS;) {
+            size_t count = ring->pop_bulk(out);
+            if (count == 0) std::this_thread::yield();
+            for (size_t i = 0; i < count; ++i) checksum += out[i];
+            received += count;
+        }
+    });
+
+    pin(producerCpu);
+    auto begin = std::chrono::steady_clock::now();
+    std::array<uint64_t, BATCH> batch;
+    for (uint64_t next = 0; next < THROUGHPUT_ITEMS;) {
+        size_t count = std::min<uint64_t>(BATCH, THROUGHPUT_ITEMS - next);
+        for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+
+        std::span<const uint64_t> pending(batch.data(), count);
+        while (!pending.empty()) {
+            size_t pushed = ring->push_bulk(pending);
+            if (pushed == 0) std::this_thread::yield();
+            pending = pending.subspan(pushed);
+        }
+        next += count;
+    }
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    if (checksum != THROUGHPUT_ITEMS * (THROUGHPUT_ITEMS - 1) / 2) {
+        fprintf(stderr, "checksum mismatch\n");
+        std::exit(1);
+    }
+    return THROUGHPUT_ITEMS / seconds;
+}
+
+template<typename Ring>
+static std::vector<double> latency(int producerCpu, int consumerCpu) {
+    auto ring = std::make_unique<Ring>();
+    std::vector<double> samples(LATENCY_SAMPLES);
+    std::atomic<int> received{0};
+
+    std::thread consumer([&] {
+        pin(consumerCpu);
+        uint64_t sent;
+        for (int i = 0; i < LATENCY_SAMPLES; ++i) {
+            while (!ring->pop(sent)) std::this_thread::yield();
+            samples[i] = double(nowNanos() - sent);
+            received.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    pin(producerCpu);
+    for (int i = 0; i < LATENCY_SAMPLES; ++i) {
+        ring->push(nowNanos());
+        while (received.load(std::memory_order_acquire) <= i) std::this_thread::yield();
+    }
+    consumer.join();
+
+    std::sort(samples.begin(), samples.end());
+    return samples;
+}
+
+template<typename Ring>
+static void report(const char* name, int producerCpu, int consumerCpu) {
+    double opsPerSec = throughput<Ring>(producerCpu, consumerCpu);
+    std::vector<double> samples = latency<Ring>(producerCpu, consumerCpu);
+
+    auto pct = [&](double p) { return samples[static_cast<size_t>(samples.size() * p)]; };
+    printf("%-8s %8.1f Mops/s   handoff p50 %6.0f ns  p99 %7.0f ns  p999 %8.0f ns\n",
+           name, opsPerSec / 1e6, pct(0.50), pct(0.99), pct(0.999));
+}
+
+int main(int argc, char** argv) {
+    int producerCpu = argc > 2 ? std::atoi(argv[1]) : 0;
+    int consumerCpu = argc > 2 ? std::atoi(argv[2]) : 1;
+
+    printf("%zu-slot ring, %llu items, %d latency samples, cpus %d -> %d\n", RING_SIZE,
+           static_cast<unsigned long long>(THROUGHPUT_ITEMS), LATENCY_SAMPLES, producerCpu, consumerCpu);
+
+    report<LegacyRingBuffer<uint64_t, RING_SIZE>>("legacy", producerCpu, consumerCpu);
+    report<RingBuffer<uint64_t, RING_SIZE>>("current", producerCpu, consumerCpu);
+    printf("%-8s %8.1f Mops/s   (push_bulk/pop_bulk, 32 per batch)\n", "bulk",
+           bulkThroughput<32>(producerCpu, consumerCpu) / 1e6);
+    return 0;
+}
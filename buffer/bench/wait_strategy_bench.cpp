@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "ring_buffer.hpp"
+#include "wait_strategy.hpp"
+
+/**
+    Consumer CPU against handoff latency for each wait strategy, with the
+    producer pacing timestamps into a RingBuffer at a fixed rate.
+
+    CPU is the consumer thread's own CPU time over wall time (100% = one
+    core busy the whole run); latency is producer stamp to consumer pop.
+    The producer spins between messages at high rates and sleeps at low
+    ones, the same for every strategy.
+*/
+
+static constexpr size_t RING_SIZE = 1024;
+static constexpr double RUN_SECONDS = 0.5;
+
+static uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double threadCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template<typename Wait>
+static void run(const char* name, double rate) {
+    auto ring = std::make_unique<RingBuffer<uint64_t, RING_SIZE, Wait>>();
+    std::atomic<bool> running{true};
+    const uint64_t messages = static_cast<uint64_t>(rate * RUN_SECONDS);
+
+    std::vector<double> latencies;
+    latencies.reserve(messages);
+    double cpu = 0, wall = 0;
+
+    std::thread consumer([&] {
+        double cpuStart = threadCpuSeconds();
+        auto wallStart = std::chrono::steady_clock::now();
+
+        uint64_t sent;
+        while (ring->pop_wait(sent, running)) {
+            latencies.push_back(double(nowNanos() - sent));
+        }
+
+        cpu = threadCpuSeconds() - cpuStart;
+        wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    });
+
+    const uint64_t interval = static_cast<uint64_t>(1e9 / rate);
+    uint64_t due = nowNanos();
+    for (uint64_t i = 0; i < messages; ++i) {
+        due += interval;
+        uint64_t now = nowNanos();
+        if (due > now + 100'000) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(due - now - 50'000));
+        }
+        while (nowNanos() < due) cpuRelax();
+
+        ring->push_wait(nowNanos(), running);
+    }
+
+    // let the consumer drain, then stop it
+    while (ring->size() > 0) std::this_thread::yield();
+    running = false;
+    ring->wake();
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) { return latencies[static_cast<size_t>(latencies.size() * p)] / 1000; };
+    printf("%-18s %9.0f msg/s   cpu %5.1f%%   p50 %8.2f us   p99 %8.2f us   p999 %8.2f us\n",
+           name, rate, 100 * cpu / wall, pct(0.5), pct(0.99), pct(0.999));
+}
+
+int main() {
+    printf("%u hardware threads, %zu-slot ring, %.1fs per run\n",
+           std::thread::hardware_concurrency(), RING_SIZE, RUN_SECONDS);
+
+    for (double rate : {1e3, 1e4, 1e5, 1e6}) {
+        run<BusySpinWait>("BusySpinWait", rate);
+        run<SpinYieldWait>("SpinYieldWait", rate);
+        run<SpinParkWait>("SpinParkWait", rate);
+        run<TimedBlockingWait>("TimedBlockingWait", rate);
+    }
+    return 0;
+}
@@ -0,0 +1,322 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ring_buffer.hpp"
+
+/**
+    Logging off the hot path. A log call copies its arguments as raw bytes
+    into a fixed-size record on the calling thread's own SPSC ring and
+    returns: no formatting, no locks, no syscalls. A background thread
+    drains every thread's ring, formats the records and hands the text to
+    the kernel in batched write()s.
+
+    The format string is its own id: a LogFormat is a static object and
+    records carry its address. Each argument is stored next to the
+    function that prints its type, so enums and small structs with an
+    operator<< log as cheaply as numbers. Strings are copied, truncated to
+    what is left of the record.
+
+    A full ring drops the record and counts it rather than block the
+    caller. One thread's records stay in order; records of different
+    threads are interleaved per drain pass, not sorted by time.
+*/
+
+struct LogFormat {
+    const char* text;  // "{}" marks each argument
+};
+
+using LogPrinter = void (*)(std::string& out, const char* data, size_t size);
+
+struct alignas(64) LogRecord {
+    static constexpr size_t ARGS_SIZE = 238;
+
+    uint64_t timestamp;  // ns since epoch, 0 when the logger prints none
+    const LogFormat* format;
+    uint16_t size;       // bytes of args in use
+    char args[ARGS_SIZE];  // per argument: LogPrinter, uint8_t length, bytes
+};
+static_assert(sizeof(LogRecord) == 256, "log records are four cache lines");
+
+namespace logdetail {
+    static constexpr size_t ARG_HEADER = sizeof(LogPrinter) + 1;
+
+    template<typename T>
+    void printValue(std::string& out, const char* data, size_t) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+
+        if constexpr (std::is_same_v<T, bool>) {
+            out += value ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, char>) {
+            out += value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            char buf[32];
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 12).ptr);
+        } else if constexpr (std::is_integral_v<T>) {
+            char buf[24];
+            out.append(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr);
+        } else {
+            thread_local std::ostringstream os;
+            os.str("");
+            os << value;
+            out += os.str();
+        }
+    }
+
+    inline void printString(std::string& out, const char* data, size_t size) {
+        out.append(data, size);
+    }
+
+    inline void put(char*& pos, const char* end, LogPrinter printer, const void* data, size_t size) {
+        if (pos + ARG_HEADER > end) return;
+        size = std::min({size, size_t(end - pos - ARG_HEADER), size_t(UINT8_MAX)});
+
+        std::memcpy(pos, &printer, sizeof(printer));
+        pos[sizeof(printer)] = static_cast<char>(size);
+        std::memcpy(pos + ARG_HEADER, data, size);
+        pos += ARG_HEADER + size;
+    }
+
+    template<typename T>
+    void encode(char*& pos, const char* end, const T& value) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view text(value);
+            put(pos, end, &printString, text.data(), text.size());
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>, "log arguments are copied as bytes");
+            // All or nothing: a truncated number would print garbage
+            if (pos + ARG_HEADER + sizeof(T) > end) return;
+            put(pos, end, &printValue<T>, &value, sizeof(T));
+        }
+    }
+}
+
+class AsyncLogger {
+    public:
+        static constexpr size_t RING_SIZE = 1024;           // records per thread
+        static constexpr size_t BATCH_BYTES = 64 * 1024;    // text per write()
+        static constexpr std::chrono::microseconds IDLE_SLEEP{1000};
+
+    private:
+        struct Producer {
+            RingBuffer<LogRecord, RING_SIZE> ring;
+            std::atomic<uint64_t> dropped{0};
+        };
+
+        static inline std::atomic<uint64_t> next_id_{1};
+
+        const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+        const int fd_;
+        const bool owns_fd_;
+        const bool timestamps_;
+
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<Producer>> producers_;  // append only
+
+        std::atomic<bool> running_{true};
+        std::atomic<uint64_t> passes_{0};
+        std::thread writer_;
+
+        // This thread's ring for this logger, registered on first use. The
+        // thread keeps its rings alive, so a logger never outlives a ring.
+        Producer& producer() {
+            thread_local uint64_t last_id = 0;
+            thread_local Producer* last = nullptr;
+            if (last_id == id_) return *last;
+
+            thread_local std::vector<std::pair<uint64_t, std::shared_ptr<Producer>>> mine;
+            auto it = std::find_if(mine.begin(), mine.end(), [&](const auto& entry) { return entry.first == id_; });
+            if (it == mine.end()) {
+                auto created = std::make_shared<Producer>();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    producers_.push_back(created);
+                }
+                mine.emplace_back(id_, created);
+                it = std::prev(mine.end());
+            }
+
+            last_id = id_;
+            last = it->second.get();
+            return *last;
+        }
+
+        void format(std::string& out, const LogRecord& record) const {
+            char buf[24];
+            if (timestamps_) {
+                uint64_t seconds = record.timestamp / 1000000000;
+                uint64_t micros = record.timestamp % 1000000000 / 1000;
+                out += '[';
+                out.append(buf, std::to_chars(buf, buf + sizeof(buf), seconds).ptr);
+                out += '.';
+                char* end = std::to_chars(buf, buf + sizeof(buf), micros).ptr;
+                out.append(6 - (end - buf), '0');
+                out.append(buf, end);
+                out += "] ";
+            }
+
+            const char* arg = record.args;
+            const char* end = record.args + record.size;
+            for (const char* c = record.format->text; *c; ++c) {
+                if (c[0] != '{' || c[1] != '}') {
+                    out += *c;
+                    continue;
+                }
+
+                ++c;
+                if (arg + logdetail::ARG_HEADER > end) {
+                    out += "{}";  // argument did not fit the record
+                    continue;
+                }
+
+                LogPrinter printer;
+                std::memcpy(&printer, arg, sizeof(printer));
+                size_t size = static_cast<uint8_t>(arg[sizeof(printer)]);
+                printer(out, arg + logdetail::ARG_HEADER, size);
+                arg += logdetail::ARG_HEADER + size;
+            }
+            out += '\n';
+        }
+
+        void writeOut(std::string& out) {
+            const char* data = out.data();
+            size_t left = out.size();
+            while (left > 0) {
+                ssize_t n = ::write(fd_, data, left);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    break;  // nowhere to report it; the batch is lost
+                }
+                data += n;
+                left -= n;
+            }
+            out.clear();
+        }
+
+        void run() {
+            std::vector<std::shared_ptr<Producer>> producers;
+            std::string out;
+            out.reserve(BATCH_BYTES + 4096);
+
+            while (true) {
+                bool stopping = !running_.load(std::memory_order_acquire);
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (producers.size() != producers_.size()) producers = producers_;
+                }
+
+                size_t drained = 0;
+                for (auto& producer : producers) {
+                    while (const LogRecord* record = producer->ring.peek()) {
+                        format(out, *record);
+                        if (++drained % 64 == 0) producer->ring.release();
+                        if (out.size() >= BATCH_BYTES) writeOut(out);
+                    }
+                    producer->ring.release();
+                }
+                writeOut(out);
+                passes_.fetch_add(1, std::memory_order_release);
+
+                if (stopping) return;  // that pass ran after stop, nothing is left
+                if (drained == 0) std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+        }
+
+    public:
+        // Appends to path; throws if it cannot be opened
+        explicit AsyncLogger(const std::string& path, bool timestamps = true) :
+            fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)),
+            owns_fd_(true), timestamps_(timestamps) {
+            if (fd_ < 0) throw std::runtime_error("log " + path + ": " + std::strerror(errno));
+            writer_ = std::thread(&AsyncLogger::run, this);
+        }
+
+        // Writes to an fd it does not own, e.g. STDOUT_FILENO
+        explicit AsyncLogger(int fd, bool timestamps = true) :
+            fd_(fd), owns_fd_(false), timestamps_(timestamps) {
+            writer_ = std::thread(&AsyncLogger::run, this);
+        }
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // Writes everything logged before it, then closes
+        ~AsyncLogger() {
+            running_.store(false, std::memory_order_release);
+            writer_.join();
+            if (owns_fd_) ::close(fd_);
+        }
+
+        // One logger per file for the whole process, so every writer of a
+        // file shares its ordering and batching
+        static AsyncLogger& file(const std::string& path) {
+            static std::mutex mutex;
+            static std::map<std::string, std::unique_ptr<AsyncLogger>> loggers;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& logger = loggers[path];
+            if (!logger) logger = std::make_unique<AsyncLogger>(path);
+            return *logger;
+        }
+
+        // Standard output, without timestamps
+        static AsyncLogger& console() {
+            static AsyncLogger logger(STDOUT_FILENO, false);
+            return logger;
+        }
+
+        template<typename... Args>
+        void log(const LogFormat& format, const Args&... args) {
+            Producer& producer = this->producer();
+            LogRecord* record = producer.ring.claim();
+            if (!record) {
+                producer.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            record->timestamp = timestamps_ ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count() : 0;
+            record->format = &format;
+
+            char* pos = record->args;
+            (logdetail::encode(pos, record->args + LogRecord::ARGS_SIZE, args), ...);
+            record->size = static_cast<uint16_t>(pos - record->args);
+
+            producer.ring.commit();
+        }
+
+        // Returns once everything logged before the call (on this thread,
+        // or visibly to it) has been written
+        void flush() {
+            uint64_t target = passes_.load(std::memory_order_acquire) + 2;
+            while (passes_.load(std::memory_order_acquire) < target) {
+                std::this_thread::sleep_for(IDLE_SLEEP / 10);
+            }
+        }
+
+        // Records lost to full rings, across all threads
+        uint64_t dropped() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t total = 0;
+            for (auto& producer : producers_) total += producer->dropped.load(std::memory_order_relaxed);
+            return total;
+        }
+};
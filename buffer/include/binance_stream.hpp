@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include "market_data.hpp"
+
+/**
+    Binance market streams to MarketUpdate, one update per price level.
+
+    Understands diff-depth ("e":"depthUpdate"), trade and aggTrade
+    (side 'T', price and size of the print) and bookTicker payloads,
+    raw or wrapped in a combined-stream envelope ({"stream":..,"data":..}).
+    Scans the payload in place with from_chars: no DOM, no allocation.
+    Updates are stamped with the frame's arrival time so consumers can
+    measure feed latency; zero-quantity depth levels (deletions) are kept.
+*/
+
+namespace binance_detail {
+
+// Position just past "key": in msg, or npos
+inline size_t findKey(std::string_view msg, std::string_view key, size_t from = 0) {
+    while ((from = msg.find(key, from)) != std::string_view::npos) {
+        size_t end = from + key.size();
+        if (from > 0 && msg[from - 1] == '"' && end + 1 < msg.size() && msg[end] == '"' && msg[end + 1] == ':') {
+            return end + 2;
+        }
+        from = end;
+    }
+    return std::string_view::npos;
+}
+
+// Quoted string starting at pos (whitespace skipped); advances pos past it
+inline bool readString(std::string_view msg, size_t& pos, std::string_view& out) {
+    while (pos < msg.size() && msg[pos] == ' ') pos++;
+    if (pos >= msg.size() || msg[pos] != '"') return false;
+
+    size_t end = msg.find('"', pos + 1);
+    if (end == std::string_view::npos) return false;
+
+    out = msg.substr(pos + 1, end - pos - 1);
+    pos = end + 1;
+    return true;
+}
+
+inline bool readNumber(std::string_view msg, size_t& pos, double& out) {
+    std::string_view text;
+    if (!readString(msg, pos, text)) return false;
+    return std::from_chars(text.data(), text.data() + text.size(), out).ec == std::errc();
+}
+
+inline MarketUpdate makeUpdate(uint64_t arrival, double price, double quantity, std::string_view symbol, char side) {
+    MarketUpdate update;
+    update.timestamp = arrival;
+    update.price = price;
+    update.quantity = quantity;
+    update.side = side;
+
+    size_t len = std::min(symbol.size(), sizeof(update.symbol) - 1);
+    std::memcpy(update.symbol, symbol.data(), len);
+    update.symbol[len] = '\0';
+    return update;
+}
+
+// [["price","qty"],...] starting at pos
+template<typename Emit>
+size_t readLevels(std::string_view msg, size_t pos, uint64_t arrival, std::string_view symbol, char side, Emit&& emit) {
+    size_t count = 0;
+    if (pos >= msg.size() || msg[pos] != '[') return 0;
+    pos++;
+
+    while (pos < msg.size()) {
+        while (pos < msg.size() && (msg[pos] == ',' || msg[pos] == ' ')) pos++;
+        if (pos >= msg.size() || msg[pos] != '[') break;
+        pos++;
+
+        double price, quantity;
+        if (!readNumber(msg, pos, price)) break;
+        if (pos >= msg.size() || msg[pos] != ',') break;
+        pos++;
+        if (!readNumber(msg, pos, quantity)) break;
+
+        pos = msg.find(']', pos);
+        if (pos == std::string_view::npos) break;
+        pos++;
+
+        emit(makeUpdate(arrival, price, quantity, symbol, side));
+        count++;
+    }
+    return count;
+}
+
+}  // namespace binance_detail
+
+// Calls emit(const MarketUpdate&) for every level in msg, returns how many
+template<typename Emit>
+size_t parseBinanceMessage(std::string_view msg, uint64_t arrival, Emit&& emit) {
+    using namespace binance_detail;
+
+    // Combined streams: only the data object matters
+    size_t data = findKey(msg, "data");
+    if (data != std::string_view::npos) msg = msg.substr(data);
+
+    std::string_view symbol;
+    size_t pos = findKey(msg, "s");
+    if (pos == std::string_view::npos || !readString(msg, pos, symbol)) return 0;
+
+    std::string_view event;
+    pos = findKey(msg, "e");
+    bool depth = pos != std::string_view::npos && readString(msg, pos, event) && event == "depthUpdate";
+
+    if (depth) {
+        size_t count = 0;
+        if ((pos = findKey(msg, "b")) != std::string_view::npos) count += readLevels(msg, pos, arrival, symbol, 'B', emit);
+        if ((pos = findKey(msg, "a")) != std::string_view::npos) count += readLevels(msg, pos, arrival, symbol, 'A', emit);
+        return count;
+    }
+
+    if (event == "trade" || event == "aggTrade") {
+        double price, quantity;
+        size_t p = findKey(msg, "p"), q = findKey(msg, "q");
+        if (p == std::string_view::npos || q == std::string_view::npos ||
+            !readNumber(msg, p, price) || !readNumber(msg, q, quantity)) {
+            return 0;
+        }
+        emit(makeUpdate(arrival, price, quantity, symbol, 'T'));
+        return 1;
+    }
+
+    // bookTicker: "b"/"B" best bid price/qty, "a"/"A" best ask
+    double bid, bidQty, ask, askQty;
+    size_t b = findKey(msg, "b"), bq = findKey(msg, "B"), a = findKey(msg, "a"), aq = findKey(msg, "A");
+    if (b == std::string_view::npos || bq == std::string_view::npos ||
+        a == std::string_view::npos || aq == std::string_view::npos) {
+        return 0;
+    }
+    if (!readNumber(msg, b, bid) || !readNumber(msg, bq, bidQty) ||
+        !readNumber(msg, a, ask) || !readNumber(msg, aq, askQty)) {
+        return 0;
+    }
+
+    emit(makeUpdate(arrival, bid, bidQty, symbol, 'B'));
+    emit(makeUpdate(arrival, ask, askQty, symbol, 'A'));
+    return 2;
+}
+
+// Parses msg straight into ring slots and publishes all of its levels at
+// once, waiting for the consumer when the ring is full. Ring is a
+// RingBuffer or a BroadcastRing.
+template<typename Ring>
+size_t pushBinanceMessage(Ring& ring, std::string_view msg, uint64_t arrival) {
+    size_t count = parseBinanceMessage(msg, arrival, [&ring](const MarketUpdate& update) {
+        MarketUpdate* slot;
+        while (!(slot = ring.claim())) {
+            ring.commit();
+            std::this_thread::yield();
+        }
+        *slot = update;
+    });
+    ring.commit();
+    return count;
+}
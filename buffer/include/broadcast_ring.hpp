@@ -0,0 +1,284 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include "wait_strategy.hpp"
+
+enum class BroadcastMode {
+    Gated,  // producer waits for the slowest consumer
+    Lossy,  // producer never waits; lapped consumers skip ahead and count the gap
+};
+
+struct BroadcastStats {
+    uint64_t consumed = 0;  // items handed to this consumer
+    uint64_t lag = 0;       // published but not yet consumed, right now
+    uint64_t maxLag = 0;    // largest lag seen at the start of a consume()
+    uint64_t dropped = 0;   // overwritten before this consumer got to them (Lossy)
+};
+
+/**
+    One producer, up to MaxConsumers independent consumers, every consumer
+    sees every item (Disruptor-style). Items live in the ring only once;
+    each consumer has its own cursor on its own cache line.
+
+    Gated: the producer's claim() fails while the slowest active consumer
+    is Size items behind, so consume() hands out references straight into
+    the ring. The minimum cursor is cached and only recomputed when the
+    cached one says the ring is full.
+
+    Lossy: the producer overwrites regardless. Every slot carries the
+    sequence of the item in it, and consume() copies an item out and checks
+    that sequence before and after (a seqlock), so a lapped consumer never
+    sees a torn item; it jumps to the oldest item still in the ring and
+    adds what it skipped to its dropped count.
+
+    Producer side mirrors RingBuffer: push, or claim()/commit() to build
+    items in place and publish a batch with one store. claim_wait and
+    consume_wait block per the Wait strategy, as in RingBuffer.
+*/
+template<typename T, size_t Size, size_t MaxConsumers = 8, typename Wait = BusySpinWait>
+class BroadcastRing {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "BroadcastRing size must be a power of two");
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+        static constexpr uint64_t MASK = Size - 1;
+
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};  // position + 1 of the item held, 0 while written
+            T data;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) Consumer {
+            std::atomic<uint64_t> cursor{0};
+            std::atomic<bool> active{false};
+            uint64_t start = 0;
+            std::atomic<uint64_t> maxLag{0};
+            std::atomic<uint64_t> dropped{0};
+        };
+
+        const BroadcastMode mode_;
+
+        // Producer side
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> published_{0};
+        alignas(CACHE_LINE_SIZE) uint64_t cached_min_ = 0;
+        uint64_t claimed_ = 0;
+
+        std::array<Consumer, MaxConsumers> consumers_;
+
+        alignas(CACHE_LINE_SIZE) Wait published_wait_;  // consumers wait, producer notifies
+        alignas(CACHE_LINE_SIZE) Wait space_wait_;      // producer waits, consumers notify (Gated)
+
+        alignas(CACHE_LINE_SIZE) std::array<Slot, Size> slots_;
+
+        // Slowest active cursor, or next when nobody is subscribed
+        uint64_t minCursor(uint64_t next) const {
+            uint64_t min = next;
+            for (const Consumer& consumer : consumers_) {
+                if (consumer.active.load(std::memory_order_acquire)) {
+                    min = std::min(min, consumer.cursor.load(std::memory_order_acquire));
+                }
+            }
+            return min;
+        }
+
+    public:
+        explicit BroadcastRing(BroadcastMode mode = BroadcastMode::Gated) : mode_(mode) {}
+
+        BroadcastRing(const BroadcastRing&) = delete;
+        BroadcastRing& operator=(BroadcastRing&) = delete;
+        BroadcastRing(BroadcastRing&&) = delete;
+        BroadcastRing& operator=(BroadcastRing&&) = delete;
+
+        // A consumer id that starts at the next item published, -1 when
+        // MaxConsumers are already subscribed
+        int subscribe() {
+            for (size_t id = 0; id < MaxConsumers; ++id) {
+                Consumer& consumer = consumers_[id];
+                bool expected = false;
+                if (!consumer.active.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    continue;
+
+                // Until the cursor below lands the producer may gate on a
+                // stale, lower one: it waits a little longer, never overwrites
+                uint64_t position = published_.load(std::memory_order_acquire);
+                consumer.start = position;
+                consumer.maxLag.store(0, std::memory_order_relaxed);
+                consumer.dropped.store(0, std::memory_order_relaxed);
+                consumer.cursor.store(position, std::memory_order_release);
+                return static_cast<int>(id);
+            }
+            return -1;
+        }
+
+        // The consumer stops gating the producer
+        void unsubscribe(int id) {
+            consumers_[id].active.store(false, std::memory_order_release);
+            space_wait_.notify();
+        }
+
+        bool push(const T& item) {
+            T* slot = claim();
+            if (!slot)
+                return false;
+
+            *slot = item;
+            commit();
+            return true;
+        }
+
+        // Next slot to build an item in, nullptr when a Gated ring is full.
+        // Not visible to consumers until commit().
+        T* claim() {
+            uint64_t next = published_.load(std::memory_order_relaxed) + claimed_;
+            Slot& slot = slots_[next & MASK];
+
+            if (mode_ == BroadcastMode::Gated) {
+                // Full Buffer Cond.
+                if (next - cached_min_ >= Size) {
+                    cached_min_ = minCursor(next);
+                    if (next - cached_min_ >= Size)
+                        return nullptr;
+                }
+            } else {
+                slot.sequence.store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            claimed_++;
+            return &slot.data;
+        }
+
+        void commit() {
+            if (claimed_ == 0)
+                return;
+
+            uint64_t first = published_.load(std::memory_order_relaxed);
+            for (uint64_t position = first; position < first + claimed_; ++position) {
+                slots_[position & MASK].sequence.store(position + 1, std::memory_order_release);
+            }
+            published_.store(first + claimed_, std::memory_order_release);
+            claimed_ = 0;
+            published_wait_.notify();
+        }
+
+        // claim(), waiting for the slowest consumer; slots claimed earlier
+        // are committed first. nullptr once running is cleared.
+        T* claim_wait(const std::atomic<bool>& running) {
+            if (T* slot = claim())
+                return slot;
+
+            commit();
+            space_wait_.wait([&] {
+                uint64_t next = published_.load(std::memory_order_relaxed);
+                return next - minCursor(next) < Size || !running.load(std::memory_order_relaxed);
+            });
+            return claim();
+        }
+
+        // consume(), waiting until something is published; 0 once running
+        // is cleared and this consumer has caught up
+        template<typename F>
+        size_t consume_wait(int id, F&& f, const std::atomic<bool>& running) {
+            const Consumer& consumer = consumers_[id];
+            published_wait_.wait([&] {
+                return published_.load(std::memory_order_acquire) != consumer.cursor.load(std::memory_order_relaxed) ||
+                       !running.load(std::memory_order_relaxed);
+            });
+            return consume(id, std::forward<F>(f));
+        }
+
+        // Rouses every waiter to recheck, e.g. after clearing running
+        void wake() {
+            published_wait_.notify();
+            space_wait_.notify();
+        }
+
+        // Calls f(const T&) for up to max items published since this
+        // consumer's last call, then advances its cursor once. Returns
+        // how many items f saw.
+        template<typename F>
+        size_t consume(int id, F&& f, size_t max = std::numeric_limits<size_t>::max()) {
+            Consumer& consumer = consumers_[id];
+            uint64_t position = consumer.cursor.load(std::memory_order_relaxed);
+            uint64_t published = published_.load(std::memory_order_acquire);
+
+            uint64_t lag = published - position;
+            if (lag > consumer.maxLag.load(std::memory_order_relaxed))
+                consumer.maxLag.store(lag, std::memory_order_relaxed);
+
+            size_t count = 0;
+            if (mode_ == BroadcastMode::Gated) {
+                uint64_t end = position + std::min<uint64_t>(lag, max);
+                for (; position < end; ++position, ++count) {
+                    f(static_cast<const T&>(slots_[position & MASK].data));
+                }
+            } else {
+                uint64_t dropped = 0;
+                while (position < published && count < max) {
+                    // Lapped: everything older than one ring back is gone
+                    if (published - position > Size) {
+                        dropped += published - Size - position;
+                        position = published - Size;
+                    }
+
+                    const Slot& slot = slots_[position & MASK];
+                    uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                    T item = slot.data;
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+                    if (before != position + 1 || after != before) {
+                        dropped++;  // overwritten while we looked
+                        position++;
+                        published = published_.load(std::memory_order_acquire);
+                        continue;
+                    }
+
+                    f(static_cast<const T&>(item));
+                    position++;
+                    count++;
+                }
+                if (dropped)
+                    consumer.dropped.fetch_add(dropped, std::memory_order_relaxed);
+            }
+
+            consumer.cursor.store(position, std::memory_order_release);
+            if (mode_ == BroadcastMode::Gated && count > 0)
+                space_wait_.notify();
+            return count;
+        }
+
+        uint64_t lag(int id) const {
+            return published_.load(std::memory_order_acquire) -
+                   consumers_[id].cursor.load(std::memory_order_acquire);
+        }
+
+        BroadcastStats stats(int id) const {
+            const Consumer& consumer = consumers_[id];
+            uint64_t cursor = consumer.cursor.load(std::memory_order_acquire);
+
+            BroadcastStats stats;
+            stats.dropped = consumer.dropped.load(std::memory_order_relaxed);
+            stats.consumed = cursor - consumer.start - stats.dropped;
+            stats.lag = published_.load(std::memory_order_acquire) - cursor;
+            stats.maxLag = consumer.maxLag.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        uint64_t pushCount() const {
+            return published_.load(std::memory_order_relaxed);
+        }
+
+        BroadcastMode mode() const {
+            return mode_;
+        }
+
+        static constexpr size_t capacity() {
+            return Size;
+        }
+};
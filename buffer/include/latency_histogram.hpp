@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+    Fixed-size log-linear histogram of nanosecond latencies: each power of
+    two is split into SUB_BUCKETS equal buckets, so any value is recorded
+    within 1/SUB_BUCKETS (~6%) of itself and recording is a few
+    instructions with no allocation. Values past the last bucket land in
+    it.
+
+    One thread records; any thread may read at any time (counts are
+    relaxed atomics, a read racing a record is off by that record).
+*/
+class LatencyHistogram {
+    public:
+        static constexpr int SUB_BITS = 4;
+        static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BITS;
+        static constexpr int MAX_BITS = 40;  // ~18 minutes
+        static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> max_{0};
+
+        static size_t bucket(uint64_t value) {
+            if (value < SUB_BUCKETS) return value;
+            int bits = std::bit_width(value) - 1;  // value in [2^bits, 2^(bits+1))
+            size_t sub = (value >> (bits - SUB_BITS)) & (SUB_BUCKETS - 1);
+            return std::min(size_t(bits - SUB_BITS + 1) * SUB_BUCKETS + sub, BUCKETS - 1);
+        }
+
+        // Smallest value that lands in index
+        static uint64_t lowest(size_t index) {
+            if (index < SUB_BUCKETS) return index;
+            int bits = int(index / SUB_BUCKETS) + SUB_BITS - 1;
+            return (uint64_t(1) << bits) + (uint64_t(index % SUB_BUCKETS) << (bits - SUB_BITS));
+        }
+
+        // Single writer: plain load + store, no locked read-modify-write
+        static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    public:
+        void record(uint64_t nanos) {
+            add(counts_[bucket(nanos)], 1);
+            add(count_, 1);
+            add(sum_, nanos);
+            if (nanos > max_.load(std::memory_order_relaxed)) max_.store(nanos, std::memory_order_relaxed);
+        }
+
+        uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+        double mean() const {
+            uint64_t n = count();
+            return n ? double(sum_.load(std::memory_order_relaxed)) / n : 0.0;
+        }
+
+        // Lower edge of the bucket holding the q-quantile, q in [0, 1]
+        uint64_t percentile(double q) const {
+            uint64_t n = count();
+            if (n == 0) return 0;
+
+            uint64_t rank = std::max<uint64_t>(1, uint64_t(q * n + 0.5));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += counts_[i].load(std::memory_order_relaxed);
+                if (seen >= rank) return std::min(lowest(i), max());
+            }
+            return max();
+        }
+};
@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "market_update.hpp"
+#include "market_data_generator.hpp"
+#include "symbol_registry.hpp"
+
+/**
+    Recorded feeds for replay: PackedMarketUpdates as they came off the
+    ring, followed by the symbol table their ids refer to, so a capture
+    replays into any registry.
+
+    File layout, host byte order:
+        CaptureHeader     32 bytes, rewritten by close()
+        PackedMarketUpdate x update_count
+        symbol table      per symbol: uint8 name length, name,
+                          uint8 price decimals, uint8 quantity decimals
+*/
+
+struct CaptureHeader {
+    static constexpr uint64_t MAGIC = 0x315254504143444D;  // "MDCAPTR1"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t update_count;
+    uint64_t table_offset;
+};
+static_assert(sizeof(CaptureHeader) == 32, "records start on a 32-byte boundary");
+
+class CaptureWriter {
+    private:
+        std::FILE* file_;
+        std::string path_;
+        const SymbolRegistry& symbols_;
+        uint64_t count_ = 0;
+
+        [[noreturn]] void fail(const char* what) {
+            throw std::runtime_error("capture " + path_ + ": " + what + ": " + std::strerror(errno));
+        }
+
+    public:
+        // Truncates path. symbols must outlive the writer: the table is
+        // taken from it on close(), so symbols interned later are covered.
+        CaptureWriter(const std::string& path, const SymbolRegistry& symbols) :
+            file_(std::fopen(path.c_str(), "wb")), path_(path), symbols_(symbols) {
+            if (!file_) fail("open");
+            std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+            CaptureHeader header{};  // placeholder until close()
+            if (std::fwrite(&header, sizeof(header), 1, file_) != 1) fail("write");
+        }
+
+        CaptureWriter(const CaptureWriter&) = delete;
+        CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+        ~CaptureWriter() {
+            try {
+                close();
+            } catch (const std::exception&) {
+                // Nothing to tell from a destructor; an incomplete capture
+                // fails to load
+            }
+        }
+
+        void write(const PackedMarketUpdate& update) {
+            std::fwrite(&update, sizeof(update), 1, file_);
+            count_++;
+        }
+
+        uint64_t count() const { return count_; }
+
+        void close() {
+            if (!file_) return;
+            std::FILE* file = std::exchange(file_, nullptr);
+
+            CaptureHeader header{CaptureHeader::MAGIC, CaptureHeader::VERSION, sizeof(PackedMarketUpdate), count_,
+                                 sizeof(CaptureHeader) + count_ * sizeof(PackedMarketUpdate)};
+            bool ok = true;
+            for (uint32_t id = 0; id < symbols_.size(); ++id) {
+                const SymbolInfo& info = symbols_.info(id);
+                uint8_t fields[3] = {uint8_t(std::min<size_t>(info.name.size(), UINT8_MAX)),
+                                     uint8_t(info.price_decimals), uint8_t(info.quantity_decimals)};
+                ok &= std::fwrite(&fields[0], 1, 1, file) == 1;
+                ok &= std::fwrite(info.name.data(), 1, fields[0], file) == fields[0];
+                ok &= std::fwrite(&fields[1], 1, 2, file) == 2;
+            }
+            ok &= std::fseek(file, 0, SEEK_SET) == 0;
+            ok &= std::fwrite(&header, sizeof(header), 1, file) == 1;
+            ok &= std::fclose(file) == 0;
+            if (!ok) fail("write");
+        }
+};
+
+// Every update of the capture at path, symbol ids remapped into registry
+// (interning symbols it does not know yet). Throws if the file is not a
+// complete capture.
+inline std::vector<PackedMarketUpdate> loadCapture(const std::string& path, SymbolRegistry& registry) {
+    auto fail = [&](const char* what) -> std::runtime_error {
+        return std::runtime_error("capture " + path + ": " + what);
+    };
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) throw fail(std::strerror(errno));
+    std::vector<char> bytes;
+    char chunk[1 << 16];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) bytes.insert(bytes.end(), chunk, chunk + n);
+    std::fclose(file);
+
+    CaptureHeader header;
+    if (bytes.size() < sizeof(header)) throw fail("truncated");
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != CaptureHeader::MAGIC || header.version != CaptureHeader::VERSION ||
+        header.record_size != sizeof(PackedMarketUpdate) ||
+        header.table_offset != sizeof(header) + header.update_count * sizeof(PackedMarketUpdate) ||
+        header.table_offset > bytes.size()) {
+        throw fail("not a capture, or not closed");
+    }
+
+    std::vector<uint32_t> ids;
+    for (size_t pos = header.table_offset; pos < bytes.size();) {
+        size_t length = uint8_t(bytes[pos]);
+        if (pos + 1 + length + 2 > bytes.size()) throw fail("truncated symbol table");
+        std::string_view name(bytes.data() + pos + 1, length);
+        int price_decimals = uint8_t(bytes[pos + 1 + length]);
+        int quantity_decimals = uint8_t(bytes[pos + 2 + length]);
+        ids.push_back(registry.intern(name, price_decimals, quantity_decimals));
+        pos += 3 + length;
+    }
+
+    std::vector<PackedMarketUpdate> updates(header.update_count);
+    std::memcpy(updates.data(), bytes.data() + sizeof(header), header.update_count * sizeof(PackedMarketUpdate));
+    for (PackedMarketUpdate& update : updates) {
+        if (update.symbol_id >= ids.size()) throw fail("update for a symbol not in the table");
+        update.symbol_id = ids[update.symbol_id];
+    }
+    return updates;
+}
+
+// Publishes updates into ring (RingBuffer or BroadcastRing) with their
+// original spacing divided by speed, timestamps rebased to the wall clock
+// at the start, until done or running is cleared; speed 0 replays as fast
+// as the consumer takes them. Returns how many were published.
+template<typename Ring>
+uint64_t replayCapture(const std::vector<PackedMarketUpdate>& updates, Ring& ring,
+                       const std::atomic<bool>& running, double speed = 1.0) {
+    static constexpr size_t BATCH_SIZE = 64;
+    if (updates.empty()) return 0;
+
+    const uint64_t first = updates.front().timestamp;
+    const uint64_t start = wallClockNanos();
+    uint64_t wall = start;
+    uint64_t published = 0;
+
+    for (const PackedMarketUpdate& update : updates) {
+        if (!running.load(std::memory_order_relaxed)) break;
+
+        uint64_t timestamp;
+        if (speed > 0) {
+            uint64_t offset = update.timestamp > first ? update.timestamp - first : 0;
+            timestamp = start + uint64_t(offset / speed);
+            if (timestamp > wall) {
+                // Publish what is ready before waiting; commit covers every
+                // claimed slot, so this one is claimed after
+                ring.commit();
+                wall = waitForWallClock(timestamp, running);
+                if (wall < timestamp) break;
+            }
+        } else {
+            if (published % BATCH_SIZE == 0) wall = wallClockNanos();
+            timestamp = wall;
+        }
+
+        PackedMarketUpdate* slot = ring.claim_wait(running);
+        if (!slot) break;
+        *slot = update;
+        slot->timestamp = timestamp;
+
+        if (++published % BATCH_SIZE == 0) ring.commit();
+    }
+    ring.commit();
+    return published;
+}
@@ -1,36 +1,84 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <sys/socket.h>
+#include "broadcast_ring.hpp"
+#include "market_data_generator.hpp"
+#include "market_update.hpp"
 #include "ring_buffer.hpp"
+#include "symbol_registry.hpp"
+#include "wait_strategy.hpp"
 
-struct MarketUpdate {
-    uint64_t timestamp;
-    double price;
-    double quantity;
-    char symbol[16];
-    char side; // 'B' for bid, 'A' for ask
-
-    MarketUpdate() = default;
-    MarketUpdate(uint64_t ts, double p, double q, std::string& sym, char s) :
-        timestamp(ts), price(p), quantity(q), side(s) {
-        strncpy(symbol, sym.c_str(), sizeof(symbol) - 1);
-        symbol[sizeof(symbol) - 1] = '\0';
-    }
+// How feed threads wait on each other; pick per deployment (see
+// wait_strategy.hpp), e.g. BusySpinWait on an isolated core for the lowest
+// latency, SpinParkWait to idle at no CPU cost
+#ifndef MARKET_DATA_WAIT_STRATEGY
+#define MARKET_DATA_WAIT_STRATEGY SpinParkWait
+#endif
+
+// A capture (see market_capture.hpp) to feed instead of a live source
+struct ReplayConfig {
+    std::string path;
+    double speed = 1.0;  // 2 replays twice as fast, 0 as fast as consumers go
 };
 
 class MarketDataProcessor {
     public:
+        // Synthetic updates from a MarketDataGenerator
         MarketDataProcessor();
+        explicit MarketDataProcessor(GeneratorConfig config);
+        // Streams from a Binance WebSocket URL (e.g. wss://stream.binance.com:9443/stream?streams=btcusdt@depth@100ms)
+        explicit MarketDataProcessor(std::string stream_url);
+        // Replays a capture, once; throws if it cannot be loaded
+        explicit MarketDataProcessor(const ReplayConfig& replay);
+        ~MarketDataProcessor();
         void start();
         void stop();
 
+        using UpdateHandler = std::function<void(const PackedMarketUpdate&)>;
+
+        // Adds an independent reader of the feed (book builder, statistics,
+        // recorder, ...) on its own thread and cursor, pinned to cpu unless
+        // it is -1; updates are handed to it in place, never copied. Call
+        // before start(). Without any, start() adds one that prints every
+        // update.
+        int addConsumer(UpdateHandler handler, int cpu = -1);
+        BroadcastStats consumerStats(int consumer) const;
+
+        // Names and scales behind PackedMarketUpdate::symbol_id
+        const SymbolRegistry& symbols() const { return symbols_; }
+
     private:
         static constexpr size_t BUFFER_SIZE = 1024;
-        RingBuffer<MarketUpdate, BUFFER_SIZE> market_data_buffer_;
+        static constexpr size_t MAX_CONSUMERS = 8;
+        BroadcastRing<PackedMarketUpdate, BUFFER_SIZE, MAX_CONSUMERS, MARKET_DATA_WAIT_STRATEGY> market_data_buffer_;
+        SymbolRegistry symbols_;
+        uint32_t sequence_ = 0;  // producer thread only
 
-        bool running_{false};
+        GeneratorConfig generator_config_;
+        std::string stream_url_;
+        std::vector<PackedMarketUpdate> replay_;
+        double replay_speed_ = 0;
+        std::atomic<bool> running_{false};
+        std::thread producer_;
+        struct Consumer {
+            int id;
+            UpdateHandler handler;
+            int cpu;
+        };
+        std::vector<Consumer> handlers_;
+        std::vector<std::thread> consumers_;
+        bool printing_ = false;  // default consumer logs to the console
         void producerThread();
-        void consumerThread();
+        void streamThread();
+        void replayThread();
+        void consumerThread(int consumer, UpdateHandler handler, int cpu);
         void fetchData();
 };
@@ -0,0 +1,283 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "market_update.hpp"
+#include "symbol_registry.hpp"
+
+/**
+    Synthetic order-book feed for load tests and benchmarks, straight into
+    PackedMarketUpdates.
+
+    Every symbol keeps a best bid on a tick grid with the ask spread_ticks
+    above it; the mid takes a random one-tick step with move_probability
+    per update of that symbol, and the move is published as the two top
+    quotes, the side moving away first, so the book never crosses. Other
+    updates are trades at the touch or depth levels up to `levels` ticks
+    behind it, some of them deletions (quantity 0). Symbols share the flow
+    by weight.
+
+    Arrivals are Poisson at `rate` per second, or, with burst_factor > 1,
+    alternate between calm and burst periods (burst_factor times the
+    calm rate, burst_fraction of the time, bursts burst_length ns long on
+    average) at the same mean rate. Timestamps are event times on a clock
+    that starts at the wall time (again at each run(), if it is behind);
+    run() publishes each update when the wall clock reaches it. rate 0
+    generates as fast as the consumer takes updates, stamped with the wall
+    clock. The same seed gives the same updates.
+*/
+
+inline uint64_t wallClockNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Sleeps, then spins the last stretch, until the wall clock reaches due
+// (ns since epoch) or running is cleared. Returns the wall clock.
+inline uint64_t waitForWallClock(uint64_t due, const std::atomic<bool>& running) {
+    static constexpr uint64_t SPIN_NANOS = 50'000;
+
+    uint64_t wall;
+    while ((wall = wallClockNanos()) < due && running.load(std::memory_order_relaxed)) {
+        if (due - wall > SPIN_NANOS) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(due - wall - SPIN_NANOS));
+        }
+    }
+    return wall;
+}
+
+struct GeneratedSymbol {
+    std::string name;
+    double mid;                 // starting mid
+    double tick;                // price increment
+    int price_decimals = 2;
+    int quantity_decimals = 5;
+    double weight = 1.0;        // share of the update flow
+};
+
+struct GeneratorConfig {
+    std::vector<GeneratedSymbol> symbols = {
+        {"BTCUSDC", 67000.0, 0.01, 2, 5, 4.0},
+        {"ETHUSDC", 3500.0, 0.01, 2, 4, 2.0},
+        {"SOLUSDC", 150.0, 0.001, 3, 2, 1.0},
+    };
+
+    double rate = 1'000'000;    // mean updates per second, 0 for unpaced
+    double burst_factor = 1.0;  // burst rate / calm rate, 1 for plain Poisson
+    double burst_fraction = 0.1;
+    uint64_t burst_length = 1'000'000;  // ns
+
+    double move_probability = 0.05;
+    double trade_probability = 0.1;
+    double delete_probability = 0.1;
+    int levels = 10;
+    int spread_ticks = 1;
+    double max_quantity = 5.0;
+
+    uint64_t seed = 1;
+};
+
+class MarketDataGenerator {
+    private:
+        static constexpr size_t BATCH_SIZE = 64;       // updates per commit when unpaced
+        static constexpr size_t NONE = SIZE_MAX;
+
+        struct Book {
+            uint32_t id;
+            int64_t tick;          // fixed-point price units per tick
+            int64_t bid;           // best bid, in ticks
+            int64_t max_quantity;  // fixed-point quantity units
+            int pending;           // second top quote of a move still to publish: 0, +1 up, -1 down
+        };
+
+        GeneratorConfig config_;
+        std::vector<Book> books_;
+        std::vector<uint64_t> thresholds_;  // cumulative weights scaled to 2^64
+        size_t pending_ = NONE;  // book whose move is half published
+
+        uint64_t state_[4];      // xoshiro256**
+        uint64_t clock_;         // event time of the last update, ns
+        double calm_rate_;       // per ns
+        double burst_rate_;
+        bool bursting_ = false;
+        uint64_t switch_at_;     // event time of the next calm/burst switch
+        uint32_t sequence_ = 0;
+
+        static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        uint64_t random() {
+            uint64_t result = rotl(state_[1] * 5, 7) * 9;
+            uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+
+        double uniform() { return (random() >> 11) * 0x1.0p-53; }  // [0, 1)
+
+        double exponential(double rate) { return -std::log1p(-uniform()) / rate; }
+
+        void advanceClock() {
+            clock_ += std::max<uint64_t>(1, uint64_t(exponential(bursting_ ? burst_rate_ : calm_rate_)));
+            if (config_.burst_factor > 1 && clock_ >= switch_at_) {
+                bursting_ = !bursting_;
+                double mean = bursting_ ? double(config_.burst_length)
+                                        : config_.burst_length * (1 - config_.burst_fraction) / config_.burst_fraction;
+                switch_at_ = clock_ + uint64_t(exponential(1.0 / mean));
+            }
+        }
+
+        Book& pickBook() {
+            uint64_t r = random();
+            for (size_t i = 0; i + 1 < books_.size(); ++i) {
+                if (r < thresholds_[i]) return books_[i];
+            }
+            return books_.back();
+        }
+
+        int64_t quantity(const Book& book) {
+            return 1 + int64_t(random() % uint64_t(book.max_quantity));
+        }
+
+        void quote(PackedMarketUpdate& out, const Book& book, Side side, int64_t ticks, int64_t size) {
+            out.price = ticks * book.tick;
+            out.quantity = size;
+            out.symbol_id = book.id;
+            out.side = side;
+        }
+
+    public:
+        MarketDataGenerator(const GeneratorConfig& config, SymbolRegistry& registry) :
+            config_(config), clock_(wallClockNanos()) {
+            uint64_t seed = config.seed;
+            for (uint64_t& word : state_) {  // splitmix64
+                uint64_t z = (seed += 0x9E3779B97F4A7C15);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+                word = z ^ (z >> 31);
+            }
+
+            double total = 0;
+            for (const GeneratedSymbol& symbol : config.symbols) total += symbol.weight;
+
+            double cumulative = 0;
+            for (const GeneratedSymbol& symbol : config.symbols) {
+                uint32_t id = registry.intern(symbol.name, symbol.price_decimals, symbol.quantity_decimals);
+                const SymbolInfo& info = registry.info(id);
+
+                int64_t tick = std::max<int64_t>(1, std::llround(symbol.tick * info.price_scale));
+                int64_t bid = std::llround(symbol.mid * info.price_scale) / tick - config.spread_ticks / 2;
+                int64_t maxQuantity = std::max<int64_t>(1, std::llround(config.max_quantity * info.quantity_scale));
+                books_.push_back({id, tick, std::max<int64_t>(config.levels + 1, bid), maxQuantity, 0});
+
+                cumulative += symbol.weight / total;
+                thresholds_.push_back(cumulative >= 1.0 ? UINT64_MAX : uint64_t(cumulative * 0x1.0p64));
+            }
+            if (books_.empty()) throw std::invalid_argument("generator needs at least one symbol");
+
+            // Calm rate such that the time-weighted mean is config.rate
+            double f = config.burst_factor > 1 ? config.burst_fraction : 0.0;
+            double rate = config.rate > 0 ? config.rate : 1e9;
+            calm_rate_ = rate / ((1 - f) + f * config.burst_factor) / 1e9;
+            burst_rate_ = calm_rate_ * config.burst_factor;
+            switch_at_ = clock_ + uint64_t(exponential(1.0 / std::max(1.0, config.burst_length * (1 - f) / std::max(f, 1e-9))));
+        }
+
+        // Builds the next update in out, stamped with its event time
+        void next(PackedMarketUpdate& out) {
+            if (config_.rate > 0) advanceClock();
+            out.timestamp = clock_;
+            out.sequence = sequence_++;
+
+            // Second half of a mid move
+            if (pending_ != NONE) {
+                Book& book = books_[pending_];
+                pending_ = NONE;
+                if (book.pending > 0) quote(out, book, Side::Bid, book.bid, quantity(book));
+                else quote(out, book, Side::Ask, book.bid + config_.spread_ticks, quantity(book));
+                book.pending = 0;
+                return;
+            }
+
+            Book& book = pickBook();
+            double u = uniform();
+
+            if (u < config_.move_probability) {
+                // Up: new ask first, then the bid follows; down: the reverse.
+                // Never down into the depth levels' floor.
+                book.pending = (random() & 1) || book.bid <= config_.levels + 1 ? 1 : -1;
+                book.bid += book.pending;
+                pending_ = &book - books_.data();
+                if (book.pending > 0) quote(out, book, Side::Ask, book.bid + config_.spread_ticks, quantity(book));
+                else quote(out, book, Side::Bid, book.bid, quantity(book));
+                return;
+            }
+            u -= config_.move_probability;
+
+            if (u < config_.trade_probability) {
+                bool buy = random() & 1;
+                quote(out, book, Side::Trade, buy ? book.bid + config_.spread_ticks : book.bid, quantity(book));
+                return;
+            }
+
+            // A depth level behind the touch
+            bool bid = random() & 1;
+            int64_t level = config_.levels > 0 ? 1 + int64_t(random() % uint64_t(config_.levels)) : 0;
+            int64_t size = uniform() < config_.delete_probability ? 0 : quantity(book);
+            if (bid) quote(out, book, Side::Bid, book.bid - level, size);
+            else quote(out, book, Side::Ask, book.bid + config_.spread_ticks + level, size);
+        }
+
+        // Publishes up to limit updates into ring (RingBuffer or
+        // BroadcastRing) at their event times until running is cleared.
+        // Returns how many were published.
+        template<typename Ring>
+        uint64_t run(Ring& ring, const std::atomic<bool>& running, uint64_t limit = UINT64_MAX) {
+            const bool paced = config_.rate > 0;
+            uint64_t wall = wallClockNanos();
+            clock_ = std::max(clock_, wall);  // no backlog from before the call
+            uint64_t published = 0;
+            size_t batch = 0;
+
+            PackedMarketUpdate update;
+            while (published < limit && running.load(std::memory_order_relaxed)) {
+                next(update);
+
+                if (!paced) {
+                    if (batch == 0) wall = wallClockNanos();
+                    update.timestamp = wall;
+                } else if (update.timestamp > wall) {
+                    // Due in the future: publish what is ready, then wait for
+                    // it (commit covers every claimed slot, so claim after)
+                    ring.commit();
+                    batch = 0;
+                    wall = waitForWallClock(update.timestamp, running);
+                    if (wall < update.timestamp) break;
+                }
+
+                PackedMarketUpdate* slot = ring.claim_wait(running);
+                if (!slot) break;
+                *slot = update;
+
+                published++;
+                if (++batch == BATCH_SIZE) {
+                    ring.commit();
+                    batch = 0;
+                }
+            }
+            ring.commit();
+            return published;
+        }
+
+        uint32_t sequence() const { return sequence_; }
+};
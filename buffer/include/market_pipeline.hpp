@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "latency_histogram.hpp"
+#include "market_data.hpp"
+#include "market_stats.hpp"
+#include "ring_buffer.hpp"
+#include "symbol_registry.hpp"
+#include "update_validator.hpp"
+
+/**
+    Processing behind a MarketDataProcessor, one thread per stage, stages
+    joined by SPSC RingBuffers:
+
+        feed --> decode --> validate --> stats
+                 (a feed consumer)
+
+    decode    fixed point back to units (DecodedUpdate)
+    validate  UpdateValidator; rejected updates stop here
+    stats     per-symbol SymbolStats
+
+    Every stage can be pinned to a core and keeps a LatencyHistogram of
+    the time from an update becoming available to the stage until the
+    stage passes it on (queueing plus work). Decode measures from the
+    feed timestamp, so its histogram is the feed's latency too.
+*/
+
+struct PipelineConfig {
+    // Core per stage, -1 to leave the thread to the scheduler
+    int decode_cpu = -1;
+    int validate_cpu = -1;
+    int stats_cpu = -1;
+
+    uint64_t max_age = 5'000'000'000;  // ns before an update is stale
+    double ewma_alpha = 0.05;
+};
+
+enum class PipelineStage { Decode, Validate, Stats };
+
+class MarketPipeline {
+    public:
+        explicit MarketPipeline(const SymbolRegistry& symbols, PipelineConfig config = {});
+        ~MarketPipeline();
+
+        MarketPipeline(const MarketPipeline&) = delete;
+        MarketPipeline& operator=(const MarketPipeline&) = delete;
+
+        // Runs the decode stage as a consumer of processor's feed. Call
+        // before processor.start(); stop the processor before the pipeline.
+        void attach(MarketDataProcessor& processor);
+
+        void start();
+        // Lets every update already decoded through, then joins
+        void stop();
+
+        // The decode stage, for feeds other than a MarketDataProcessor. One
+        // thread at a time.
+        void decode(const PackedMarketUpdate& packed);
+
+        const LatencyHistogram& latency(PipelineStage stage) const;
+        ValidationStats validation() const { return validator_.stats(); }
+        uint64_t processed() const { return processed_.load(std::memory_order_relaxed); }
+
+        // By symbol id, empty for ids never seen. Owned by the stats stage:
+        // read once stop() has returned.
+        const std::vector<SymbolStats>& stats() const { return stats_; }
+
+    private:
+        static constexpr size_t STAGE_BUFFER_SIZE = 4096;
+        static constexpr size_t BATCH_SIZE = 64;  // items per release/commit
+
+        struct Item {
+            DecodedUpdate update;
+            uint64_t stamp;  // ns since epoch when handed to the next stage
+        };
+        using StageRing = RingBuffer<Item, STAGE_BUFFER_SIZE, MARKET_DATA_WAIT_STRATEGY>;
+
+        const SymbolRegistry& symbols_;
+        PipelineConfig config_;
+
+        std::unique_ptr<StageRing> decoded_;
+        std::unique_ptr<StageRing> validated_;
+        std::atomic<bool> decoding_{false};
+        std::atomic<bool> validating_{false};
+
+        // Decode stage (feed consumer thread)
+        const SymbolInfo* info_ = nullptr;
+        uint32_t info_id_ = 0;
+
+        UpdateValidator validator_;
+        std::vector<SymbolStats> stats_;
+        std::atomic<uint64_t> processed_{0};
+        std::array<LatencyHistogram, 3> latency_;
+
+        std::thread validator_thread_;
+        std::thread stats_thread_;
+        void validateThread();
+        void statsThread();
+};
@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+    Per-symbol statistics, O(1) per update in fixed-size windows:
+
+    vwap        over the last TRADE_WINDOW trades
+    trade rate  trades per second across the same trades
+    ewma mid    exponentially weighted mid of the last bid and ask
+    volatility  standard deviation of the log returns of the mid over
+                its last RETURN_WINDOW changes
+
+    Windows keep running sums next to a ring of their values; an update
+    adds the newest and subtracts the evicted value. The sums are rebuilt
+    from the ring once per lap so floating-point drift cannot accumulate,
+    which keeps the cost O(1) amortized.
+*/
+
+template<size_t N>
+class RollingWindow {
+    private:
+        std::array<double, N> values_{};
+        size_t next_ = 0;
+        size_t count_ = 0;
+        double sum_ = 0;
+        double sum_squares_ = 0;
+
+    public:
+        void push(double value) {
+            if (count_ == N) {
+                double evicted = values_[next_];
+                sum_ -= evicted;
+                sum_squares_ -= evicted * evicted;
+            } else {
+                count_++;
+            }
+
+            values_[next_] = value;
+            sum_ += value;
+            sum_squares_ += value * value;
+
+            if (++next_ == N) {
+                next_ = 0;
+                sum_ = sum_squares_ = 0;
+                for (size_t i = 0; i < count_; ++i) {
+                    sum_ += values_[i];
+                    sum_squares_ += values_[i] * values_[i];
+                }
+            }
+        }
+
+        size_t count() const { return count_; }
+        bool full() const { return count_ == N; }
+        double sum() const { return sum_; }
+
+        double mean() const { return count_ ? sum_ / count_ : 0.0; }
+
+        // Sample standard deviation
+        double stddev() const {
+            if (count_ < 2) return 0.0;
+            double variance = (sum_squares_ - sum_ * sum_ / count_) / (count_ - 1);
+            return variance > 0 ? std::sqrt(variance) : 0.0;
+        }
+};
+
+class SymbolStats {
+    public:
+        static constexpr size_t TRADE_WINDOW = 128;
+        static constexpr size_t RETURN_WINDOW = 128;
+
+    private:
+        RollingWindow<TRADE_WINDOW> notional_;   // price * quantity per trade
+        RollingWindow<TRADE_WINDOW> volume_;     // quantity per trade
+        RollingWindow<RETURN_WINDOW> returns_;   // log returns of the mid
+        std::array<uint64_t, TRADE_WINDOW> trade_times_{};  // ns, ring
+
+        double alpha_;
+        double bid_ = 0;
+        double ask_ = 0;
+        double mid_ = 0;
+        double ewma_mid_ = 0;
+        uint64_t updates_ = 0;
+        uint64_t trades_ = 0;
+
+        void onMid() {
+            if (bid_ <= 0 || ask_ <= 0) return;
+
+            double mid = (bid_ + ask_) / 2;
+            if (mid_ > 0 && mid != mid_) returns_.push(std::log(mid / mid_));
+            ewma_mid_ = mid_ > 0 ? alpha_ * mid + (1 - alpha_) * ewma_mid_ : mid;
+            mid_ = mid;
+        }
+
+    public:
+        // alpha: weight of the newest mid in the EWMA
+        explicit SymbolStats(double alpha = 0.05) : alpha_(alpha) {}
+
+        void onBid(double price) {
+            updates_++;
+            bid_ = price;
+            onMid();
+        }
+
+        void onAsk(double price) {
+            updates_++;
+            ask_ = price;
+            onMid();
+        }
+
+        void onTrade(double price, double quantity, uint64_t timestamp) {
+            updates_++;
+            notional_.push(price * quantity);
+            volume_.push(quantity);
+            trade_times_[trades_ % TRADE_WINDOW] = timestamp;
+            trades_++;
+        }
+
+        double vwap() const { return volume_.sum() > 0 ? notional_.sum() / volume_.sum() : 0.0; }
+        double mid() const { return mid_; }
+        double ewmaMid() const { return ewma_mid_; }
+        double volatility() const { return returns_.stddev(); }
+
+        // Trades per second over the trade window; 0 until two trades
+        double tradeRate() const {
+            size_t count = std::min<uint64_t>(trades_, TRADE_WINDOW);
+            if (count < 2) return 0.0;
+
+            uint64_t newest = trade_times_[(trades_ - 1) % TRADE_WINDOW];
+            uint64_t oldest = trade_times_[(trades_ - count) % TRADE_WINDOW];
+            return newest > oldest ? (count - 1) * 1e9 / double(newest - oldest) : 0.0;
+        }
+
+        uint64_t updates() const { return updates_; }
+        uint64_t trades() const { return trades_; }
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "symbol_registry.hpp"
+
+enum class Side : uint8_t {
+    Bid = 'B',
+    Ask = 'A',
+    Trade = 'T',  // a print: price and size traded
+};
+
+struct MarketUpdate {
+    uint64_t timestamp;
+    double price;
+    double quantity;
+    char symbol[16];
+    char side; // 'B' for bid, 'A' for ask, 'T' for a trade
+
+    MarketUpdate() = default;
+    MarketUpdate(uint64_t ts, double p, double q, std::string_view sym, char s) :
+        timestamp(ts), price(p), quantity(q), side(s) {
+        size_t len = std::min(sym.size(), sizeof(symbol) - 1);
+        std::memcpy(symbol, sym.data(), len);
+        symbol[len] = '\0';
+    }
+};
+
+/**
+    The feed's wire format inside the process: two updates per cache line.
+    Prices and quantities are fixed point in the instrument's scales from
+    the SymbolRegistry, the symbol is its registry id, and sequence
+    numbers every update a producer publishes.
+*/
+struct alignas(32) PackedMarketUpdate {
+    uint64_t timestamp;   // ns since epoch
+    int64_t price;        // price * SymbolInfo::price_scale
+    int64_t quantity;     // quantity * SymbolInfo::quantity_scale
+    uint32_t sequence;
+    uint32_t symbol_id : 24;
+    Side side : 8;
+};
+static_assert(sizeof(PackedMarketUpdate) == 32, "two PackedMarketUpdates per cache line");
+
+inline PackedMarketUpdate pack(const MarketUpdate& update, uint32_t symbol_id, const SymbolInfo& info,
+                               uint32_t sequence) {
+    PackedMarketUpdate packed;
+    packed.timestamp = update.timestamp;
+    packed.price = std::llround(update.price * info.price_scale);
+    packed.quantity = std::llround(update.quantity * info.quantity_scale);
+    packed.sequence = sequence;
+    packed.symbol_id = symbol_id;
+    packed.side = static_cast<Side>(update.side);
+    return packed;
+}
+
+// Registers the symbol on first sight
+inline PackedMarketUpdate pack(const MarketUpdate& update, SymbolRegistry& registry, uint32_t sequence) {
+    uint32_t id = registry.intern(update.symbol);
+    return pack(update, id, registry.info(id), sequence);
+}
+
+inline MarketUpdate unpack(const PackedMarketUpdate& packed, const SymbolRegistry& registry) {
+    const SymbolInfo& info = registry.info(packed.symbol_id);
+    return MarketUpdate(packed.timestamp, packed.price / info.price_scale, packed.quantity / info.quantity_scale,
+                        info.name, static_cast<char>(packed.side));
+}
+
+// A PackedMarketUpdate with price and quantity back in units, as the
+// processing pipeline's stages see it
+struct DecodedUpdate {
+    uint64_t timestamp;
+    double price;
+    double quantity;
+    uint32_t sequence;
+    uint32_t symbol_id;
+    Side side;
+};
+
+inline DecodedUpdate decode(const PackedMarketUpdate& packed, const SymbolInfo& info) {
+    return DecodedUpdate{packed.timestamp, packed.price / info.price_scale, packed.quantity / info.quantity_scale,
+                         packed.sequence, packed.symbol_id, packed.side};
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+    Bounded multi-producer queues with a sequence number per slot
+    (Vyukov). Same push/pop surface as RingBuffer.
+
+    Slot i starts with sequence i. A producer that wins position pos (CAS
+    on tail_) writes the item and sets the slot's sequence to pos + 1; a
+    consumer at pos waits for that, reads, and sets it to pos + Size so the
+    slot is free for the producer one lap later. Producers only contend on
+    tail_, consumers on head_, and neither ever waits for a slower peer
+    that has not started writing.
+
+    MpscQueue is the same queue with a single consumer, which advances
+    head_ with a plain store instead of a CAS. Unlike RingBuffer all Size
+    slots are usable.
+*/
+template<typename T, size_t Size, bool MultiConsumer>
+class SequencedQueue {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "queue size must be a power of two");
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+        static constexpr uint64_t MASK = Size - 1;
+
+        struct Cell {
+            std::atomic<uint64_t> sequence;
+            T data;
+        };
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+        alignas(CACHE_LINE_SIZE) std::array<Cell, Size> cells_;
+
+    public:
+        SequencedQueue() {
+            for (size_t i = 0; i < Size; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        SequencedQueue(const SequencedQueue&) = delete;
+        SequencedQueue& operator=(SequencedQueue&) = delete;
+        SequencedQueue(SequencedQueue&&) = delete;
+        SequencedQueue& operator=(SequencedQueue&&) = delete;
+
+        bool push(const T& item) {
+            uint64_t pos = tail_.load(std::memory_order_relaxed);
+            Cell* cell;
+
+            for (;;) {
+                cell = &cells_[pos & MASK];
+                uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+                int64_t diff = static_cast<int64_t>(sequence - pos);
+
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (diff < 0) {
+                    return false;  // a lap behind: full
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = item;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(T& item) {
+            uint64_t pos = head_.load(std::memory_order_relaxed);
+            Cell* cell;
+
+            for (;;) {
+                cell = &cells_[pos & MASK];
+                uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+                int64_t diff = static_cast<int64_t>(sequence - (pos + 1));
+
+                if (diff < 0)
+                    return false;  // not written yet: empty
+
+                if constexpr (MultiConsumer) {
+                    if (diff == 0) {
+                        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    } else {
+                        pos = head_.load(std::memory_order_relaxed);
+                    }
+                } else {
+                    head_.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+
+            item = cell->data;
+            cell->sequence.store(pos + Size, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate while producers or consumers are active
+        size_t size() const {
+            uint64_t head = head_.load(std::memory_order_acquire);
+            uint64_t tail = tail_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        static constexpr size_t capacity() {
+            return Size;
+        }
+};
+
+template<typename T, size_t Size>
+using MpmcQueue = SequencedQueue<T, Size, true>;
+
+template<typename T, size_t Size>
+using MpscQueue = SequencedQueue<T, Size, false>;
@@ -0,0 +1,268 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "market_update.hpp"
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+/**
+    Binary order-book messages: ADD, MODIFY, DELETE and TRADE, each a
+    fixed-size struct behind a common 24-byte header. Fields are naturally
+    aligned and every struct is a multiple of 8 bytes with no padding
+    holes, so a message is its own wire image: encode and decode are a
+    memcpy into and out of the caller's buffer, plus byte swaps on
+    big-endian hosts. The wire is little-endian.
+
+    Header, by offset:
+        0   crc        uint32  CRC32C of bytes 4..length
+        4   length     uint16  whole message, header included
+        6   type       uint8   MessageType
+        7   side       uint8   Side of the order, aggressor of a trade
+        8   sequence   uint32  per feed, gaps mean lost messages
+        12  symbol_id  uint32  SymbolRegistry id
+        16  timestamp  uint64  ns since epoch
+
+    Decoding validates the type, the length the type implies and the
+    checksum with arithmetic on a size table rather than a branch per
+    type, and reports the first problem found; a message is only handed
+    out whole and intact.
+*/
+
+enum class MessageType : uint8_t {
+    Add = 1,
+    Modify = 2,
+    Delete = 3,
+    Trade = 4,
+};
+
+struct MessageHeader {
+    uint32_t crc;
+    uint16_t length;
+    MessageType type;
+    Side side;
+    uint32_t sequence;
+    uint32_t symbol_id;
+    uint64_t timestamp;
+};
+
+struct AddMessage {
+    static constexpr MessageType TYPE = MessageType::Add;
+    MessageHeader header;
+    uint64_t order_id;
+    int64_t price;        // price * SymbolInfo::price_scale
+    int64_t quantity;     // quantity * SymbolInfo::quantity_scale
+};
+
+// New price and remaining quantity of a resting order
+struct ModifyMessage {
+    static constexpr MessageType TYPE = MessageType::Modify;
+    MessageHeader header;
+    uint64_t order_id;
+    int64_t price;
+    int64_t quantity;
+};
+
+struct DeleteMessage {
+    static constexpr MessageType TYPE = MessageType::Delete;
+    MessageHeader header;
+    uint64_t order_id;
+};
+
+// A print against the resting order_id
+struct TradeMessage {
+    static constexpr MessageType TYPE = MessageType::Trade;
+    MessageHeader header;
+    uint64_t order_id;
+    int64_t price;
+    int64_t quantity;
+};
+
+static_assert(sizeof(MessageHeader) == 24 && std::has_unique_object_representations_v<MessageHeader>);
+static_assert(sizeof(AddMessage) == 48 && std::has_unique_object_representations_v<AddMessage>);
+static_assert(sizeof(ModifyMessage) == 48 && std::has_unique_object_representations_v<ModifyMessage>);
+static_assert(sizeof(DeleteMessage) == 32 && std::has_unique_object_representations_v<DeleteMessage>);
+static_assert(sizeof(TradeMessage) == 48 && std::has_unique_object_representations_v<TradeMessage>);
+
+// Any one message, as decode() hands it out; header.type says which
+union AnyMessage {
+    MessageHeader header;
+    AddMessage add;
+    ModifyMessage modify;
+    DeleteMessage remove;
+    TradeMessage trade;
+};
+
+static constexpr size_t MAX_MESSAGE_SIZE = sizeof(AnyMessage);
+
+// Bytes of each message by type byte, 0 for unknown types
+inline constexpr std::array<uint16_t, 256> MESSAGE_SIZES = [] {
+    std::array<uint16_t, 256> sizes{};
+    sizes[size_t(MessageType::Add)] = sizeof(AddMessage);
+    sizes[size_t(MessageType::Modify)] = sizeof(ModifyMessage);
+    sizes[size_t(MessageType::Delete)] = sizeof(DeleteMessage);
+    sizes[size_t(MessageType::Trade)] = sizeof(TradeMessage);
+    return sizes;
+}();
+
+enum class DecodeError : uint8_t {
+    None,
+    Truncated,      // fewer bytes than the header or its length
+    UnknownType,
+    BadLength,      // length is not the size of the type
+    BadChecksum,
+};
+
+/**
+    CRC32C (Castagnoli), the polynomial of the SSE4.2 crc32 instruction.
+    Builds targeting SSE4.2 call the instruction directly; other x86
+    builds pick it at runtime from cpuid, everything else uses the table.
+    crc chains calls: crc32c(b, n, crc32c(a, m)) is the CRC of a then b.
+*/
+namespace crc32c_detail {
+    inline constexpr std::array<uint32_t, 256> TABLE = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0x82F63B78 & -(crc & 1));
+            table[i] = crc;
+        }
+        return table;
+    }();
+}
+
+inline uint32_t crc32cTable(const void* data, size_t size, uint32_t crc = 0) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = (crc >> 8) ^ crc32c_detail::TABLE[(crc ^ bytes[i]) & 0xFF];
+    return ~crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+inline uint32_t crc32cHardware(const void* data, size_t size, uint32_t crc = 0) {
+    const char* bytes = static_cast<const char*>(data);
+    uint64_t c = ~crc;
+    for (; size >= 8; bytes += 8, size -= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        c = _mm_crc32_u64(c, word);
+    }
+    uint32_t c32 = uint32_t(c);
+    for (; size > 0; ++bytes, --size) c32 = _mm_crc32_u8(c32, uint8_t(*bytes));
+    return ~c32;
+}
+
+inline bool hasHardwareCrc32c() {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#endif
+
+inline uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0) {
+#if defined(__x86_64__) && defined(__SSE4_2__)
+    return crc32cHardware(data, size, crc);
+#elif defined(__x86_64__)
+    return hasHardwareCrc32c() ? crc32cHardware(data, size, crc) : crc32cTable(data, size, crc);
+#else
+    return crc32cTable(data, size, crc);
+#endif
+}
+
+namespace protocol_detail {
+    template<typename T>
+    constexpr T swapped(T value) {
+        if constexpr (sizeof(T) == 2) return T(__builtin_bswap16(uint16_t(value)));
+        else if constexpr (sizeof(T) == 4) return T(__builtin_bswap32(uint32_t(value)));
+        else if constexpr (sizeof(T) == 8) return T(__builtin_bswap64(uint64_t(value)));
+        else return value;
+    }
+
+    // Converts between host and wire order in place; nothing to do on
+    // little-endian hosts
+    inline void swapHeader(MessageHeader& header) {
+        header.crc = swapped(header.crc);
+        header.length = swapped(header.length);
+        header.sequence = swapped(header.sequence);
+        header.symbol_id = swapped(header.symbol_id);
+        header.timestamp = swapped(header.timestamp);
+    }
+
+    template<typename Message>
+    void swapBody(Message& message) {
+        message.order_id = swapped(message.order_id);
+        if constexpr (requires { message.price; }) {
+            message.price = swapped(message.price);
+            message.quantity = swapped(message.quantity);
+        }
+    }
+
+    inline void toHostOrder(AnyMessage& message) {
+        switch (message.header.type) {
+            case MessageType::Add: swapBody(message.add); break;
+            case MessageType::Modify: swapBody(message.modify); break;
+            case MessageType::Delete: swapBody(message.remove); break;
+            case MessageType::Trade: swapBody(message.trade); break;
+        }
+    }
+}
+
+// Writes message into out (at least sizeof(Message) bytes), filling in
+// its type, length and crc. Returns the bytes written.
+template<typename Message>
+size_t encode(const Message& message, char* out) {
+    Message wire = message;
+    wire.header.type = Message::TYPE;
+    wire.header.length = sizeof(Message);
+    if constexpr (std::endian::native == std::endian::big) {
+        protocol_detail::swapHeader(wire.header);
+        protocol_detail::swapBody(wire);
+    }
+    std::memcpy(out, &wire, sizeof(Message));
+
+    uint32_t crc = crc32c(out + sizeof(uint32_t), sizeof(Message) - sizeof(uint32_t));
+    if constexpr (std::endian::native == std::endian::big) crc = protocol_detail::swapped(crc);
+    std::memcpy(out, &crc, sizeof(crc));
+    return sizeof(Message);
+}
+
+// The length of the message at the front of data, once its header is in;
+// 0 before that. For framing: data holds a whole message when size
+// reaches it.
+inline size_t peekLength(const char* data, size_t size) {
+    if (size < sizeof(MessageHeader)) return 0;
+    uint16_t length;
+    std::memcpy(&length, data + offsetof(MessageHeader, length), sizeof(length));
+    if constexpr (std::endian::native == std::endian::big) length = protocol_detail::swapped(length);
+    return length;
+}
+
+// Decodes the message at the front of data into out. On success
+// out.header.length is the bytes it took up; on error out is unspecified.
+inline DecodeError decode(const char* data, size_t size, AnyMessage& out) {
+    if (size < sizeof(MessageHeader)) return DecodeError::Truncated;
+    std::memcpy(&out.header, data, sizeof(MessageHeader));
+    if constexpr (std::endian::native == std::endian::big) protocol_detail::swapHeader(out.header);
+
+    // Every check from one table lookup, selected rather than branched
+    // on, so the only branch is the one taken for a bad message
+    size_t expected = MESSAGE_SIZES[uint8_t(out.header.type)];
+    size_t length = out.header.length;
+    DecodeError error = expected == 0      ? DecodeError::UnknownType
+                        : length != expected ? DecodeError::BadLength
+                        : size < length      ? DecodeError::Truncated
+                                             : DecodeError::None;
+    if (error != DecodeError::None) return error;
+
+    if (crc32c(data + sizeof(uint32_t), length - sizeof(uint32_t)) != out.header.crc) return DecodeError::BadChecksum;
+    std::memcpy(&out, data, length);
+    if constexpr (std::endian::native == std::endian::big) {
+        protocol_detail::swapHeader(out.header);
+        protocol_detail::toHostOrder(out);
+    }
+    return DecodeError::None;
+}
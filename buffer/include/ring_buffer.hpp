@@ -1,20 +1,53 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include "wait_strategy.hpp"
 
-template<typename T, size_t Size>
+/**
+    Single-producer single-consumer ring.
+
+    head_ and tail_ only ever grow; a slot is index & MASK, so Size must be
+    a power of two. Each side keeps a plain copy of the other side's index
+    and reloads the atomic only when that copy says the ring is full (push)
+    or empty (pop), so the steady state touches no shared cache line but
+    the slot itself. Holds Size - 1 items at most.
+
+    Besides push/pop, items can move in batches (push_bulk/pop_bulk) or be
+    built and read in place: claim() hands out free slots and commit()
+    publishes every slot claimed so far with one store; peek()/release()
+    do the same on the consumer side. push and push_bulk also publish
+    outstanding claims, pop and pop_bulk also free outstanding peeks.
+
+    The *_wait forms block per the Wait strategy (see wait_strategy.hpp)
+    until they succeed or running is cleared; whoever clears running
+    calls wake() so sleeping waiters notice.
+*/
+template<typename T, size_t Size, typename Wait = BusySpinWait>
 class RingBuffer {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "RingBuffer size must be a power of two");
+
     private:
         static constexpr size_t CACHE_LINE_SIZE = 64;
         static constexpr size_t BUFFER_SIZE = Size;
+        static constexpr uint64_t MASK = Size - 1;
+        static constexpr uint64_t CAPACITY = Size - 1;
 
+        // Consumer side
         alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0};
+        alignas(CACHE_LINE_SIZE) uint64_t cached_tail_ = 0;
+        uint64_t peeked_ = 0;
+
+        // Producer side
         alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail_{0};
+        alignas(CACHE_LINE_SIZE) uint64_t cached_head_ = 0;
+        uint64_t claimed_ = 0;
 
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> push_count_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> pop_count_{0};
+        alignas(CACHE_LINE_SIZE) Wait not_empty_;  // consumer waits, producer notifies
+        alignas(CACHE_LINE_SIZE) Wait not_full_;   // producer waits, consumer notifies
 
         alignas(CACHE_LINE_SIZE) std::array<T, BUFFER_SIZE> buffer_;
 
@@ -28,41 +61,197 @@ class RingBuffer {
 
 
         bool push(const T& item) {
-            uint64_t current_tail = tail_.load(std::memory_order_relaxed);
-            uint64_t next_tail = (current_tail + 1) % BUFFER_SIZE;
-
-            // Full Buffer Cond.
-            if (next_tail == head_.load(std::memory_order_acquire))
+            T* slot = claim();
+            if (!slot)
                 return false;
 
-            buffer_[current_tail] = item;
-            tail_.store(next_tail, std::memory_order_release);
-            push_count_.fetch_add(1, std::memory_order_relaxed);
+            *slot = item;
+            commit();
             return true;
         }
 
         bool pop(T& item) {
-            uint64_t current_head = head_.load(std::memory_order_relaxed);
+            const T* slot = peek();
+            if (!slot)
+                return false;
+
+            item = *slot;
+            release();
+            return true;
+        }
+
+        // Pushes as many of items as fit, returns how many
+        size_t push_bulk(std::span<const T> items) {
+            uint64_t next = tail_.load(std::memory_order_relaxed) + claimed_;
+            size_t count = std::min<uint64_t>(items.size(), writable(next, items.size()));
+            if (count == 0)
+                return 0;
+
+            copyIn(next, items.first(count));
+            claimed_ = 0;
+            tail_.store(next + count, std::memory_order_release);
+            not_empty_.notify();
+            return count;
+        }
+
+        // Pops up to out.size() items, returns how many
+        size_t pop_bulk(std::span<T> out) {
+            uint64_t next = head_.load(std::memory_order_relaxed) + peeked_;
+            size_t count = std::min<uint64_t>(out.size(), readable(next, out.size()));
+            if (count == 0)
+                return 0;
+
+            copyOut(next, out.first(count));
+            peeked_ = 0;
+            head_.store(next + count, std::memory_order_release);
+            not_full_.notify();
+            return count;
+        }
+
+        // Next free slot to build an item in, nullptr when full. Not
+        // visible to the consumer until commit().
+        T* claim() {
+            uint64_t next = tail_.load(std::memory_order_relaxed) + claimed_;
+
+            // Full Buffer Cond.
+            if (writable(next) == 0)
+                return nullptr;
+
+            claimed_++;
+            return &buffer_[next & MASK];
+        }
+
+        void commit() {
+            if (claimed_ == 0)
+                return;
+
+            tail_.store(tail_.load(std::memory_order_relaxed) + claimed_, std::memory_order_release);
+            claimed_ = 0;
+            not_empty_.notify();
+        }
+
+        // Next item to read in place, nullptr when empty. The slot stays
+        // the consumer's until release().
+        const T* peek() {
+            uint64_t next = head_.load(std::memory_order_relaxed) + peeked_;
 
             // Buffer empty Cond.
-            if (current_head == tail_.load(std::memory_order_acquire))
+            if (readable(next) == 0)
+                return nullptr;
+
+            peeked_++;
+            return &buffer_[next & MASK];
+        }
+
+        void release() {
+            if (peeked_ == 0)
+                return;
+
+            head_.store(head_.load(std::memory_order_relaxed) + peeked_, std::memory_order_release);
+            peeked_ = 0;
+            not_full_.notify();
+        }
+
+        bool push_wait(const T& item, const std::atomic<bool>& running) {
+            T* slot = claim_wait(running);
+            if (!slot)
+                return false;
+
+            *slot = item;
+            commit();
+            return true;
+        }
+
+        bool pop_wait(T& item, const std::atomic<bool>& running) {
+            const T* slot = peek_wait(running);
+            if (!slot)
                 return false;
 
-            item = buffer_[current_head];
-            head_.store((current_head + 1) % BUFFER_SIZE, std::memory_order_release);
-            pop_count_.fetch_add(1, std::memory_order_relaxed);
+            item = *slot;
+            release();
             return true;
         }
 
+        // claim(), waiting for space; slots claimed earlier are committed
+        // first so the consumer can make it. nullptr once running is cleared.
+        T* claim_wait(const std::atomic<bool>& running) {
+            if (T* slot = claim())
+                return slot;
+
+            commit();
+            not_full_.wait([&] {
+                return writable(tail_.load(std::memory_order_relaxed)) > 0 ||
+                       !running.load(std::memory_order_relaxed);
+            });
+            return claim();
+        }
+
+        // peek(), waiting for data; slots peeked earlier are released first.
+        // nullptr once running is cleared and nothing is left.
+        const T* peek_wait(const std::atomic<bool>& running) {
+            if (const T* slot = peek())
+                return slot;
+
+            release();
+            not_empty_.wait([&] {
+                return readable(head_.load(std::memory_order_relaxed)) > 0 ||
+                       !running.load(std::memory_order_relaxed);
+            });
+            return peek();
+        }
+
+        // Rouses every waiter to recheck, e.g. after clearing running
+        void wake() {
+            not_empty_.notify();
+            not_full_.notify();
+        }
+
         uint64_t pushCount() const {
-            return push_count_.load(std::memory_order_relaxed);
+            return tail_.load(std::memory_order_relaxed);
+        }
+
+        uint64_t popCount() const {
+            return head_.load(std::memory_order_relaxed);
         }
 
         size_t size() const {
-            uint64_t head = head_.load(std::memory_order_relaxed);
-            uint64_t tail = tail_.load(std::memory_order_relaxed);
+            // head first: tail read after it can only be further ahead
+            uint64_t head = head_.load(std::memory_order_acquire);
+            uint64_t tail = tail_.load(std::memory_order_acquire);
+
+            return tail - head;
+        }
+
+        static constexpr size_t capacity() {
+            return CAPACITY;
+        }
+
+    private:
+        // Free slots from index next on, reloading head_ only when the
+        // cached copy shows fewer than wanted
+        uint64_t writable(uint64_t next, uint64_t wanted = 1) {
+            if (CAPACITY - (next - cached_head_) < wanted)
+                cached_head_ = head_.load(std::memory_order_acquire);
+            return CAPACITY - (next - cached_head_);
+        }
+
+        uint64_t readable(uint64_t next, uint64_t wanted = 1) {
+            if (cached_tail_ - next < wanted)
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+            return cached_tail_ - next;
+        }
+
+        // At most two contiguous runs: up to the end of the array, then from 0
+        void copyIn(uint64_t next, std::span<const T> items) {
+            size_t first = std::min(items.size(), BUFFER_SIZE - (next & MASK));
+            std::copy_n(items.begin(), first, buffer_.begin() + (next & MASK));
+            std::copy(items.begin() + first, items.end(), buffer_.begin());
+        }
 
-            return tail >= head ? tail - head : BUFFER_SIZE - (head - tail);
+        void copyOut(uint64_t next, std::span<T> out) {
+            size_t first = std::min(out.size(), BUFFER_SIZE - (next & MASK));
+            std::copy_n(buffer_.begin() + (next & MASK), first, out.begin());
+            std::copy_n(buffer_.begin(), out.size() - first, out.begin() + first);
         }
 
 
@@ -0,0 +1,253 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+    SPSC ring in a POSIX shared-memory segment, so a feed handler and its
+    consumers can run as separate processes with the same zero-copy
+    claim/commit and peek/release handoff as RingBuffer.
+
+    Segment layout: a versioned header (magic, version, slot size and
+    count, checked on attach), head and tail on their own cache lines,
+    then Size slots of T. T must be trivially copyable; nothing in it may
+    point into either process.
+
+    Only head and tail are shared. Cached indices and outstanding
+    claims/peeks live in the handle, so a process that dies mid-write
+    leaves nothing half-published: its replacement attaches, resumes at
+    the shared index and the slots it had claimed are simply reused.
+*/
+
+struct ShmRingHeader {
+    static constexpr uint64_t MAGIC = 0x474E4952444D4853;  // "SHMDRING"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t slot_size;
+    uint64_t slot_count;
+    std::atomic<uint32_t> ready;  // set last by create(), attach() refuses until then
+
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+template<typename T, size_t Size>
+class ShmRingBuffer {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "ShmRingBuffer size must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "ShmRingBuffer items are shared between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared indices must be address-free");
+
+    private:
+        static constexpr uint64_t MASK = Size - 1;
+        static constexpr uint64_t CAPACITY = Size - 1;
+        static constexpr size_t SLOTS_OFFSET = (sizeof(ShmRingHeader) + 63) & ~size_t(63);
+        static constexpr size_t SEGMENT_SIZE = SLOTS_OFFSET + Size * sizeof(T);
+
+        ShmRingHeader* header_ = nullptr;
+        T* slots_ = nullptr;
+
+        // Process-local, rebuilt from the shared indices on attach
+        uint64_t cached_head_ = 0;
+        uint64_t cached_tail_ = 0;
+        uint64_t claimed_ = 0;
+        uint64_t peeked_ = 0;
+
+        explicit ShmRingBuffer(void* segment) :
+            header_(static_cast<ShmRingHeader*>(segment)),
+            slots_(reinterpret_cast<T*>(static_cast<char*>(segment) + SLOTS_OFFSET)) {
+            cached_head_ = header_->head.load(std::memory_order_acquire);
+            cached_tail_ = header_->tail.load(std::memory_order_acquire);
+        }
+
+        [[noreturn]] static void fail(const std::string& what, const std::string& name) {
+            throw std::runtime_error("shm ring " + name + ": " + what + ": " + std::strerror(errno));
+        }
+
+        static void* map(int fd, const std::string& name) {
+            void* segment = mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (segment == MAP_FAILED) fail("mmap", name);
+            return segment;
+        }
+
+    public:
+        // A fresh, empty ring; an existing segment of the same name is
+        // replaced (processes still mapping it keep the old one)
+        static ShmRingBuffer create(const std::string& name) {
+            shm_unlink(name.c_str());
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) fail("shm_open", name);
+            if (ftruncate(fd, SEGMENT_SIZE) != 0) {
+                ::close(fd);
+                fail("ftruncate", name);
+            }
+
+            void* segment = map(fd, name);
+            auto* header = new (segment) ShmRingHeader{};
+            header->magic = ShmRingHeader::MAGIC;
+            header->version = ShmRingHeader::VERSION;
+            header->header_size = sizeof(ShmRingHeader);
+            header->slot_size = sizeof(T);
+            header->slot_count = Size;
+            header->head.store(0, std::memory_order_relaxed);
+            header->tail.store(0, std::memory_order_relaxed);
+            header->ready.store(1, std::memory_order_release);
+
+            return ShmRingBuffer(segment);
+        }
+
+        // Maps a ring made by create(), possibly in another process. Throws
+        // if it does not exist yet or was made for another T or Size.
+        static ShmRingBuffer attach(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) fail("shm_open", name);
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < SEGMENT_SIZE) {
+                ::close(fd);
+                errno = EINVAL;
+                fail("segment too small or still being created", name);
+            }
+
+            void* segment = map(fd, name);
+            auto* header = static_cast<ShmRingHeader*>(segment);
+            if (header->ready.load(std::memory_order_acquire) != 1 ||
+                header->magic != ShmRingHeader::MAGIC ||
+                header->version != ShmRingHeader::VERSION ||
+                header->header_size != sizeof(ShmRingHeader) ||
+                header->slot_size != sizeof(T) ||
+                header->slot_count != Size) {
+                munmap(segment, SEGMENT_SIZE);
+                errno = EPROTO;
+                fail("layout mismatch", name);
+            }
+
+            return ShmRingBuffer(segment);
+        }
+
+        // Removes the name; mappings stay valid until their handles go
+        static void remove(const std::string& name) {
+            shm_unlink(name.c_str());
+        }
+
+        ShmRingBuffer(ShmRingBuffer&& other) noexcept { *this = std::move(other); }
+
+        ShmRingBuffer& operator=(ShmRingBuffer&& other) noexcept {
+            if (this != &other) {
+                if (header_) munmap(header_, SEGMENT_SIZE);
+                header_ = std::exchange(other.header_, nullptr);
+                slots_ = std::exchange(other.slots_, nullptr);
+                cached_head_ = other.cached_head_;
+                cached_tail_ = other.cached_tail_;
+                claimed_ = other.claimed_;
+                peeked_ = other.peeked_;
+            }
+            return *this;
+        }
+
+        ShmRingBuffer(const ShmRingBuffer&) = delete;
+        ShmRingBuffer& operator=(const ShmRingBuffer&) = delete;
+
+        ~ShmRingBuffer() {
+            if (header_) munmap(header_, SEGMENT_SIZE);
+        }
+
+        bool push(const T& item) {
+            T* slot = claim();
+            if (!slot)
+                return false;
+
+            *slot = item;
+            commit();
+            return true;
+        }
+
+        bool pop(T& item) {
+            const T* slot = peek();
+            if (!slot)
+                return false;
+
+            item = *slot;
+            release();
+            return true;
+        }
+
+        // Next free slot to build an item in, nullptr when full
+        T* claim() {
+            uint64_t next = header_->tail.load(std::memory_order_relaxed) + claimed_;
+
+            // Full Buffer Cond.
+            if (next - cached_head_ == CAPACITY) {
+                cached_head_ = header_->head.load(std::memory_order_acquire);
+                if (next - cached_head_ == CAPACITY)
+                    return nullptr;
+            }
+
+            claimed_++;
+            return &slots_[next & MASK];
+        }
+
+        void commit() {
+            if (claimed_ == 0)
+                return;
+
+            header_->tail.store(header_->tail.load(std::memory_order_relaxed) + claimed_, std::memory_order_release);
+            claimed_ = 0;
+        }
+
+        // Next item to read in place, nullptr when empty
+        const T* peek() {
+            uint64_t next = header_->head.load(std::memory_order_relaxed) + peeked_;
+
+            // Buffer empty Cond.
+            if (next == cached_tail_) {
+                cached_tail_ = header_->tail.load(std::memory_order_acquire);
+                if (next == cached_tail_)
+                    return nullptr;
+            }
+
+            peeked_++;
+            return &slots_[next & MASK];
+        }
+
+        void release() {
+            if (peeked_ == 0)
+                return;
+
+            header_->head.store(header_->head.load(std::memory_order_relaxed) + peeked_, std::memory_order_release);
+            peeked_ = 0;
+        }
+
+        uint64_t pushCount() const {
+            return header_->tail.load(std::memory_order_relaxed);
+        }
+
+        uint64_t popCount() const {
+            return header_->head.load(std::memory_order_relaxed);
+        }
+
+        size_t size() const {
+            uint64_t head = header_->head.load(std::memory_order_acquire);
+            uint64_t tail = header_->tail.load(std::memory_order_acquire);
+
+            return tail - head;
+        }
+
+        static constexpr size_t capacity() {
+            return CAPACITY;
+        }
+};
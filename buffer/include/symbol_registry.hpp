@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct SymbolInfo {
+    std::string name;
+    int price_decimals;
+    int quantity_decimals;
+    double price_scale;     // 10^price_decimals: fixed-point units per 1.0
+    double quantity_scale;  // 10^quantity_decimals
+};
+
+/**
+    Interns instrument names to dense uint32_t ids, so updates can carry
+    an id instead of a string, and records each instrument's fixed-point
+    scales. Ids are never reused or removed. Thread-safe; intern() is
+    meant for setup and the first sight of a symbol, lookups for the hot
+    path.
+*/
+class SymbolRegistry {
+    public:
+        static constexpr int DEFAULT_DECIMALS = 8;  // Binance quotes carry 8 decimals
+        static constexpr uint32_t MAX_SYMBOLS = 1u << 24;  // width of PackedMarketUpdate::symbol_id
+
+        // Id of name, registering it with these scales if new (an existing
+        // symbol keeps the scales it was registered with)
+        uint32_t intern(std::string_view name, int price_decimals = DEFAULT_DECIMALS,
+                        int quantity_decimals = DEFAULT_DECIMALS);
+
+        std::optional<uint32_t> find(std::string_view name) const;
+        // Entries never move or change, so the reference stays valid
+        const SymbolInfo& info(uint32_t id) const;
+        size_t size() const;
+
+    private:
+        // Lookups by string_view without building a std::string
+        struct NameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        mutable std::shared_mutex mutex_;
+        std::deque<SymbolInfo> symbols_;
+        std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> ids_;
+};
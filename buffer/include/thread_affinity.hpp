@@ -0,0 +1,16 @@
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+
+// Pins the calling thread to one CPU so a pipeline stage keeps its caches
+// and never migrates. cpu < 0 leaves the thread where the scheduler puts
+// it. Returns false if the CPU does not exist or is not allowed.
+inline bool pinCurrentThread(int cpu) {
+    if (cpu < 0) return true;
+    if (cpu >= CPU_SETSIZE) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "market_update.hpp"
+
+/**
+    Checks one feed's decoded updates in arrival order:
+
+    Duplicate    sequence number at or behind the last one seen
+    BadValue     price not a positive finite number, or quantity negative
+                 or not finite (a zero depth quantity is a deletion, fine)
+    Stale        feed timestamp older than max_age at the time of the check
+
+    A sequence gap is counted (gaps, missed updates) but does not reject
+    the update: it is itself fine, the feed lost the ones before it.
+    A crossing, a bid at or above the symbol's last ask or an ask at or
+    below its last bid, is counted the same way. Only the last price of
+    each side is kept, which may be gone already (a bid lifting through
+    an ask the feed never deleted), so the update stands and the other
+    side is forgotten until its next update. Deletions are not checked.
+    Single-threaded; counters are relaxed atomics so others can read them.
+*/
+
+enum class Rejection : uint8_t {
+    None,
+    Duplicate,
+    BadValue,
+    Stale,
+};
+
+struct ValidationStats {
+    uint64_t checked = 0;
+    uint64_t bad_value = 0;
+    uint64_t stale = 0;
+    uint64_t crossed = 0;
+    uint64_t duplicate = 0;
+    uint64_t gaps = 0;
+    uint64_t missed = 0;  // updates lost across all gaps
+
+    uint64_t rejected() const { return bad_value + stale + duplicate; }
+};
+
+class UpdateValidator {
+    private:
+        struct TopOfBook {
+            double bid = 0;
+            double ask = 0;
+        };
+
+        uint64_t max_age_;
+        std::vector<TopOfBook> books_;  // by symbol id
+        uint32_t next_sequence_ = 0;
+        bool started_ = false;
+
+        std::atomic<uint64_t> checked_{0};
+        std::atomic<uint64_t> bad_value_{0};
+        std::atomic<uint64_t> stale_{0};
+        std::atomic<uint64_t> crossed_{0};
+        std::atomic<uint64_t> duplicate_{0};
+        std::atomic<uint64_t> gaps_{0};
+        std::atomic<uint64_t> missed_{0};
+
+        static void add(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        Rejection reject(std::atomic<uint64_t>& counter, Rejection reason) {
+            add(counter);
+            return reason;
+        }
+
+    public:
+        // max_age: ns a feed timestamp may trail the clock by
+        explicit UpdateValidator(uint64_t max_age) : max_age_(max_age) {}
+
+        // now: ns since epoch, on the feed's clock
+        Rejection check(const DecodedUpdate& update, uint64_t now) {
+            add(checked_);
+
+            // Signed distance, so the uint32 sequence may wrap. Every update
+            // past the last one consumes its number, accepted or not.
+            int32_t ahead = static_cast<int32_t>(update.sequence - next_sequence_);
+            if (started_ && ahead < 0) {
+                return reject(duplicate_, Rejection::Duplicate);
+            }
+            if (started_ && ahead > 0) {
+                add(gaps_);
+                add(missed_, uint32_t(ahead));
+            }
+            next_sequence_ = update.sequence + 1;
+            started_ = true;
+
+            if (!(update.price > 0) || !std::isfinite(update.price) ||
+                !(update.quantity >= 0) || !std::isfinite(update.quantity)) {
+                return reject(bad_value_, Rejection::BadValue);
+            }
+
+            if (now > update.timestamp && now - update.timestamp > max_age_) {
+                return reject(stale_, Rejection::Stale);
+            }
+
+            if (update.side == Side::Trade) return Rejection::None;
+
+            if (update.symbol_id >= books_.size()) books_.resize(update.symbol_id + 1);
+            TopOfBook& book = books_[update.symbol_id];
+            double& own = update.side == Side::Bid ? book.bid : book.ask;
+            double& other = update.side == Side::Bid ? book.ask : book.bid;
+
+            if (update.quantity == 0) {
+                if (update.price == own) own = 0;  // top level deleted, unknown until the next one
+                return Rejection::None;
+            }
+
+            bool crossed = update.side == Side::Bid ? other > 0 && update.price >= other
+                                                    : other > 0 && update.price <= other;
+            if (crossed) {
+                add(crossed_);
+                other = 0;
+            }
+
+            own = update.price;
+            return Rejection::None;
+        }
+
+        ValidationStats stats() const {
+            ValidationStats stats;
+            stats.checked = checked_.load(std::memory_order_relaxed);
+            stats.bad_value = bad_value_.load(std::memory_order_relaxed);
+            stats.stale = stale_.load(std::memory_order_relaxed);
+            stats.crossed = crossed_.load(std::memory_order_relaxed);
+            stats.duplicate = duplicate_.load(std::memory_order_relaxed);
+            stats.gaps = gaps_.load(std::memory_order_relaxed);
+            stats.missed = missed_.load(std::memory_order_relaxed);
+            return stats;
+        }
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+    How a ring's blocking calls (pop_wait, push_wait, ...) wait for the
+    other side, from lowest latency to lowest CPU:
+
+    BusySpinWait       pause loop; a core per waiter, wakes in nanoseconds
+    SpinYieldWait      pause loop, then sched_yield; leaves the core to
+                       other runnable threads but never sleeps
+    SpinParkWait       pause loop, then sleeps on a futex until the other
+                       side publishes; costs nothing idle, a few us to wake
+    TimedBlockingWait  no spinning, sleeps on a condition variable and
+                       rechecks at least every TIMEOUT
+
+    A strategy is one object shared by the waiting and the notifying side:
+    wait(ready) returns once ready() is true, notify() is called by the
+    other side after every publish. notify() is free for the strategies
+    that never sleep; the sleeping ones pay a full fence per publish to
+    check for sleepers, and a syscall only when there are any.
+*/
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+struct BusySpinWait {
+    template<typename Ready>
+    void wait(Ready&& ready) {
+        while (!ready()) cpuRelax();
+    }
+
+    void notify() {}
+};
+
+struct SpinYieldWait {
+    static constexpr int SPINS = 1000;
+
+    template<typename Ready>
+    void wait(Ready&& ready) {
+        for (int i = 0; i < SPINS; ++i) {
+            if (ready()) return;
+            cpuRelax();
+        }
+        while (!ready()) std::this_thread::yield();
+    }
+
+    void notify() {}
+};
+
+class SpinParkWait {
+    private:
+        static constexpr int SPINS = 2000;
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain uint32_t");
+
+        std::atomic<uint32_t> epoch_{0};  // futex word, bumped by every wakeup
+        std::atomic<uint32_t> sleepers_{0};
+
+        uint32_t* word() { return reinterpret_cast<uint32_t*>(&epoch_); }
+
+    public:
+        template<typename Ready>
+        void wait(Ready&& ready) {
+            for (int i = 0; i < SPINS; ++i) {
+                if (ready()) return;
+                cpuRelax();
+            }
+
+            while (!ready()) {
+                uint32_t epoch = epoch_.load(std::memory_order_acquire);
+                sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // Recheck after registering: either notify() sees us or we see
+                // its publish. A wakeup in between changes epoch_ and the
+                // futex returns at once.
+                if (!ready()) {
+                    syscall(SYS_futex, word(), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+                }
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+
+            epoch_.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, word(), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        }
+};
+
+class TimedBlockingWait {
+    private:
+        static constexpr std::chrono::microseconds TIMEOUT{500};
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::atomic<uint32_t> sleepers_{0};
+
+    public:
+        template<typename Ready>
+        void wait(Ready&& ready) {
+            while (!ready()) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (!ready()) cv_.wait_for(lock, TIMEOUT);
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_relaxed) == 0) return;
+
+            { std::lock_guard<std::mutex> lock(mutex_); }
+            cv_.notify_all();
+        }
+};
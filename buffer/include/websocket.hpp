@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/types.h>
+
+class TCPStream;
+typedef struct ssl_st SSL;
+typedef struct ssl_ctx_st SSL_CTX;
+
+/**
+    RFC 6455 client over the tcp/ socket layer, with TLS (OpenSSL) for wss://.
+
+    Frames are parsed in place out of one receive buffer: an unfragmented
+    message is handed to the handler as a view into that buffer, only
+    fragmented messages are copied. Pings are answered from the read path,
+    client frames are masked as the RFC requires, and run() reconnects
+    with exponential backoff, replaying subscriptions on every new
+    connection.
+
+    ws:// writes never raise SIGPIPE. OpenSSL writes wss:// with plain
+    write(), so a process using wss:// must ignore SIGPIPE, or a peer that
+    resets the connection kills it instead of failing the write.
+*/
+class WebSocketClient {
+    public:
+        // A complete text or binary message and when (ns since epoch) the
+        // read that completed it returned. The view is only valid during
+        // the call.
+        using MessageHandler = std::function<void(std::string_view message, uint64_t arrival)>;
+
+        explicit WebSocketClient(const std::string& url);
+        ~WebSocketClient();
+
+        WebSocketClient(const WebSocketClient&) = delete;
+        WebSocketClient& operator=(const WebSocketClient&) = delete;
+
+        // TCP connect, TLS for wss://, then the upgrade handshake
+        bool connect();
+        void close();
+        bool isConnected() const { return stream_ != nullptr; }
+
+        bool sendText(std::string_view text);
+
+        // Sent on every (re)connect, e.g. a SUBSCRIBE request
+        void addSubscription(std::string message);
+
+        // One read (at most readTimeoutMs) and every message it completed.
+        // Returns false once the connection is gone.
+        bool poll(const MessageHandler& onMessage);
+
+        // connect() + poll() until running is cleared, reconnecting on any
+        // error or when the server has been silent for idleTimeoutMs
+        void run(const MessageHandler& onMessage, const std::atomic<bool>& running);
+
+        uint64_t reconnects() const { return reconnects_; }
+        uint64_t pingsAnswered() const { return pings_; }
+
+        int readTimeoutMs = 200;
+        int idleTimeoutMs = 60000;
+        int maxBackoffMs = 5000;
+
+    private:
+        static constexpr size_t READ_CHUNK = 64 * 1024;
+        static constexpr uint64_t MAX_MESSAGE = 16 * 1024 * 1024;
+        static constexpr int HANDSHAKE_TIMEOUT_MS = 5000;
+
+        std::string host_;
+        std::string path_;
+        int port_ = 80;
+        bool tls_ = false;
+
+        TCPStream* stream_ = nullptr;
+        SSL_CTX* sslCtx_ = nullptr;
+        SSL* ssl_ = nullptr;
+
+        std::vector<char> rx_;
+        size_t rxStart_ = 0;
+        size_t rxEnd_ = 0;
+        bool unparsed_ = false;  // rx_ holds bytes that arrived with the handshake
+
+        std::string fragments_;  // payload of a fragmented message so far
+        bool inFragment_ = false;
+
+        std::vector<char> tx_;
+        std::vector<std::string> subscriptions_;
+
+        uint64_t reconnects_ = 0;
+        uint64_t pings_ = 0;
+        uint64_t lastReceive_ = 0;
+
+        bool handshake();
+        ssize_t readSome(char* buffer, size_t len);
+        bool writeAll(const char* buffer, size_t len);
+        bool sendFrame(uint8_t opcode, const char* payload, size_t len);
+
+        // Parses every complete frame in rx_. false on close or protocol error.
+        bool drainFrames(const MessageHandler& onMessage, uint64_t arrival);
+};
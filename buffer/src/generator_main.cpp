@@ -0,0 +1,129 @@
+#include "latency_histogram.hpp"
+#include "market_capture.hpp"
+#include "market_data_generator.hpp"
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+    Offline load source: generates a synthetic feed (or replays a capture)
+    through an SPSC ring to a consumer thread, optionally recording what
+    it receives, and reports the rate achieved and how late updates
+    arrived relative to their timestamps.
+
+        market_data_generator [--rate N] [--burst FACTOR] [--symbols N]
+                              [--seconds S] [--seed N] [--record FILE]
+        market_data_generator --replay FILE [--speed X] [--record FILE]
+
+    --rate 0 and --speed 0 run unpaced, as fast as the consumer goes.
+*/
+
+static constexpr size_t RING_SIZE = 65536;
+using Ring = RingBuffer<PackedMarketUpdate, RING_SIZE, SpinYieldWait>;
+
+static void usage() {
+    std::fprintf(stderr,
+                 "usage: market_data_generator [--rate N] [--burst FACTOR] [--symbols N] [--seconds S]\n"
+                 "                             [--seed N] [--record FILE]\n"
+                 "       market_data_generator --replay FILE [--speed X] [--record FILE]\n");
+    std::exit(2);
+}
+
+// More symbols than the default three: synthetic pairs around decreasing mids
+static std::vector<GeneratedSymbol> makeSymbols(int count) {
+    std::vector<GeneratedSymbol> symbols = GeneratorConfig{}.symbols;
+    for (int i = symbols.size(); i < count; ++i) {
+        symbols.push_back({"SYM" + std::to_string(i) + "USDC", 1000.0 / (i + 1), 0.001, 3, 2, 1.0});
+    }
+    symbols.resize(count);
+    return symbols;
+}
+
+int main(int argc, char** argv) {
+    GeneratorConfig config;
+    double seconds = 5;
+    std::string record, replay;
+    double speed = 1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) usage();
+        const char* value = argv[++i];
+
+        if (arg == "--rate") config.rate = std::atof(value);
+        else if (arg == "--burst") config.burst_factor = std::atof(value);
+        else if (arg == "--symbols") config.symbols = makeSymbols(std::max(1, std::atoi(value)));
+        else if (arg == "--seconds") seconds = std::atof(value);
+        else if (arg == "--seed") config.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--record") record = value;
+        else if (arg == "--replay") replay = value;
+        else if (arg == "--speed") speed = std::atof(value);
+        else usage();
+    }
+
+    SymbolRegistry symbols;
+    std::vector<PackedMarketUpdate> captured;
+    std::optional<MarketDataGenerator> generator;
+    if (!replay.empty()) {
+        captured = loadCapture(replay, symbols);
+    } else {
+        generator.emplace(config, symbols);
+    }
+
+    auto ring = std::make_unique<Ring>();
+    std::atomic<bool> producing{true};
+    std::atomic<bool> consuming{true};
+
+    std::optional<CaptureWriter> writer;
+    if (!record.empty()) writer.emplace(record, symbols);
+
+    LatencyHistogram lateness;
+    uint64_t received = 0;
+    std::thread consumer([&] {
+        PackedMarketUpdate update;
+        while (ring->pop_wait(update, consuming)) {
+            lateness.record(wallClockNanos() - std::min(update.timestamp, wallClockNanos()));
+            if (writer) writer->write(update);
+            received++;
+        }
+    });
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread stopper([&] {
+        auto deadline = begin + std::chrono::duration<double>(seconds);
+        while (producing && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        producing = false;
+        ring->wake();
+    });
+
+    uint64_t published = generator ? generator->run(*ring, producing)
+                                   : replayCapture(captured, *ring, producing, speed);
+    producing = false;
+    stopper.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    consuming = false;
+    ring->wake();
+    consumer.join();
+    if (writer) writer->close();
+
+    std::printf("%llu updates in %.2f s: %.2f M updates/s", (unsigned long long)published, elapsed,
+                published / elapsed / 1e6);
+    if (generator && config.rate > 0) std::printf(" (target %.2f M/s)", config.rate / 1e6);
+    std::printf("\n%zu symbols, %llu received", symbols.size(), (unsigned long long)received);
+    if (writer) std::printf(", recorded to %s", record.c_str());
+    std::printf("\nlate vs timestamp: p50 %llu ns  p99 %llu ns  p99.9 %llu ns  max %llu ns\n",
+                (unsigned long long)lateness.percentile(0.5), (unsigned long long)lateness.percentile(0.99),
+                (unsigned long long)lateness.percentile(0.999), (unsigned long long)lateness.max());
+    return 0;
+}
@@ -1,12 +1,51 @@
 #include "market_data.hpp"
+#include "market_pipeline.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include <iostream>
 #include <thread>
 #include <chrono>
 
-int main() {
-    MarketDataProcessor processor;
+static void printLatency(const char* stage, const LatencyHistogram& h) {
+    std::printf("  %-9s %10llu updates  p50 %8llu ns  p99 %8llu ns  p99.9 %8llu ns  max %10llu ns\n", stage,
+                (unsigned long long)h.count(), (unsigned long long)h.percentile(0.5),
+                (unsigned long long)h.percentile(0.99), (unsigned long long)h.percentile(0.999),
+                (unsigned long long)h.max());
+}
+
+static std::unique_ptr<MarketDataProcessor> makeProcessor(int argc, char** argv) {
+    // market_data_processor --replay FILE [SPEED]
+    if (argc > 2 && std::string(argv[1]) == "--replay") {
+        return std::make_unique<MarketDataProcessor>(ReplayConfig{argv[2], argc > 3 ? std::atof(argv[3]) : 1.0});
+    }
+    // Optional Binance stream URL, synthetic updates otherwise
+    if (argc > 1) return std::make_unique<MarketDataProcessor>(std::string(argv[1]));
+    return std::make_unique<MarketDataProcessor>();
+}
+
+int main(int argc, char** argv) {
+    // A dropped wss:// feed must fail its write and reconnect (see websocket.hpp)
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::unique_ptr<MarketDataProcessor> source = makeProcessor(argc, argv);
+    MarketDataProcessor& processor = *source;
+
+    // A core per stage when there are enough to go around (0 is left to
+    // the feed and everything else)
+    PipelineConfig config;
+    if (std::thread::hardware_concurrency() >= 4) {
+        config.decode_cpu = 1;
+        config.validate_cpu = 2;
+        config.stats_cpu = 3;
+    }
+    MarketPipeline pipeline(processor.symbols(), config);
+    pipeline.attach(processor);
 
     std::cout << "Starting market data processor..." << std::endl;
+    pipeline.start();
     processor.start();
 
     // Run for 10 seconds
@@ -14,6 +53,28 @@ int main() {
 
     std::cout << "Stopping market data processor..." << std::endl;
     processor.stop();
+    pipeline.stop();
+
+    ValidationStats checks = pipeline.validation();
+    std::printf("%llu updates processed, %llu rejected (bad %llu, stale %llu, duplicate %llu), "
+                "%llu crossed, %llu gaps missing %llu updates\n",
+                (unsigned long long)pipeline.processed(), (unsigned long long)checks.rejected(),
+                (unsigned long long)checks.bad_value, (unsigned long long)checks.stale,
+                (unsigned long long)checks.duplicate, (unsigned long long)checks.crossed,
+                (unsigned long long)checks.gaps, (unsigned long long)checks.missed);
+
+    std::printf("Stage latency:\n");
+    printLatency("decode", pipeline.latency(PipelineStage::Decode));
+    printLatency("validate", pipeline.latency(PipelineStage::Validate));
+    printLatency("stats", pipeline.latency(PipelineStage::Stats));
+
+    const auto& stats = pipeline.stats();
+    for (uint32_t id = 0; id < stats.size(); ++id) {
+        if (stats[id].updates() == 0) continue;
+        std::printf("%-10s mid %.2f ewma %.2f vol %.3g vwap %.2f trades/s %.1f\n",
+                    processor.symbols().info(id).name.c_str(), stats[id].mid(), stats[id].ewmaMid(),
+                    stats[id].volatility(), stats[id].vwap(), stats[id].tradeRate());
+    }
 
     return 0;
 }
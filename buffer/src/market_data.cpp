@@ -1,5 +1,11 @@
 #include "market_data.hpp"
+#include "async_logger.hpp"
+#include "thread_affinity.hpp"
+#include "binance_stream.hpp"
+#include "market_capture.hpp"
+#include "websocket.hpp"
 #include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <thread>
 #include <chrono>
@@ -9,49 +15,111 @@
 
 MarketDataProcessor::MarketDataProcessor() = default;
 
+MarketDataProcessor::MarketDataProcessor(GeneratorConfig config) : generator_config_(std::move(config)) {}
+
+MarketDataProcessor::MarketDataProcessor(std::string stream_url) : stream_url_(std::move(stream_url)) {}
+
+MarketDataProcessor::MarketDataProcessor(const ReplayConfig& replay) :
+    replay_(loadCapture(replay.path, symbols_)), replay_speed_(replay.speed) {}
+
 void MarketDataProcessor::start() {
     running_ = true;
 
-    std::thread producer(&MarketDataProcessor::producerThread, this);
-    std::thread consumer(&MarketDataProcessor::consumerThread, this);
+    if (handlers_.empty()) {
+        static constexpr LogFormat PROCESSED{"Processed {} update for {} Price: {} Quantity: {}"};
+        AsyncLogger& console = AsyncLogger::console();
+        printing_ = true;
+
+        // Formatting and terminal writes happen on the logger's thread
+        addConsumer([this, &console, count = uint64_t(0), info = (const SymbolInfo*)nullptr,
+                     symbol = uint32_t(0)](const PackedMarketUpdate& packed) mutable {
+            if (!info || packed.symbol_id != symbol) {
+                symbol = packed.symbol_id;
+                info = &symbols_.info(symbol);
+            }
+            console.log(PROCESSED, ++count, info->name,
+                        packed.price / info->price_scale, packed.quantity / info->quantity_scale);
+        });
+    }
 
-    producer.detach();
-    consumer.detach();
+    for (auto& consumer : handlers_) {
+        consumers_.emplace_back(&MarketDataProcessor::consumerThread, this, consumer.id, consumer.handler, consumer.cpu);
+    }
+    if (!stream_url_.empty()) {
+        producer_ = std::thread(&MarketDataProcessor::streamThread, this);
+    } else if (!replay_.empty()) {
+        producer_ = std::thread(&MarketDataProcessor::replayThread, this);
+    } else {
+        producer_ = std::thread(&MarketDataProcessor::producerThread, this);
+    }
 }
 
+// Joins rather than detaches: the threads use this object
 void MarketDataProcessor::stop() {
     running_ = false;
+    market_data_buffer_.wake();
+    if (producer_.joinable()) producer_.join();
+    for (auto& consumer : consumers_) {
+        consumer.join();
+    }
+    consumers_.clear();
+    if (printing_) AsyncLogger::console().flush();
 }
 
-void MarketDataProcessor::producerThread() {
-    while (running_) {
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+int MarketDataProcessor::addConsumer(UpdateHandler handler, int cpu) {
+    int consumer = market_data_buffer_.subscribe();
+    if (consumer >= 0) {
+        handlers_.push_back({consumer, std::move(handler), cpu});
+    }
+    return consumer;
+}
 
-        std::string symbol("BTCUSDC");
-        const char side = 'B';
-        MarketUpdate update(timestamp, 100.0, 10.0, symbol, side);
+BroadcastStats MarketDataProcessor::consumerStats(int consumer) const {
+    return market_data_buffer_.stats(consumer);
+}
 
-        while (!market_data_buffer_.push(update)) {
-            std::this_thread::yield();
-        }
+MarketDataProcessor::~MarketDataProcessor() {
+    stop();
+}
 
-        std::this_thread::sleep_for(std::chrono::nanoseconds(1));
-    }
+void MarketDataProcessor::producerThread() {
+    MarketDataGenerator generator(generator_config_, symbols_);
+    generator.run(market_data_buffer_, running_);
+}
+
+void MarketDataProcessor::streamThread() {
+    WebSocketClient client(stream_url_);
+
+    // Messages carry one symbol each, so look it up once per message
+    std::string last_symbol;
+    uint32_t symbol_id = 0;
+    const SymbolInfo* info = nullptr;
+
+    client.run([&](std::string_view message, uint64_t arrival) {
+        parseBinanceMessage(message, arrival, [&](const MarketUpdate& update) {
+            if (!info || last_symbol != update.symbol) {
+                last_symbol = update.symbol;
+                symbol_id = symbols_.intern(last_symbol);
+                info = &symbols_.info(symbol_id);
+            }
+
+            PackedMarketUpdate* slot = market_data_buffer_.claim_wait(running_);
+            if (slot) *slot = pack(update, symbol_id, *info, sequence_++);
+        });
+        market_data_buffer_.commit();
+    }, running_);
 }
 
-void MarketDataProcessor::consumerThread() {
-    MarketUpdate update;
-    std::atomic<uint64_t> count{0};
+void MarketDataProcessor::replayThread() {
+    replayCapture(replay_, market_data_buffer_, running_, replay_speed_);
+}
+
+void MarketDataProcessor::consumerThread(int consumer, UpdateHandler handler, int cpu) {
+    pinCurrentThread(cpu);
     while (running_) {
-        if (market_data_buffer_.pop(update)) {
-            // Process the market update
-            count.store(count.load(std::memory_order_acquire) + 1, std::memory_order_release);
-            std::cout << "Processed " << count.load(std::memory_order_relaxed) << " update for " << update.symbol
-                      << " Price: " << update.price
-                      << " Quantity: " << update.quantity << std::endl;
-        }
-        std::this_thread::yield();
+        // Everything published since the last pass, in place, then one
+        // cursor store; waits per MARKET_DATA_WAIT_STRATEGY when idle
+        market_data_buffer_.consume_wait(consumer, handler, running_);
     }
 }
 
@@ -70,7 +138,7 @@ void MarketDataProcessor::fetchData() {
         const char side = 'B';
         MarketUpdate update(timestamp, price, 10.0, symbol, side);
 
-        while (!market_data_buffer_.push(update)) {
+        while (!market_data_buffer_.push(pack(update, symbols_, sequence_++))) {
             std::this_thread::yield();
         }
 
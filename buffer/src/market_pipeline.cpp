@@ -0,0 +1,124 @@
+#include "market_pipeline.hpp"
+#include "thread_affinity.hpp"
+#include <chrono>
+
+static uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t elapsed(uint64_t since, uint64_t now) {
+    return now > since ? now - since : 0;
+}
+
+MarketPipeline::MarketPipeline(const SymbolRegistry& symbols, PipelineConfig config) :
+    symbols_(symbols), config_(config),
+    decoded_(std::make_unique<StageRing>()), validated_(std::make_unique<StageRing>()),
+    validator_(config.max_age) {}
+
+MarketPipeline::~MarketPipeline() {
+    stop();
+}
+
+void MarketPipeline::attach(MarketDataProcessor& processor) {
+    processor.addConsumer([this](const PackedMarketUpdate& packed) { decode(packed); }, config_.decode_cpu);
+}
+
+void MarketPipeline::start() {
+    decoding_ = true;
+    validating_ = true;
+    validator_thread_ = std::thread(&MarketPipeline::validateThread, this);
+    stats_thread_ = std::thread(&MarketPipeline::statsThread, this);
+}
+
+// Stage by stage, so each one drains what the one before left it
+void MarketPipeline::stop() {
+    decoding_ = false;
+    decoded_->wake();
+    if (validator_thread_.joinable()) validator_thread_.join();
+
+    validating_ = false;
+    validated_->wake();
+    if (stats_thread_.joinable()) stats_thread_.join();
+}
+
+const LatencyHistogram& MarketPipeline::latency(PipelineStage stage) const {
+    return latency_[static_cast<size_t>(stage)];
+}
+
+void MarketPipeline::decode(const PackedMarketUpdate& packed) {
+    if (!info_ || packed.symbol_id != info_id_) {
+        info_id_ = packed.symbol_id;
+        info_ = &symbols_.info(info_id_);
+    }
+
+    Item* slot = decoded_->claim_wait(decoding_);
+    if (!slot) return;
+
+    uint64_t now = nowNanos();
+    slot->update = ::decode(packed, *info_);
+    slot->stamp = now;
+    decoded_->commit();
+
+    latency_[size_t(PipelineStage::Decode)].record(elapsed(packed.timestamp, now));
+}
+
+void MarketPipeline::validateThread() {
+    pinCurrentThread(config_.validate_cpu);
+    LatencyHistogram& latency = latency_[size_t(PipelineStage::Validate)];
+    size_t batch = 0;
+
+    while (true) {
+        const Item* in = decoded_->peek();
+        if (!in) {
+            // Idle: hand on what is done before waiting
+            validated_->commit();
+            batch = 0;
+            if (!(in = decoded_->peek_wait(decoding_))) break;
+        }
+
+        uint64_t now = nowNanos();
+        if (validator_.check(in->update, now) == Rejection::None) {
+            Item* out = validated_->claim_wait(validating_);
+            if (!out) break;
+            out->update = in->update;
+            out->stamp = now;
+        }
+        latency.record(elapsed(in->stamp, now));
+
+        if (++batch == BATCH_SIZE) {
+            decoded_->release();
+            validated_->commit();
+            batch = 0;
+        }
+    }
+    decoded_->release();
+    validated_->commit();
+}
+
+void MarketPipeline::statsThread() {
+    pinCurrentThread(config_.stats_cpu);
+    LatencyHistogram& latency = latency_[size_t(PipelineStage::Stats)];
+    size_t batch = 0;
+
+    while (const Item* in = validated_->peek_wait(validating_)) {
+        const DecodedUpdate& update = in->update;
+        if (update.symbol_id >= stats_.size()) stats_.resize(update.symbol_id + 1, SymbolStats(config_.ewma_alpha));
+
+        SymbolStats& stats = stats_[update.symbol_id];
+        switch (update.side) {
+            // A zero quantity deletes a depth level, it is no quote
+            case Side::Bid: if (update.quantity > 0) stats.onBid(update.price); break;
+            case Side::Ask: if (update.quantity > 0) stats.onAsk(update.price); break;
+            case Side::Trade: stats.onTrade(update.price, update.quantity, update.timestamp); break;
+        }
+        processed_.store(processed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        latency.record(elapsed(in->stamp, nowNanos()));
+
+        if (++batch == BATCH_SIZE) {
+            validated_->release();
+            batch = 0;
+        }
+    }
+    validated_->release();
+}
@@ -0,0 +1,46 @@
+#include "symbol_registry.hpp"
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+uint32_t SymbolRegistry::intern(std::string_view name, int price_decimals, int quantity_decimals) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) return it->second;
+
+    if (symbols_.size() >= MAX_SYMBOLS) {
+        throw std::runtime_error("symbol registry full");
+    }
+
+    uint32_t id = static_cast<uint32_t>(symbols_.size());
+    symbols_.push_back(SymbolInfo{std::string(name), price_decimals, quantity_decimals,
+                                  std::pow(10.0, price_decimals), std::pow(10.0, quantity_decimals)});
+    ids_.emplace(std::string(name), id);
+    return id;
+}
+
+std::optional<uint32_t> SymbolRegistry::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) return std::nullopt;
+    return it->second;
+}
+
+const SymbolInfo& SymbolRegistry::info(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= symbols_.size()) {
+        throw std::out_of_range("unknown symbol id " + std::to_string(id));
+    }
+    return symbols_[id];
+}
+
+size_t SymbolRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return symbols_.size();
+}
@@ -0,0 +1,411 @@
+#include "websocket.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <openssl/ssl.h>
+#include "tcpconnector.h"
+
+namespace {
+
+constexpr uint8_t OP_CONTINUATION = 0x0;
+constexpr uint8_t OP_TEXT = 0x1;
+constexpr uint8_t OP_BINARY = 0x2;
+constexpr uint8_t OP_CLOSE = 0x8;
+constexpr uint8_t OP_PING = 0x9;
+constexpr uint8_t OP_PONG = 0xA;
+
+uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string base64(const unsigned char* data, size_t len) {
+    std::string out(4 * ((len + 2) / 3), '\0');
+    EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&out[0]), data, static_cast<int>(len));
+    return out;
+}
+
+// Value of header name (case-insensitive) in a raw response head
+std::string headerValue(const std::string& head, const char* name) {
+    std::string lower(head);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    std::string key = std::string("\r\n") + name + ":";
+    size_t pos = lower.find(key);
+    if (pos == std::string::npos) return "";
+
+    size_t start = head.find_first_not_of(' ', pos + key.size());
+    size_t end = head.find("\r\n", start);
+    return head.substr(start, end - start);
+}
+
+}  // namespace
+
+WebSocketClient::WebSocketClient(const std::string& url) : rx_(READ_CHUNK) {
+    size_t scheme = url.find("://");
+    tls_ = url.compare(0, scheme, "wss") == 0;
+    port_ = tls_ ? 443 : 80;
+
+    size_t hostStart = scheme == std::string::npos ? 0 : scheme + 3;
+    size_t pathStart = url.find('/', hostStart);
+    std::string authority = url.substr(hostStart, pathStart - hostStart);
+    path_ = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+
+    size_t colon = authority.find(':');
+    host_ = authority.substr(0, colon);
+    if (colon != std::string::npos) {
+        port_ = std::stoi(authority.substr(colon + 1));
+    }
+}
+
+WebSocketClient::~WebSocketClient() {
+    close();
+    if (sslCtx_) SSL_CTX_free(sslCtx_);
+}
+
+bool WebSocketClient::connect() {
+    close();
+
+    TCPConnector connector;
+    stream_ = connector.connect(port_, host_.c_str());
+    if (!stream_) return false;
+
+    int fd = stream_->getDescriptor();
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    timeval timeout{readTimeoutMs / 1000, (readTimeoutMs % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    if (tls_) {
+        if (!sslCtx_) {
+            sslCtx_ = SSL_CTX_new(TLS_client_method());
+            SSL_CTX_set_default_verify_paths(sslCtx_);
+            SSL_CTX_set_verify(sslCtx_, SSL_VERIFY_PEER, nullptr);
+        }
+
+        ssl_ = SSL_new(sslCtx_);
+        SSL_set_fd(ssl_, fd);
+        SSL_set_tlsext_host_name(ssl_, host_.c_str());
+        SSL_set1_host(ssl_, host_.c_str());
+
+        if (SSL_connect(ssl_) != 1) {
+            std::cerr << "TLS handshake with " << host_ << " failed" << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    rxStart_ = rxEnd_ = 0;
+    fragments_.clear();
+    inFragment_ = false;
+
+    if (!handshake()) {
+        close();
+        return false;
+    }
+
+    for (const std::string& subscription : subscriptions_) {
+        if (!sendText(subscription)) {
+            close();
+            return false;
+        }
+    }
+
+    lastReceive_ = nowNanos();
+    return true;
+}
+
+void WebSocketClient::close() {
+    if (ssl_) {
+        SSL_shutdown(ssl_);
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+    }
+    delete stream_;
+    stream_ = nullptr;
+}
+
+bool WebSocketClient::handshake() {
+    unsigned char nonce[16];
+    RAND_bytes(nonce, sizeof(nonce));
+    std::string key = base64(nonce, sizeof(nonce));
+
+    std::string request =
+        "GET " + path_ + " HTTP/1.1\r\n"
+        "Host: " + host_ + ":" + std::to_string(port_) + "\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " + key + "\r\n"
+        "Sec-WebSocket-Version: 13\r\n"
+        "\r\n";
+
+    if (!writeAll(request.data(), request.size())) return false;
+
+    // Read the response head; anything after it is already frame data
+    std::string head;
+    size_t end;
+    int waited = 0;
+    while ((end = head.find("\r\n\r\n")) == std::string::npos) {
+        char buf[1024];
+        ssize_t len = readSome(buf, sizeof(buf));
+
+        if (len < 0 && errno == EAGAIN && (waited += readTimeoutMs) < HANDSHAKE_TIMEOUT_MS) continue;
+        if (len <= 0 || head.size() > 16 * 1024) return false;
+        head.append(buf, len);
+    }
+
+    size_t extra = head.size() - (end + 4);
+    std::memcpy(rx_.data(), head.data() + end + 4, extra);
+    rxEnd_ = extra;
+    unparsed_ = extra > 0;
+    head.resize(end + 2);
+
+    if (head.compare(0, 12, "HTTP/1.1 101") != 0) {
+        std::cerr << "WebSocket upgrade refused: " << head.substr(0, head.find("\r\n")) << std::endl;
+        return false;
+    }
+
+    std::string expected = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(expected.data()), expected.size(), digest);
+
+    return headerValue(head, "sec-websocket-accept") == base64(digest, sizeof(digest));
+}
+
+ssize_t WebSocketClient::readSome(char* buffer, size_t len) {
+    if (ssl_) {
+        int n = SSL_read(ssl_, buffer, static_cast<int>(len));
+        if (n > 0) return n;
+
+        int error = SSL_get_error(ssl_, n);
+        if (error == SSL_ERROR_WANT_READ || (error == SSL_ERROR_SYSCALL && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+            errno = EAGAIN;
+            return -1;
+        }
+        return 0;
+    }
+    return stream_->receive(buffer, len);
+}
+
+bool WebSocketClient::writeAll(const char* buffer, size_t len) {
+    while (len > 0) {
+        // A peer that went away is a failed write, not SIGPIPE
+        ssize_t n = ssl_ ? SSL_write(ssl_, buffer, static_cast<int>(len))
+                         : ::send(stream_->getDescriptor(), buffer, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (!ssl_ && errno == EINTR) continue;
+            return false;
+        }
+        buffer += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool WebSocketClient::sendFrame(uint8_t opcode, const char* payload, size_t len) {
+    if (!stream_) return false;
+
+    tx_.resize(14 + len);
+    uint8_t* out = reinterpret_cast<uint8_t*>(tx_.data());
+    size_t pos = 0;
+
+    out[pos++] = 0x80 | opcode;  // FIN, never fragment outgoing messages
+    if (len < 126) {
+        out[pos++] = 0x80 | static_cast<uint8_t>(len);
+    } else if (len <= 0xFFFF) {
+        out[pos++] = 0x80 | 126;
+        out[pos++] = static_cast<uint8_t>(len >> 8);
+        out[pos++] = static_cast<uint8_t>(len);
+    } else {
+        out[pos++] = 0x80 | 127;
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out[pos++] = static_cast<uint8_t>(static_cast<uint64_t>(len) >> shift);
+        }
+    }
+
+    uint8_t mask[4];
+    RAND_bytes(mask, sizeof(mask));
+    std::memcpy(out + pos, mask, sizeof(mask));
+    pos += sizeof(mask);
+
+    for (size_t i = 0; i < len; ++i) {
+        out[pos + i] = static_cast<uint8_t>(payload[i]) ^ mask[i & 3];
+    }
+
+    return writeAll(tx_.data(), pos + len);
+}
+
+bool WebSocketClient::sendText(std::string_view text) {
+    return sendFrame(OP_TEXT, text.data(), text.size());
+}
+
+void WebSocketClient::addSubscription(std::string message) {
+    if (stream_) sendText(message);
+    subscriptions_.push_back(std::move(message));
+}
+
+bool WebSocketClient::drainFrames(const MessageHandler& onMessage, uint64_t arrival) {
+    while (rxEnd_ - rxStart_ >= 2) {
+        uint8_t* frame = reinterpret_cast<uint8_t*>(rx_.data() + rxStart_);
+        size_t available = rxEnd_ - rxStart_;
+
+        bool fin = frame[0] & 0x80;
+        uint8_t opcode = frame[0] & 0x0F;
+        bool masked = frame[1] & 0x80;
+        uint64_t len = frame[1] & 0x7F;
+        size_t header = 2;
+
+        if (len == 126) {
+            if (available < 4) break;
+            len = (uint64_t(frame[2]) << 8) | frame[3];
+            header = 4;
+        } else if (len == 127) {
+            if (available < 10) break;
+            len = 0;
+            for (int i = 2; i < 10; ++i) len = (len << 8) | frame[i];
+            header = 10;
+        }
+
+        if (len > MAX_MESSAGE) {
+            std::cerr << "WebSocket frame of " << len << " bytes rejected" << std::endl;
+            return false;
+        }
+
+        size_t maskOffset = header;
+        if (masked) header += 4;
+
+        if (available < header + len) break;  // poll() grows rx_ as the frame arrives
+
+        char* payload = reinterpret_cast<char*>(frame + header);
+        if (masked) {
+            // Servers must not mask, but unmasking costs nothing
+            for (uint64_t i = 0; i < len; ++i) payload[i] ^= frame[maskOffset + (i & 3)];
+        }
+
+        rxStart_ += header + len;
+
+        switch (opcode) {
+            case OP_TEXT:
+            case OP_BINARY:
+                if (fin) {
+                    onMessage(std::string_view(payload, len), arrival);
+                } else {
+                    fragments_.assign(payload, len);
+                    inFragment_ = true;
+                }
+                break;
+
+            case OP_CONTINUATION:
+                if (!inFragment_) return false;
+                if (fragments_.size() + len > MAX_MESSAGE) return false;
+
+                fragments_.append(payload, len);
+                if (fin) {
+                    onMessage(fragments_, arrival);
+                    fragments_.clear();
+                    inFragment_ = false;
+                }
+                break;
+
+            case OP_PING:
+                pings_++;
+                if (!sendFrame(OP_PONG, payload, len)) return false;
+                break;
+
+            case OP_PONG:
+                break;
+
+            case OP_CLOSE:
+                sendFrame(OP_CLOSE, payload, std::min<uint64_t>(len, 2));
+                return false;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool WebSocketClient::poll(const MessageHandler& onMessage) {
+    if (!stream_) return false;
+
+    // Frames that came in with the handshake response
+    if (unparsed_) {
+        unparsed_ = false;
+        if (!drainFrames(onMessage, lastReceive_)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Compact, then make sure a full chunk fits behind the pending bytes
+    if (rxStart_ == rxEnd_) {
+        rxStart_ = rxEnd_ = 0;
+    } else if (rxStart_ > 0 && rx_.size() - rxEnd_ < READ_CHUNK) {
+        std::memmove(rx_.data(), rx_.data() + rxStart_, rxEnd_ - rxStart_);
+        rxEnd_ -= rxStart_;
+        rxStart_ = 0;
+    }
+    if (rx_.size() - rxEnd_ < READ_CHUNK) {
+        rx_.resize(rxEnd_ + READ_CHUNK);
+    }
+
+    ssize_t len = readSome(rx_.data() + rxEnd_, rx_.size() - rxEnd_);
+    if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        if (nowNanos() - lastReceive_ < static_cast<uint64_t>(idleTimeoutMs) * 1000000) return true;
+
+        std::cerr << "WebSocket to " << host_ << " silent for " << idleTimeoutMs << "ms, dropping it" << std::endl;
+        close();
+        return false;
+    }
+    if (len <= 0) {
+        close();
+        return false;
+    }
+
+    uint64_t arrival = nowNanos();
+    lastReceive_ = arrival;
+    rxEnd_ += len;
+
+    if (!drainFrames(onMessage, arrival)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void WebSocketClient::run(const MessageHandler& onMessage, const std::atomic<bool>& running) {
+    int backoff = 100;
+
+    while (running) {
+        if (!stream_) {
+            if (!connect()) {
+                std::cerr << "WebSocket connect to " << host_ << " failed, retrying in " << backoff << "ms" << std::endl;
+                for (int waited = 0; waited < backoff && running; waited += 50) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                }
+                backoff = std::min(backoff * 2, maxBackoffMs);
+                continue;
+            }
+            backoff = 100;
+        }
+
+        if (!poll(onMessage)) {
+            reconnects_++;
+        }
+    }
+
+    close();
+}
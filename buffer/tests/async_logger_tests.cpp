@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "async_logger.hpp"
+
+namespace {
+    enum class Venue { Binance, Okx };
+
+    std::ostream& operator<<(std::ostream& os, Venue venue) {
+        return os << (venue == Venue::Binance ? "BINANCE" : "OKX");
+    }
+
+    struct Pair {
+        char base[4];
+        char quote[5];
+    };
+
+    std::ostream& operator<<(std::ostream& os, const Pair& pair) {
+        return os << pair.base << "/" << pair.quote;
+    }
+}
+
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    std::string path = "async_logger_test_" + std::to_string(getpid()) + ".log";
+
+    void TearDown() override {
+        unlink(path.c_str());
+    }
+
+    std::vector<std::string> lines() {
+        std::ifstream in(path);
+        std::vector<std::string> result;
+        for (std::string line; std::getline(in, line);) result.push_back(line);
+        return result;
+    }
+};
+
+// Basic functionality tests
+TEST_F(AsyncLoggerTest, FormatsArguments) {
+    static constexpr LogFormat LINE{"{} {} {} {} {} {} done"};
+    {
+        AsyncLogger logger(path, false);
+        std::string owned("heap");
+        logger.log(LINE, 42, -7L, 67000.25, "literal", owned, true);
+    }
+
+    auto result = lines();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0], "42 -7 67000.25 literal heap true done");
+}
+
+TEST_F(AsyncLoggerTest, PrintsTypesThroughStreamOperator) {
+    static constexpr LogFormat LINE{"{} {}"};
+    {
+        AsyncLogger logger(path, false);
+        logger.log(LINE, Venue::Okx, Pair{"BTC", "USDT"});
+    }
+
+    auto result = lines();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0], "OKX BTC/USDT");
+}
+
+TEST_F(AsyncLoggerTest, PrefixesTimestamps) {
+    static constexpr LogFormat LINE{"tick {}"};
+    {
+        AsyncLogger logger(path);
+        logger.log(LINE, 1);
+    }
+
+    auto result = lines();
+    ASSERT_EQ(result.size(), 1);
+    // [seconds.micros] tick 1
+    EXPECT_EQ(result[0].front(), '[');
+    EXPECT_EQ(result[0].find("] tick 1"), result[0].size() - 8);
+    EXPECT_EQ(result[0][result[0].find('.') + 7], ']');
+}
+
+TEST_F(AsyncLoggerTest, TruncatesWhatDoesNotFit) {
+    static constexpr LogFormat LINE{"{}|{}"};
+    {
+        AsyncLogger logger(path, false);
+        logger.log(LINE, std::string(1000, 'x'), 5);
+    }
+
+    auto result = lines();
+    ASSERT_EQ(result.size(), 1);
+    // The string takes the rest of the record, the int is left out
+    size_t kept = LogRecord::ARGS_SIZE - sizeof(LogPrinter) - 1;
+    EXPECT_EQ(result[0], std::string(kept, 'x') + "|{}");
+}
+
+TEST_F(AsyncLoggerTest, FlushWritesPendingRecords) {
+    static constexpr LogFormat LINE{"record {}"};
+    AsyncLogger logger(path, false);
+    for (int i = 0; i < 10; ++i) logger.log(LINE, i);
+
+    logger.flush();
+    auto result = lines();
+    ASSERT_EQ(result.size(), 10);
+    EXPECT_EQ(result[9], "record 9");
+}
+
+TEST_F(AsyncLoggerTest, SharedFileLoggerIsOnePerPath) {
+    EXPECT_EQ(&AsyncLogger::file(path), &AsyncLogger::file(path));
+}
+
+// Multi-threaded tests
+TEST_F(AsyncLoggerTest, KeepsPerThreadOrder) {
+    static constexpr LogFormat LINE{"{} {}"};
+    static constexpr int NUM_THREADS = 4;
+    static constexpr int NUM_RECORDS = 5000;
+    uint64_t dropped;
+    {
+        AsyncLogger logger(path, false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < NUM_RECORDS; ++i) {
+                    logger.log(LINE, t, i);
+                    if (i % 512 == 511) logger.flush();  // let the writer keep up
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        dropped = logger.dropped();
+    }
+
+    std::vector<int> last(NUM_THREADS, -1);
+    size_t total = 0;
+    for (const std::string& line : lines()) {
+        std::istringstream in(line);
+        int t, i;
+        in >> t >> i;
+        ASSERT_GT(i, last[t]);
+        last[t] = i;
+        ++total;
+    }
+    EXPECT_EQ(total + dropped, size_t(NUM_THREADS) * NUM_RECORDS);
+    EXPECT_LT(dropped, total);
+}
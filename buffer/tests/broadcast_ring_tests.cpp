@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "broadcast_ring.hpp"
+
+class BroadcastRingTest : public ::testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 16;
+    BroadcastRing<int, BUFFER_SIZE, 4> ring;
+};
+
+static std::vector<int> drain(BroadcastRing<int, 16, 4>& ring, int id) {
+    std::vector<int> items;
+    ring.consume(id, [&](const int& value) { items.push_back(value); });
+    return items;
+}
+
+// Basic functionality tests
+TEST_F(BroadcastRingTest, EveryConsumerSeesEveryItem) {
+    int a = ring.subscribe();
+    int b = ring.subscribe();
+    ASSERT_NE(a, b);
+
+    for (int i = 0; i < 5; ++i) ring.push(i);
+
+    std::vector<int> expected = {0, 1, 2, 3, 4};
+    EXPECT_EQ(drain(ring, a), expected);
+    EXPECT_EQ(drain(ring, b), expected);
+    EXPECT_TRUE(drain(ring, a).empty());
+}
+
+TEST_F(BroadcastRingTest, ConsumesInPlace) {
+    int id = ring.subscribe();
+    *ring.claim() = 7;
+    ring.commit();
+
+    const int* seen = nullptr;
+    ring.consume(id, [&](const int& value) { seen = &value; });
+    ASSERT_NE(seen, nullptr);
+    EXPECT_EQ(*seen, 7);
+
+    ring.push(8);  // the next slot, so the one seen is untouched
+    EXPECT_EQ(*seen, 7);
+}
+
+TEST_F(BroadcastRingTest, GatesOnSlowestConsumer) {
+    int fast = ring.subscribe();
+    int slow = ring.subscribe();
+
+    for (size_t i = 0; i < BUFFER_SIZE; ++i) {
+        ASSERT_TRUE(ring.push(i));
+        drain(ring, fast);
+    }
+    EXPECT_FALSE(ring.push(100));  // slow has not read anything
+
+    EXPECT_EQ(ring.consume(slow, [](const int&) {}, 1), 1);
+    EXPECT_TRUE(ring.push(100));
+    EXPECT_FALSE(ring.push(101));
+}
+
+TEST_F(BroadcastRingTest, UnsubscribedConsumerDoesNotGate) {
+    int stays = ring.subscribe();
+    int leaves = ring.subscribe();
+    ring.unsubscribe(leaves);
+
+    for (size_t i = 0; i < 3 * BUFFER_SIZE; ++i) {
+        ASSERT_TRUE(ring.push(i));
+        drain(ring, stays);
+    }
+}
+
+TEST_F(BroadcastRingTest, LateSubscriberStartsAtNextItem) {
+    ring.push(1);
+    ring.push(2);
+    int id = ring.subscribe();
+    ring.push(3);
+
+    EXPECT_EQ(drain(ring, id), std::vector<int>{3});
+}
+
+TEST_F(BroadcastRingTest, SubscribeFailsPastMaxConsumers) {
+    for (int i = 0; i < 4; ++i) EXPECT_GE(ring.subscribe(), 0);
+    EXPECT_EQ(ring.subscribe(), -1);
+}
+
+TEST_F(BroadcastRingTest, LagMetrics) {
+    int id = ring.subscribe();
+    for (int i = 0; i < 10; ++i) ring.push(i);
+    EXPECT_EQ(ring.lag(id), 10);
+
+    ring.consume(id, [](const int&) {}, 4);
+    BroadcastStats stats = ring.stats(id);
+    EXPECT_EQ(stats.consumed, 4);
+    EXPECT_EQ(stats.lag, 6);
+    EXPECT_EQ(stats.maxLag, 10);
+    EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST(BroadcastRingLossyTest, OverwritesAndCountsGap) {
+    BroadcastRing<int, 16, 4> ring(BroadcastMode::Lossy);
+    int id = ring.subscribe();
+
+    for (int i = 0; i < 40; ++i) ASSERT_TRUE(ring.push(i));
+
+    std::vector<int> items = drain(ring, id);
+    ASSERT_EQ(items.size(), 16);
+    EXPECT_EQ(items.front(), 24);  // oldest still in the ring
+    EXPECT_EQ(items.back(), 39);
+
+    BroadcastStats stats = ring.stats(id);
+    EXPECT_EQ(stats.dropped, 24);
+    EXPECT_EQ(stats.consumed, 16);
+    EXPECT_EQ(stats.lag, 0);
+}
+
+// Multi-threaded tests
+TEST(BroadcastRingThreadedTest, GatedFanOutDeliversEverythingInOrder) {
+    static constexpr int NUM_ITEMS = 200000;
+    static constexpr int NUM_CONSUMERS = 3;
+
+    auto ring = std::make_unique<BroadcastRing<int, 64, 4>>();
+    std::vector<int> ids;
+    for (int c = 0; c < NUM_CONSUMERS; ++c) ids.push_back(ring->subscribe());
+
+    std::vector<std::thread> consumers;
+    std::vector<int> errors(NUM_CONSUMERS, 0);
+    for (int c = 0; c < NUM_CONSUMERS; ++c) {
+        consumers.emplace_back([&, c] {
+            int expected = 0;
+            while (expected < NUM_ITEMS) {
+                size_t n = ring->consume(ids[c], [&](const int& value) {
+                    errors[c] += value != expected++;
+                });
+                if (n == 0) std::this_thread::yield();
+            }
+        });
+    }
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        while (!ring->push(i)) std::this_thread::yield();
+    }
+    for (auto& consumer : consumers) consumer.join();
+
+    for (int c = 0; c < NUM_CONSUMERS; ++c) {
+        EXPECT_EQ(errors[c], 0);
+        EXPECT_EQ(ring->stats(ids[c]).consumed, NUM_ITEMS);
+        EXPECT_LE(ring->stats(ids[c]).maxLag, 64);
+    }
+}
+
+TEST(BroadcastRingThreadedTest, LossySlowConsumerNeverSeesTornItems) {
+    struct Item {
+        uint64_t a, b, c, d;  // all equal when written whole
+    };
+    static constexpr uint64_t NUM_ITEMS = 500000;
+
+    auto ring = std::make_unique<BroadcastRing<Item, 32, 2>>(BroadcastMode::Lossy);
+    int id = ring->subscribe();
+    std::atomic<bool> done{false};
+
+    std::thread consumer([&] {
+        uint64_t last = 0;
+        bool ok = true;
+        while (!done || ring->lag(id) > 0) {
+            ring->consume(id, [&](const Item& item) {
+                ok &= item.a == item.b && item.b == item.c && item.c == item.d;
+                ok &= last == 0 || item.a > last;  // never goes backwards
+                last = item.a;
+            });
+        }
+        EXPECT_TRUE(ok);
+    });
+
+    for (uint64_t i = 1; i <= NUM_ITEMS; ++i) {
+        Item* slot = ring->claim();
+        *slot = Item{i, i, i, i};
+        ring->commit();
+    }
+    done = true;
+    consumer.join();
+
+    BroadcastStats stats = ring->stats(id);
+    EXPECT_EQ(stats.consumed + stats.dropped, NUM_ITEMS);
+}
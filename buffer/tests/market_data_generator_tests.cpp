@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "market_capture.hpp"
+#include "market_data.hpp"
+#include "market_data_generator.hpp"
+#include "ring_buffer.hpp"
+#include "update_validator.hpp"
+
+static std::vector<PackedMarketUpdate> generate(const GeneratorConfig& config, SymbolRegistry& registry, size_t count) {
+    MarketDataGenerator generator(config, registry);
+    std::vector<PackedMarketUpdate> updates(count);
+    for (PackedMarketUpdate& update : updates) generator.next(update);
+    return updates;
+}
+
+static std::string tempPath(const char* name) {
+    return "/tmp/" + std::string(name) + "." + std::to_string(::getpid()) + ".cap";
+}
+
+// Generator tests
+TEST(MarketDataGeneratorTest, SameSeedSameUpdates) {
+    SymbolRegistry first, second, third;
+    GeneratorConfig config;
+    auto a = generate(config, first, 10000);
+    auto b = generate(config, second, 10000);
+    config.seed = 2;
+    auto c = generate(config, third, 10000);
+
+    // Event times start at the wall clock; everything else must match
+    bool same = true, differs = false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        same &= a[i].timestamp - a[0].timestamp == b[i].timestamp - b[0].timestamp;
+        same &= a[i].price == b[i].price && a[i].quantity == b[i].quantity;
+        same &= a[i].symbol_id == b[i].symbol_id && a[i].side == b[i].side && a[i].sequence == b[i].sequence;
+        differs |= a[i].price != c[i].price || a[i].side != c[i].side;
+    }
+    EXPECT_TRUE(same);
+    EXPECT_TRUE(differs);
+}
+
+TEST(MarketDataGeneratorTest, PassesValidation) {
+    SymbolRegistry registry;
+    GeneratorConfig config;
+    config.move_probability = 0.3;  // plenty of mid moves
+    auto updates = generate(config, registry, 200000);
+
+    UpdateValidator validator(UINT64_MAX);
+    for (const PackedMarketUpdate& update : updates) {
+        ASSERT_EQ(validator.check(decode(update, registry.info(update.symbol_id)), update.timestamp), Rejection::None)
+            << "sequence " << update.sequence;
+    }
+    EXPECT_EQ(validator.stats().gaps, 0);
+}
+
+TEST(MarketDataGeneratorTest, SharesFlowByWeight) {
+    SymbolRegistry registry;
+    auto updates = generate(GeneratorConfig{}, registry, 70000);
+
+    uint64_t counts[3] = {};
+    uint64_t trades = 0;
+    for (const PackedMarketUpdate& update : updates) {
+        counts[update.symbol_id]++;
+        trades += update.side == Side::Trade;
+    }
+
+    // Weights 4:2:1
+    EXPECT_NEAR(counts[0] / 70000.0, 4 / 7.0, 0.01);
+    EXPECT_NEAR(counts[1] / 70000.0, 2 / 7.0, 0.01);
+    EXPECT_NEAR(counts[2] / 70000.0, 1 / 7.0, 0.01);
+    EXPECT_GT(trades, 0);
+    EXPECT_EQ(registry.info(0).name, "BTCUSDC");
+}
+
+TEST(MarketDataGeneratorTest, MeanInterArrivalMatchesRate) {
+    SymbolRegistry registry;
+    GeneratorConfig config;
+    config.rate = 100000;
+    auto plain = generate(config, registry, 100000);
+    config.burst_factor = 10;
+    auto bursty = generate(config, registry, 100000);
+
+    auto meanGap = [](const std::vector<PackedMarketUpdate>& updates) {
+        return double(updates.back().timestamp - updates.front().timestamp) / (updates.size() - 1);
+    };
+    EXPECT_NEAR(meanGap(plain), 10000, 500);
+    EXPECT_NEAR(meanGap(bursty), 10000, 2000);
+}
+
+TEST(MarketDataGeneratorTest, RunPublishesIntoRing) {
+    SymbolRegistry registry;
+    GeneratorConfig config;
+    config.rate = 0;
+    MarketDataGenerator generator(config, registry);
+
+    RingBuffer<PackedMarketUpdate, 1024> ring;
+    std::atomic<bool> running{true};
+    uint64_t published = 0;
+    std::thread producer([&] { published = generator.run(ring, running, 5000); });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < 5000) {
+        if (const PackedMarketUpdate* update = ring.peek()) {
+            ordered &= update->sequence == expected++;
+            ring.release();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(published, 5000);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(generator.sequence(), 5000);
+}
+
+// Capture tests
+TEST(MarketCaptureTest, RoundTripsIntoAnotherRegistry) {
+    std::string path = tempPath("roundtrip");
+    SymbolRegistry source;
+    auto updates = generate(GeneratorConfig{}, source, 1000);
+    {
+        CaptureWriter writer(path, source);
+        for (const PackedMarketUpdate& update : updates) writer.write(update);
+        EXPECT_EQ(writer.count(), 1000);
+    }
+
+    // Ids differ on the reading side: remapped by name
+    SymbolRegistry target;
+    target.intern("SOLUSDC", 3, 2);
+    auto loaded = loadCapture(path, target);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(loaded.size(), updates.size());
+    for (size_t i = 0; i < updates.size(); ++i) {
+        EXPECT_EQ(target.info(loaded[i].symbol_id).name, source.info(updates[i].symbol_id).name);
+        EXPECT_EQ(loaded[i].price, updates[i].price);
+        EXPECT_EQ(loaded[i].timestamp, updates[i].timestamp);
+        EXPECT_EQ(loaded[i].sequence, updates[i].sequence);
+    }
+}
+
+TEST(MarketCaptureTest, RejectsUnclosedCapture) {
+    std::string path = tempPath("unclosed");
+    SymbolRegistry registry;
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    CaptureHeader header{};
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fclose(file);
+
+    EXPECT_THROW(loadCapture(path, registry), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(loadCapture(path, registry), std::runtime_error);
+}
+
+TEST(MarketCaptureTest, ReplayRebasesTimestamps) {
+    std::vector<PackedMarketUpdate> updates(3);
+    for (uint32_t i = 0; i < updates.size(); ++i) {
+        updates[i] = PackedMarketUpdate{};
+        updates[i].timestamp = 1000 + i * 2'000'000;  // 2ms apart
+        updates[i].sequence = i;
+    }
+
+    RingBuffer<PackedMarketUpdate, 16> ring;
+    std::atomic<bool> running{true};
+    uint64_t before = wallClockNanos();
+    EXPECT_EQ(replayCapture(updates, ring, running, 2.0), 3);
+
+    std::vector<uint64_t> stamps;
+    while (const PackedMarketUpdate* update = ring.peek()) {
+        stamps.push_back(update->timestamp);
+        ring.release();
+    }
+    ASSERT_EQ(stamps.size(), 3);
+    EXPECT_GE(stamps[0], before);
+    EXPECT_EQ(stamps[1] - stamps[0], 1'000'000);  // twice as fast
+    EXPECT_EQ(stamps[2] - stamps[0], 2'000'000);
+    EXPECT_GE(wallClockNanos(), stamps[2]);
+}
+
+TEST(MarketCaptureTest, ProcessorReplaysCapture) {
+    std::string path = tempPath("processor");
+    {
+        SymbolRegistry registry;
+        auto updates = generate(GeneratorConfig{}, registry, 3000);
+        CaptureWriter writer(path, registry);
+        for (const PackedMarketUpdate& update : updates) writer.write(update);
+    }
+
+    MarketDataProcessor processor(ReplayConfig{path, 0});
+    std::remove(path.c_str());
+    std::atomic<uint64_t> received{0};
+    processor.addConsumer([&](const PackedMarketUpdate&) { received++; });
+
+    processor.start();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received < 3000 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    processor.stop();
+
+    EXPECT_EQ(received.load(), 3000);
+    EXPECT_EQ(processor.symbols().info(0).name, "BTCUSDC");
+}
@@ -23,6 +23,72 @@ TEST_F(MarketDataTest, MarketUpdateConstruction) {
     EXPECT_EQ(update.side, 'B');
 }
 
+TEST_F(MarketDataTest, MarketUpdateFromStringView) {
+    MarketUpdate update(1, 2.0, 3.0, "ETHUSDT", 'A');
+    EXPECT_STREQ(update.symbol, "ETHUSDT");
+
+    MarketUpdate truncated(1, 2.0, 3.0, "A_VERY_LONG_SYMBOL_NAME", 'A');
+    EXPECT_STREQ(truncated.symbol, "A_VERY_LONG_SYM");
+}
+
+// Packed format
+TEST_F(MarketDataTest, PackedLayout) {
+    EXPECT_EQ(sizeof(PackedMarketUpdate), 32);
+    EXPECT_EQ(alignof(PackedMarketUpdate), 32);
+}
+
+TEST_F(MarketDataTest, PackRoundTrip) {
+    SymbolRegistry registry;
+    registry.intern("BTCUSDT", 2, 5);
+
+    MarketUpdate update(1718000000123, 67012.34, 0.51234, "BTCUSDT", 'A');
+    PackedMarketUpdate packed = pack(update, registry, 77);
+
+    EXPECT_EQ(packed.price, 6701234);
+    EXPECT_EQ(packed.quantity, 51234);
+    EXPECT_EQ(packed.sequence, 77);
+    EXPECT_EQ(packed.symbol_id, *registry.find("BTCUSDT"));
+    EXPECT_EQ(packed.side, Side::Ask);
+
+    MarketUpdate back = unpack(packed, registry);
+    EXPECT_EQ(back.timestamp, update.timestamp);
+    EXPECT_DOUBLE_EQ(back.price, 67012.34);
+    EXPECT_DOUBLE_EQ(back.quantity, 0.51234);
+    EXPECT_STREQ(back.symbol, "BTCUSDT");
+    EXPECT_EQ(back.side, 'A');
+}
+
+TEST_F(MarketDataTest, PackRegistersNewSymbols) {
+    SymbolRegistry registry;
+    MarketUpdate update(1, 3521.1, 12.4, "ETHUSDT", 'B');
+
+    PackedMarketUpdate packed = pack(update, registry, 0);
+    EXPECT_EQ(registry.size(), 1);
+    EXPECT_EQ(packed.price, 352110000000);  // default 8 decimals
+    EXPECT_DOUBLE_EQ(unpack(packed, registry).price, 3521.1);
+}
+
+TEST_F(MarketDataTest, ConsumersReceivePackedUpdates) {
+    MarketDataProcessor source;
+    std::atomic<uint64_t> received{0};
+    std::atomic<bool> ordered{true};
+    uint32_t last = 0;
+
+    source.addConsumer([&](const PackedMarketUpdate& update) {
+        if (received > 0 && update.sequence != last + 1) ordered = false;
+        last = update.sequence;
+        received++;
+    });
+
+    source.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    source.stop();
+
+    EXPECT_GT(received.load(), 0);
+    EXPECT_TRUE(ordered.load());
+    EXPECT_EQ(source.symbols().info(0).name, "BTCUSDC");
+}
+
 // Test market data processing
 TEST_F(MarketDataTest, ProcessorStartStop) {
     processor.start();
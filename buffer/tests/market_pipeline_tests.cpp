@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include "latency_histogram.hpp"
+#include "market_pipeline.hpp"
+#include "market_stats.hpp"
+#include "update_validator.hpp"
+
+static constexpr uint64_t SECOND = 1'000'000'000;
+static constexpr uint64_t NOW = 1'700'000'000 * SECOND;
+
+static DecodedUpdate makeUpdate(uint32_t sequence, Side side, double price, double quantity = 1.0,
+                                uint64_t timestamp = NOW, uint32_t symbol = 0) {
+    return DecodedUpdate{timestamp, price, quantity, sequence, symbol, side};
+}
+
+// Latency histogram tests
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t ns = 1; ns <= 10000; ++ns) histogram.record(ns);
+
+    EXPECT_EQ(histogram.count(), 10000);
+    EXPECT_EQ(histogram.max(), 10000);
+    EXPECT_NEAR(histogram.mean(), 5000.5, 0.01);
+    EXPECT_NEAR(double(histogram.percentile(0.5)), 5000, 5000 / 16.0);
+    EXPECT_NEAR(double(histogram.percentile(0.99)), 9900, 9900 / 16.0);
+    EXPECT_LE(histogram.percentile(1.0), 10000);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    histogram.record(3);
+    histogram.record(3);
+    histogram.record(7);
+
+    EXPECT_EQ(histogram.percentile(0.5), 3);
+    EXPECT_EQ(histogram.percentile(1.0), 7);
+}
+
+TEST(LatencyHistogramTest, ClampsHugeValues) {
+    LatencyHistogram histogram;
+    histogram.record(std::numeric_limits<uint64_t>::max() / 2);
+    EXPECT_EQ(histogram.count(), 1);
+    EXPECT_GT(histogram.percentile(0.5), 0);
+}
+
+// Validator tests
+class UpdateValidatorTest : public ::testing::Test {
+protected:
+    UpdateValidator validator{5 * SECOND};
+};
+
+TEST_F(UpdateValidatorTest, AcceptsCleanUpdates) {
+    EXPECT_EQ(validator.check(makeUpdate(0, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(1, Side::Ask, 100.5), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(2, Side::Trade, 100.2), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().checked, 3);
+    EXPECT_EQ(validator.stats().rejected(), 0);
+}
+
+TEST_F(UpdateValidatorTest, RejectsBadValues) {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(validator.check(makeUpdate(0, Side::Bid, nan), NOW), Rejection::BadValue);
+    EXPECT_EQ(validator.check(makeUpdate(1, Side::Bid, -1.0), NOW), Rejection::BadValue);
+    EXPECT_EQ(validator.check(makeUpdate(2, Side::Bid, 0.0), NOW), Rejection::BadValue);
+    EXPECT_EQ(validator.check(makeUpdate(3, Side::Bid, 100.0, -1.0), NOW), Rejection::BadValue);
+    EXPECT_EQ(validator.check(makeUpdate(4, Side::Bid, 100.0, nan), NOW), Rejection::BadValue);
+    EXPECT_EQ(validator.check(makeUpdate(5, Side::Bid, 100.0, 0.0), NOW), Rejection::None);  // deletion
+    EXPECT_EQ(validator.stats().bad_value, 5);
+}
+
+TEST_F(UpdateValidatorTest, RejectsStaleUpdates) {
+    EXPECT_EQ(validator.check(makeUpdate(0, Side::Bid, 100.0, 1.0, NOW - 6 * SECOND), NOW), Rejection::Stale);
+    EXPECT_EQ(validator.check(makeUpdate(1, Side::Bid, 100.0, 1.0, NOW - 4 * SECOND), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(2, Side::Bid, 100.0, 1.0, NOW + SECOND), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().stale, 1);
+}
+
+TEST_F(UpdateValidatorTest, CountsCrossedBook) {
+    ASSERT_EQ(validator.check(makeUpdate(0, Side::Bid, 100.0), NOW), Rejection::None);
+    ASSERT_EQ(validator.check(makeUpdate(1, Side::Ask, 101.0), NOW), Rejection::None);
+
+    EXPECT_EQ(validator.check(makeUpdate(2, Side::Bid, 101.0), NOW), Rejection::None);  // crossed
+    EXPECT_EQ(validator.check(makeUpdate(3, Side::Ask, 102.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(4, Side::Ask, 100.5), NOW), Rejection::None);  // crossed
+    EXPECT_EQ(validator.check(makeUpdate(5, Side::Bid, 100.0), NOW), Rejection::None);
+
+    // Other symbols have their own book
+    EXPECT_EQ(validator.check(makeUpdate(6, Side::Bid, 150.0, 1.0, NOW, 1), NOW), Rejection::None);
+
+    // Deleting the top ask forgets it
+    EXPECT_EQ(validator.check(makeUpdate(7, Side::Ask, 100.5, 0.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(8, Side::Bid, 102.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().crossed, 2);
+    EXPECT_EQ(validator.stats().rejected(), 0);
+}
+
+TEST_F(UpdateValidatorTest, BidLiftsThroughStaleAsk) {
+    ASSERT_EQ(validator.check(makeUpdate(0, Side::Ask, 101.0), NOW), Rejection::None);
+    ASSERT_EQ(validator.check(makeUpdate(1, Side::Bid, 100.0), NOW), Rejection::None);
+
+    // The 101 ask was taken out but never deleted; the bid through it is
+    // the new top, and quotes around it are checked against it
+    EXPECT_EQ(validator.check(makeUpdate(2, Side::Bid, 101.5), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(3, Side::Ask, 102.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(4, Side::Bid, 101.8), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().crossed, 1);
+
+    EXPECT_EQ(validator.check(makeUpdate(5, Side::Ask, 101.8), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().crossed, 2);
+}
+
+TEST_F(UpdateValidatorTest, CountsGapsAndRejectsDuplicates) {
+    EXPECT_EQ(validator.check(makeUpdate(10, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(11, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(15, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(15, Side::Bid, 100.0), NOW), Rejection::Duplicate);
+    EXPECT_EQ(validator.check(makeUpdate(12, Side::Bid, 100.0), NOW), Rejection::Duplicate);
+
+    ValidationStats stats = validator.stats();
+    EXPECT_EQ(stats.gaps, 1);
+    EXPECT_EQ(stats.missed, 3);
+    EXPECT_EQ(stats.duplicate, 2);
+}
+
+TEST_F(UpdateValidatorTest, SequenceWraps) {
+    EXPECT_EQ(validator.check(makeUpdate(UINT32_MAX, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.check(makeUpdate(0, Side::Bid, 100.0), NOW), Rejection::None);
+    EXPECT_EQ(validator.stats().gaps, 0);
+}
+
+// Statistics tests
+TEST(SymbolStatsTest, VwapAndTradeRate) {
+    SymbolStats stats;
+    stats.onTrade(100.0, 1.0, NOW);
+    stats.onTrade(110.0, 3.0, NOW + SECOND / 2);
+    stats.onTrade(120.0, 0.0, NOW + SECOND);
+
+    EXPECT_DOUBLE_EQ(stats.vwap(), (100.0 + 330.0) / 4.0);
+    EXPECT_DOUBLE_EQ(stats.tradeRate(), 2.0);  // two intervals in one second
+    EXPECT_EQ(stats.trades(), 3);
+}
+
+TEST(SymbolStatsTest, VwapWindowForgetsOldTrades) {
+    SymbolStats stats;
+    for (size_t i = 0; i < SymbolStats::TRADE_WINDOW; ++i) stats.onTrade(50.0, 1.0, NOW + i);
+    for (size_t i = 0; i < SymbolStats::TRADE_WINDOW; ++i) stats.onTrade(200.0, 2.0, NOW + 1000 + i * 1000);
+
+    EXPECT_DOUBLE_EQ(stats.vwap(), 200.0);
+    EXPECT_NEAR(stats.tradeRate(), 1e6, 1.0);  // one per us
+}
+
+TEST(SymbolStatsTest, EwmaMidFollowsQuotes) {
+    SymbolStats stats(0.5);
+    stats.onBid(99.0);
+    EXPECT_EQ(stats.mid(), 0.0);  // no ask yet
+
+    stats.onAsk(101.0);
+    EXPECT_DOUBLE_EQ(stats.mid(), 100.0);
+    EXPECT_DOUBLE_EQ(stats.ewmaMid(), 100.0);
+
+    stats.onBid(101.0);
+    stats.onAsk(103.0);  // mids 101, then 102
+    EXPECT_DOUBLE_EQ(stats.mid(), 102.0);
+    EXPECT_DOUBLE_EQ(stats.ewmaMid(), 0.5 * 102.0 + 0.5 * (0.5 * 101.0 + 0.5 * 100.0));
+}
+
+TEST(SymbolStatsTest, VolatilityOfMidReturns) {
+    SymbolStats stats;
+    stats.onAsk(101.0);
+    for (int i = 0; i < 1000; ++i) stats.onBid(i % 2 ? 99.0 : 97.0);  // mid flips 100 <-> 99
+
+    double r = std::log(100.0 / 99.0);
+    // Returns alternate +r, -r: sample stddev over a full window
+    double n = SymbolStats::RETURN_WINDOW;
+    EXPECT_NEAR(stats.volatility(), r * std::sqrt(n / (n - 1)), 1e-9);
+
+    SymbolStats flat;
+    flat.onAsk(101.0);
+    for (int i = 0; i < 10; ++i) flat.onBid(99.0);
+    EXPECT_EQ(flat.volatility(), 0.0);
+}
+
+TEST(RollingWindowTest, MatchesDirectComputation) {
+    RollingWindow<8> window;
+    for (int i = 0; i < 1003; ++i) window.push(i * 0.1);
+
+    // Last eight values: 99.5 .. 100.2
+    double mean = 0;
+    for (int i = 995; i < 1003; ++i) mean += i * 0.1 / 8;
+    EXPECT_EQ(window.count(), 8);
+    EXPECT_NEAR(window.mean(), mean, 1e-9);
+    EXPECT_NEAR(window.stddev(), std::sqrt(0.01 * 6.0), 1e-9);  // 0.1 * stddev of 8 consecutive ints
+}
+
+// Pipeline tests
+class MarketPipelineTest : public ::testing::Test {
+protected:
+    SymbolRegistry symbols;
+    uint32_t btc = symbols.intern("BTCUSDT", 2, 5);
+
+    PackedMarketUpdate packed(uint32_t sequence, Side side, double price, double quantity = 1.0) {
+        MarketUpdate update(nowNanos(), price, quantity, "BTCUSDT", static_cast<char>(side));
+        return pack(update, btc, symbols.info(btc), sequence);
+    }
+
+    static uint64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+};
+
+TEST_F(MarketPipelineTest, StagesValidateAndSummarize) {
+    MarketPipeline pipeline(symbols);
+    pipeline.start();
+
+    uint32_t sequence = 0;
+    for (int i = 0; i < 1000; ++i) {
+        pipeline.decode(packed(sequence++, Side::Bid, 100.0 + (i % 5) * 0.01));
+        pipeline.decode(packed(sequence++, Side::Ask, 100.1 + (i % 5) * 0.01));
+        pipeline.decode(packed(sequence++, Side::Trade, 100.05, 0.5));
+    }
+    pipeline.decode(packed(sequence++, Side::Bid, 0.0));  // bad value
+    sequence += 2;                                        // lost
+    pipeline.decode(packed(sequence++, Side::Bid, 100.0));
+    pipeline.stop();
+
+    ValidationStats checks = pipeline.validation();
+    EXPECT_EQ(checks.checked, 3002);
+    EXPECT_EQ(checks.bad_value, 1);
+    EXPECT_EQ(checks.gaps, 1);
+    EXPECT_EQ(checks.missed, 2);
+    EXPECT_EQ(pipeline.processed(), 3001);
+
+    ASSERT_GT(pipeline.stats().size(), btc);
+    const SymbolStats& stats = pipeline.stats()[btc];
+    EXPECT_EQ(stats.trades(), 1000);
+    EXPECT_NEAR(stats.vwap(), 100.05, 1e-9);
+    EXPECT_NEAR(stats.ewmaMid(), 100.07, 0.05);
+    EXPECT_GT(stats.volatility(), 0.0);
+
+    EXPECT_EQ(pipeline.latency(PipelineStage::Decode).count(), 3002);
+    EXPECT_EQ(pipeline.latency(PipelineStage::Validate).count(), 3002);
+    EXPECT_EQ(pipeline.latency(PipelineStage::Stats).count(), 3001);
+}
+
+TEST_F(MarketPipelineTest, RunsBehindProcessor) {
+    MarketDataProcessor processor;
+    MarketPipeline pipeline(processor.symbols());
+    pipeline.attach(processor);
+
+    pipeline.start();
+    processor.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    processor.stop();
+    pipeline.stop();
+
+    EXPECT_GT(pipeline.processed(), 0);
+    EXPECT_EQ(pipeline.validation().rejected(), 0);
+    EXPECT_EQ(pipeline.validation().gaps, 0);
+    EXPECT_EQ(pipeline.latency(PipelineStage::Decode).count(), pipeline.validation().checked);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mpmc_queue.hpp"
+
+template<typename Queue>
+class SequencedQueueTest : public ::testing::Test {
+protected:
+    Queue queue;
+};
+
+using QueueTypes = ::testing::Types<MpmcQueue<int, 16>, MpscQueue<int, 16>>;
+TYPED_TEST_SUITE(SequencedQueueTest, QueueTypes);
+
+// Basic functionality tests
+TYPED_TEST(SequencedQueueTest, PushAndPop) {
+    int value;
+    EXPECT_TRUE(this->queue.push(42));
+    EXPECT_TRUE(this->queue.pop(value));
+    EXPECT_EQ(value, 42);
+}
+
+TYPED_TEST(SequencedQueueTest, EmptyQueue) {
+    int value;
+    EXPECT_FALSE(this->queue.pop(value));
+}
+
+TYPED_TEST(SequencedQueueTest, FullQueue) {
+    for (size_t i = 0; i < this->queue.capacity(); ++i) {
+        EXPECT_TRUE(this->queue.push(i));
+    }
+    EXPECT_FALSE(this->queue.push(100));
+    EXPECT_EQ(this->queue.size(), this->queue.capacity());
+}
+
+TYPED_TEST(SequencedQueueTest, FifoAcrossLaps) {
+    int value;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(this->queue.push(i));
+        ASSERT_TRUE(this->queue.push(-i));
+        ASSERT_TRUE(this->queue.pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(this->queue.pop(value));
+        EXPECT_EQ(value, -i);
+    }
+    EXPECT_EQ(this->queue.size(), 0);
+}
+
+// Multi-threaded tests
+
+// Producer p pushes (p << 32) | i for i in [0, perProducer). Checks every
+// item is popped exactly once and that each consumer sees any one
+// producer's items in the order they were pushed.
+template<typename Queue>
+static void stress(int producers, int consumers, uint32_t perProducer) {
+    auto queue = std::make_unique<Queue>();
+    const uint64_t total = uint64_t(producers) * perProducer;
+
+    std::vector<std::atomic<uint8_t>> seen(total);
+    std::atomic<uint64_t> popped{0};
+    std::atomic<bool> ordered{true};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint32_t i = 0; i < perProducer; ++i) {
+                while (!queue->push((uint64_t(p) << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<int64_t> last(producers, -1);
+            uint64_t item;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                if (!queue->pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                uint32_t p = item >> 32, i = uint32_t(item);
+                if (int64_t(i) <= last[p]) ordered = false;
+                last[p] = i;
+
+                seen[uint64_t(p) * perProducer + i].fetch_add(1, std::memory_order_relaxed);
+                popped.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(popped.load(), total);
+    EXPECT_TRUE(ordered.load());
+
+    uint64_t wrong = 0;
+    for (auto& count : seen) {
+        wrong += count.load() != 1;
+    }
+    EXPECT_EQ(wrong, 0);  // nothing lost, nothing duplicated
+}
+
+TEST(MpmcQueueTest, StressManyProducersManyConsumers) {
+    stress<MpmcQueue<uint64_t, 64>>(4, 4, 50000);
+}
+
+TEST(MpmcQueueTest, StressSingleConsumer) {
+    stress<MpmcQueue<uint64_t, 64>>(8, 1, 20000);
+}
+
+TEST(MpscQueueTest, StressFanIn) {
+    stress<MpscQueue<uint64_t, 64>>(4, 1, 50000);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "protocol.hpp"
+
+static MessageHeader header(uint32_t sequence, Side side = Side::Bid) {
+    MessageHeader h{};
+    h.side = side;
+    h.sequence = sequence;
+    h.symbol_id = 7;
+    h.timestamp = 1'700'000'000'123'456'789ULL;
+    return h;
+}
+
+// Checksum tests
+TEST(Crc32cTest, MatchesKnownVector) {
+    const char* check = "123456789";
+    EXPECT_EQ(crc32cTable(check, 9), 0xE3069283u);
+    EXPECT_EQ(crc32c(check, 9), 0xE3069283u);
+    EXPECT_EQ(crc32c("", 0), 0u);
+}
+
+TEST(Crc32cTest, HardwareMatchesTable) {
+    std::vector<char> bytes(1000);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = char(i * 131 + 7);
+
+    // Every length, so every tail after the 8-byte words is covered
+    for (size_t size = 0; size < 40; ++size) {
+        EXPECT_EQ(crc32c(bytes.data() + 3, size), crc32cTable(bytes.data() + 3, size)) << size;
+    }
+    EXPECT_EQ(crc32c(bytes.data() + 100, 500, crc32c(bytes.data(), 100)), crc32cTable(bytes.data(), 600));
+}
+
+// Round trip tests
+TEST(ProtocolTest, RoundTripsEveryType) {
+    char buffer[MAX_MESSAGE_SIZE * 4];
+    size_t used = 0;
+    used += encode(AddMessage{header(1), 42, 6700001, 250000}, buffer + used);
+    used += encode(ModifyMessage{header(2), 42, 6700002, 125000}, buffer + used);
+    used += encode(TradeMessage{header(3, Side::Ask), 42, 6700002, 5000}, buffer + used);
+    used += encode(DeleteMessage{header(4), 42}, buffer + used);
+    EXPECT_EQ(used, 48 + 48 + 48 + 32);
+
+    // Back to back, as a stream carries them
+    AnyMessage message;
+    size_t offset = 0;
+    ASSERT_EQ(decode(buffer + offset, used - offset, message), DecodeError::None);
+    EXPECT_EQ(message.header.type, MessageType::Add);
+    EXPECT_EQ(message.add.order_id, 42);
+    EXPECT_EQ(message.add.price, 6700001);
+    EXPECT_EQ(message.add.quantity, 250000);
+    EXPECT_EQ(message.header.sequence, 1);
+    EXPECT_EQ(message.header.symbol_id, 7);
+    EXPECT_EQ(message.header.timestamp, 1'700'000'000'123'456'789ULL);
+    EXPECT_EQ(message.header.side, Side::Bid);
+    offset += message.header.length;
+
+    ASSERT_EQ(decode(buffer + offset, used - offset, message), DecodeError::None);
+    EXPECT_EQ(message.header.type, MessageType::Modify);
+    EXPECT_EQ(message.modify.price, 6700002);
+    EXPECT_EQ(message.modify.quantity, 125000);
+    offset += message.header.length;
+
+    ASSERT_EQ(decode(buffer + offset, used - offset, message), DecodeError::None);
+    EXPECT_EQ(message.header.type, MessageType::Trade);
+    EXPECT_EQ(message.header.side, Side::Ask);
+    EXPECT_EQ(message.trade.quantity, 5000);
+    offset += message.header.length;
+
+    ASSERT_EQ(decode(buffer + offset, used - offset, message), DecodeError::None);
+    EXPECT_EQ(message.header.type, MessageType::Delete);
+    EXPECT_EQ(message.remove.order_id, 42);
+    EXPECT_EQ(message.header.sequence, 4);
+    offset += message.header.length;
+    EXPECT_EQ(offset, used);
+}
+
+TEST(ProtocolTest, WireIsLittleEndian) {
+    char buffer[MAX_MESSAGE_SIZE];
+    AddMessage add{header(0x01020304), 0x1122334455667788, -2, 3};
+    encode(add, buffer);
+
+    EXPECT_EQ(uint8_t(buffer[4]), 48);  // length
+    EXPECT_EQ(uint8_t(buffer[5]), 0);
+    EXPECT_EQ(uint8_t(buffer[6]), uint8_t(MessageType::Add));
+    EXPECT_EQ(buffer[7], 'B');
+    EXPECT_EQ(uint8_t(buffer[8]), 0x04);  // sequence
+    EXPECT_EQ(uint8_t(buffer[11]), 0x01);
+    EXPECT_EQ(uint8_t(buffer[24]), 0x88);  // order_id
+    EXPECT_EQ(uint8_t(buffer[31]), 0x11);
+    EXPECT_EQ(uint8_t(buffer[32]), 0xFE);  // price -2
+    EXPECT_EQ(uint8_t(buffer[39]), 0xFF);
+
+    uint32_t crc = uint8_t(buffer[0]) | uint8_t(buffer[1]) << 8 | uint8_t(buffer[2]) << 16 | uint32_t(uint8_t(buffer[3])) << 24;
+    EXPECT_EQ(crc, crc32cTable(buffer + 4, 44));
+}
+
+TEST(ProtocolTest, PeeksLengthOnceHeaderIsIn) {
+    char buffer[MAX_MESSAGE_SIZE];
+    encode(DeleteMessage{header(1), 9}, buffer);
+    EXPECT_EQ(peekLength(buffer, sizeof(MessageHeader) - 1), 0);
+    EXPECT_EQ(peekLength(buffer, sizeof(MessageHeader)), sizeof(DeleteMessage));
+}
+
+// Corruption tests
+TEST(ProtocolTest, EveryFlippedBitIsCaught) {
+    char buffer[MAX_MESSAGE_SIZE];
+    size_t size = encode(TradeMessage{header(5), 1, 2, 3}, buffer);
+
+    AnyMessage message;
+    for (size_t bit = 0; bit < size * 8; ++bit) {
+        char corrupt[MAX_MESSAGE_SIZE];
+        std::memcpy(corrupt, buffer, size);
+        corrupt[bit / 8] ^= char(1 << (bit % 8));
+        EXPECT_NE(decode(corrupt, size, message), DecodeError::None) << "bit " << bit;
+    }
+}
+
+TEST(ProtocolTest, ReportsWhatIsWrong) {
+    char buffer[MAX_MESSAGE_SIZE];
+    size_t size = encode(AddMessage{header(1), 1, 2, 3}, buffer);
+    AnyMessage message;
+
+    EXPECT_EQ(decode(buffer, sizeof(MessageHeader) - 1, message), DecodeError::Truncated);
+    EXPECT_EQ(decode(buffer, size - 1, message), DecodeError::Truncated);
+
+    char corrupt[MAX_MESSAGE_SIZE];
+    std::memcpy(corrupt, buffer, size);
+    corrupt[6] = 9;  // type
+    EXPECT_EQ(decode(corrupt, size, message), DecodeError::UnknownType);
+    corrupt[6] = 0;
+    EXPECT_EQ(decode(corrupt, size, message), DecodeError::UnknownType);
+
+    std::memcpy(corrupt, buffer, size);
+    corrupt[6] = char(MessageType::Delete);  // a 48-byte Delete
+    EXPECT_EQ(decode(corrupt, size, message), DecodeError::BadLength);
+
+    std::memcpy(corrupt, buffer, size);
+    corrupt[40] ^= 1;  // quantity
+    EXPECT_EQ(decode(corrupt, size, message), DecodeError::BadChecksum);
+
+    EXPECT_EQ(decode(buffer, size, message), DecodeError::None);
+}
@@ -2,6 +2,7 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <span>
 #include "ring_buffer.hpp"
 
 class RingBufferTest : public ::testing::Test {
@@ -42,6 +43,109 @@ TEST_F(RingBufferTest, SizeTracking) {
     EXPECT_EQ(buffer.size(), 1);
 }
 
+TEST_F(RingBufferTest, WrapsAround) {
+    int value;
+    for (size_t i = 0; i < 10 * BUFFER_SIZE; ++i) {
+        int n = static_cast<int>(i);
+        ASSERT_TRUE(buffer.push(n));
+        ASSERT_TRUE(buffer.push(n + 1));
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, n);
+        ASSERT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, n + 1);
+    }
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST_F(RingBufferTest, CountersFollowIndices) {
+    int value;
+    for (size_t i = 0; i < BUFFER_SIZE - 1; ++i) {
+        buffer.push(static_cast<int>(i));
+    }
+    EXPECT_FALSE(buffer.push(100));  // rejected pushes are not counted
+    EXPECT_EQ(buffer.pushCount(), BUFFER_SIZE - 1);
+    EXPECT_EQ(buffer.size(), buffer.capacity());
+
+    buffer.pop(value);
+    EXPECT_TRUE(buffer.push(100));
+    EXPECT_EQ(buffer.pushCount(), BUFFER_SIZE);
+    EXPECT_EQ(buffer.popCount(), 1);
+    EXPECT_EQ(buffer.size(), BUFFER_SIZE - 1);
+}
+
+// Batch and in-place API tests
+TEST_F(RingBufferTest, BulkPushAndPop) {
+    std::vector<int> in = {1, 2, 3, 4, 5};
+    EXPECT_EQ(buffer.push_bulk(in), 5);
+    EXPECT_EQ(buffer.size(), 5);
+
+    std::vector<int> out(8);
+    EXPECT_EQ(buffer.pop_bulk(out), 5);
+    EXPECT_EQ(std::vector<int>(out.begin(), out.begin() + 5), in);
+    EXPECT_EQ(buffer.pop_bulk(out), 0);
+}
+
+TEST_F(RingBufferTest, BulkStopsWhenFull) {
+    std::vector<int> in(2 * BUFFER_SIZE, 7);
+    EXPECT_EQ(buffer.push_bulk(in), buffer.capacity());
+    EXPECT_EQ(buffer.push_bulk(in), 0);
+
+    int value;
+    buffer.pop(value);
+    EXPECT_EQ(buffer.push_bulk(in), 1);
+}
+
+TEST_F(RingBufferTest, BulkWrapsAround) {
+    std::vector<int> in(BUFFER_SIZE / 2 + 3), out(in.size());
+    int next = 0;
+
+    for (int round = 0; round < 10; ++round) {
+        for (int& v : in) v = next++;
+        ASSERT_EQ(buffer.push_bulk(in), in.size());
+        ASSERT_EQ(buffer.pop_bulk(out), out.size());
+        EXPECT_EQ(out, in);
+    }
+}
+
+TEST_F(RingBufferTest, ClaimIsInvisibleUntilCommit) {
+    int value;
+    *buffer.claim() = 1;
+    *buffer.claim() = 2;
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_EQ(buffer.size(), 0);
+
+    buffer.commit();
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST_F(RingBufferTest, ClaimFailsWhenFull) {
+    for (size_t i = 0; i < buffer.capacity(); ++i) {
+        ASSERT_NE(buffer.claim(), nullptr);
+    }
+    EXPECT_EQ(buffer.claim(), nullptr);
+    buffer.commit();
+    EXPECT_FALSE(buffer.push(1));
+}
+
+TEST_F(RingBufferTest, PeekHoldsSlotsUntilRelease) {
+    for (int i = 0; i < 3; ++i) buffer.push(i);
+
+    const int* a = buffer.peek();
+    const int* b = buffer.peek();
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(*a, 0);
+    EXPECT_EQ(*b, 1);
+    EXPECT_EQ(buffer.size(), 3);  // not freed yet
+
+    buffer.release();
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_EQ(*buffer.peek(), 2);
+    EXPECT_EQ(buffer.peek(), nullptr);
+}
+
 // Multi-threaded tests
 TEST_F(RingBufferTest, MultiThreadedPushPop) {
     static constexpr int NUM_OPERATIONS = 10000;
@@ -80,6 +184,54 @@ TEST_F(RingBufferTest, MultiThreadedPushPop) {
     EXPECT_EQ(consumer_count.load(), NUM_OPERATIONS);
 }
 
+TEST_F(RingBufferTest, MultiThreadedBatches) {
+    static constexpr int NUM_OPERATIONS = 100000;
+
+    std::thread producer([&]() {
+        int next = 0;
+        std::vector<int> batch(5);
+        while (next < NUM_OPERATIONS) {
+            if (next % 2) {
+                // in place, published per batch
+                for (int i = 0; i < 3 && next < NUM_OPERATIONS; ++i) {
+                    int* slot;
+                    while (!(slot = buffer.claim())) {
+                        buffer.commit();
+                        std::this_thread::yield();
+                    }
+                    *slot = next++;
+                }
+                buffer.commit();
+            } else {
+                size_t count = std::min<size_t>(batch.size(), NUM_OPERATIONS - next);
+                for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+                std::span<const int> pending(batch.data(), count);
+                while (!pending.empty()) {
+                    pending = pending.subspan(buffer.push_bulk(pending));
+                    std::this_thread::yield();
+                }
+                next += count;
+            }
+        }
+    });
+
+    int expected = 0;
+    std::vector<int> out(7);
+    while (expected < NUM_OPERATIONS) {
+        if (expected % 3) {
+            size_t count = buffer.pop_bulk(out);
+            for (size_t i = 0; i < count; ++i) ASSERT_EQ(out[i], expected++);
+        } else {
+            while (const int* value = buffer.peek()) ASSERT_EQ(*value, expected++);
+            buffer.release();
+        }
+        std::this_thread::yield();
+    }
+
+    producer.join();
+    EXPECT_EQ(buffer.size(), 0);
+}
+
 // Performance test
 TEST_F(RingBufferTest, LatencyMeasurement) {
     static constexpr int NUM_SAMPLES = 10000;
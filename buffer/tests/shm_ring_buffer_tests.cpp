@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "market_data.hpp"
+#include "shm_ring_buffer.hpp"
+
+class ShmRingBufferTest : public ::testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 1024;
+    using Ring = ShmRingBuffer<MarketUpdate, BUFFER_SIZE>;
+
+    std::string name = "/md_ring_test_" + std::to_string(getpid());
+
+    void TearDown() override {
+        Ring::remove(name);
+    }
+};
+
+static MarketUpdate makeUpdate(uint64_t sequence) {
+    std::string symbol("BTCUSDT");
+    return MarketUpdate(sequence, 100.0 + sequence, 1.0, symbol, 'B');
+}
+
+// Runs body in a child process, returns its exit status
+template<typename F>
+static pid_t spawn(F&& body) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        int status = 1;
+        try {
+            status = body();
+        } catch (...) {}
+        _exit(status);
+    }
+    return pid;
+}
+
+static int exitStatus(pid_t pid) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Basic functionality tests
+TEST_F(ShmRingBufferTest, CreateAttachPushPop) {
+    Ring producer = Ring::create(name);
+    Ring consumer = Ring::attach(name);
+
+    EXPECT_TRUE(producer.push(makeUpdate(1)));
+    EXPECT_EQ(consumer.size(), 1);
+
+    MarketUpdate update;
+    ASSERT_TRUE(consumer.pop(update));
+    EXPECT_EQ(update.timestamp, 1);
+    EXPECT_STREQ(update.symbol, "BTCUSDT");
+    EXPECT_FALSE(consumer.pop(update));
+}
+
+TEST_F(ShmRingBufferTest, FullBuffer) {
+    Ring ring = Ring::create(name);
+    for (size_t i = 0; i < ring.capacity(); ++i) {
+        ASSERT_TRUE(ring.push(makeUpdate(i)));
+    }
+    EXPECT_FALSE(ring.push(makeUpdate(0)));
+}
+
+TEST_F(ShmRingBufferTest, AttachMissingThrows) {
+    EXPECT_THROW(Ring::attach(name), std::runtime_error);
+}
+
+TEST_F(ShmRingBufferTest, AttachRejectsOtherLayout) {
+    Ring ring = Ring::create(name);
+    EXPECT_THROW((ShmRingBuffer<MarketUpdate, 2048>::attach(name)), std::runtime_error);
+    EXPECT_THROW((ShmRingBuffer<uint64_t, BUFFER_SIZE>::attach(name)), std::runtime_error);
+}
+
+TEST_F(ShmRingBufferTest, CreateStartsFresh) {
+    {
+        Ring ring = Ring::create(name);
+        ring.push(makeUpdate(1));
+    }
+    Ring ring = Ring::create(name);
+    EXPECT_EQ(ring.size(), 0);
+}
+
+// Multi-process tests
+TEST_F(ShmRingBufferTest, ForkedProducerAndConsumer) {
+    static constexpr uint64_t NUM_UPDATES = 1000000;
+    Ring ring = Ring::create(name);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    pid_t consumer = spawn([&] {
+        Ring ring = Ring::attach(name);
+        uint64_t expected = 0;
+        while (expected < NUM_UPDATES) {
+            const MarketUpdate* update = ring.peek();
+            if (!update) {
+                ring.release();
+                std::this_thread::yield();
+                continue;
+            }
+            if (update->timestamp != expected || update->price != 100.0 + expected) return 2;
+            expected++;
+        }
+        ring.release();
+        return 0;
+    });
+
+    pid_t producer = spawn([&] {
+        Ring ring = Ring::attach(name);
+        for (uint64_t i = 0; i < NUM_UPDATES; ++i) {
+            MarketUpdate* slot;
+            while (!(slot = ring.claim())) {
+                ring.commit();
+                std::this_thread::yield();
+            }
+            *slot = makeUpdate(i);
+            if (i % 8 == 7) ring.commit();
+        }
+        ring.commit();
+        return 0;
+    });
+
+    EXPECT_EQ(exitStatus(producer), 0);
+    EXPECT_EQ(exitStatus(consumer), 0);  // 2: out of order or corrupted
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "Cross-process throughput: " << NUM_UPDATES / seconds / 1e6 << " M updates/s\n";
+
+    EXPECT_EQ(ring.popCount(), NUM_UPDATES);
+}
+
+TEST_F(ShmRingBufferTest, ProducerCrashLosesOnlyUncommitted) {
+    Ring ring = Ring::create(name);
+
+    // Commits 10, claims 5 more and dies before committing them
+    pid_t crashed = spawn([&] {
+        Ring ring = Ring::attach(name);
+        for (uint64_t i = 0; i < 10; ++i) ring.push(makeUpdate(i));
+        for (uint64_t i = 0; i < 5; ++i) *ring.claim() = makeUpdate(999);
+        _exit(3);
+        return 0;
+    });
+    ASSERT_EQ(exitStatus(crashed), 3);
+    EXPECT_EQ(ring.size(), 10);
+
+    // Its replacement picks up where the committed data ends
+    pid_t restarted = spawn([&] {
+        Ring ring = Ring::attach(name);
+        for (uint64_t i = 10; i < 20; ++i) ring.push(makeUpdate(i));
+        return 0;
+    });
+    ASSERT_EQ(exitStatus(restarted), 0);
+
+    MarketUpdate update;
+    for (uint64_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(ring.pop(update));
+        EXPECT_EQ(update.timestamp, i);
+    }
+    EXPECT_FALSE(ring.pop(update));
+}
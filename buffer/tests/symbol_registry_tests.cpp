@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "symbol_registry.hpp"
+
+class SymbolRegistryTest : public ::testing::Test {
+protected:
+    SymbolRegistry registry;
+};
+
+// Basic functionality tests
+TEST_F(SymbolRegistryTest, InternIsIdempotent) {
+    uint32_t btc = registry.intern("BTCUSDT");
+    uint32_t eth = registry.intern("ETHUSDT");
+
+    EXPECT_NE(btc, eth);
+    EXPECT_EQ(registry.intern("BTCUSDT"), btc);
+    EXPECT_EQ(registry.size(), 2);
+}
+
+TEST_F(SymbolRegistryTest, IdsAreDense) {
+    EXPECT_EQ(registry.intern("A"), 0);
+    EXPECT_EQ(registry.intern("B"), 1);
+    EXPECT_EQ(registry.intern("C"), 2);
+}
+
+TEST_F(SymbolRegistryTest, KeepsFirstScales) {
+    uint32_t id = registry.intern("BTCUSDT", 2, 5);
+    registry.intern("BTCUSDT", 8, 8);
+
+    const SymbolInfo& info = registry.info(id);
+    EXPECT_EQ(info.name, "BTCUSDT");
+    EXPECT_EQ(info.price_decimals, 2);
+    EXPECT_DOUBLE_EQ(info.price_scale, 100.0);
+    EXPECT_DOUBLE_EQ(info.quantity_scale, 100000.0);
+}
+
+TEST_F(SymbolRegistryTest, FindAndUnknownIds) {
+    EXPECT_FALSE(registry.find("BTCUSDT").has_value());
+    uint32_t id = registry.intern("BTCUSDT");
+    EXPECT_EQ(registry.find("BTCUSDT"), id);
+    EXPECT_THROW(registry.info(id + 1), std::out_of_range);
+}
+
+// Multi-threaded tests
+TEST_F(SymbolRegistryTest, ConcurrentInternAgrees) {
+    static constexpr int NUM_THREADS = 4;
+    static constexpr int NUM_SYMBOLS = 500;
+    std::vector<std::vector<uint32_t>> ids(NUM_THREADS, std::vector<uint32_t>(NUM_SYMBOLS));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < NUM_SYMBOLS; ++i) {
+                ids[t][i] = registry.intern("SYM" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(registry.size(), NUM_SYMBOLS);
+    for (int t = 1; t < NUM_THREADS; ++t) EXPECT_EQ(ids[t], ids[0]);
+    for (int i = 0; i < NUM_SYMBOLS; ++i) EXPECT_EQ(registry.info(ids[0][i]).name, "SYM" + std::to_string(i));
+}
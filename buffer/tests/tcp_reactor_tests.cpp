@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "tcpacceptor.h"
+#include "tcpreactor.h"
+
+static const std::string REPLY(32, 'r');  // per request line, so replies outgrow requests 16x
+
+class TCPReactorTest : public ::testing::TestWithParam<TCPReactor::Engine> {
+    protected:
+        std::atomic<size_t> maxPending{0};
+        std::atomic<size_t> requests{0};
+
+        // One REPLY per line; records the most output ever left unsent
+        size_t handle(TCPReactor::Connection& connection, const char* data, size_t len) {
+            const char* newline = static_cast<const char*>(std::memchr(data, '\n', len));
+            if (!newline) return 0;
+
+            size_t pending = connection.pendingOutput();
+            if (pending > maxPending) maxPending = pending;
+            connection.send(REPLY.data(), REPLY.size());
+            requests++;
+            return newline - data + 1;
+        }
+
+        static int connectTo(int port) {
+            int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = htons(port);
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        static int portOf(TCPAcceptor& acceptor) {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            getsockname(acceptor.getDescriptor(), reinterpret_cast<sockaddr*>(&addr), &len);
+            return ntohs(addr.sin_port);
+        }
+};
+
+TEST_P(TCPReactorTest, StopsReadingClientThatDoesNotRead) {
+    TCPReactor::Engine engine = GetParam();
+    if (engine == TCPReactor::URING) std::signal(SIGPIPE, SIG_IGN);  // see tcpreactor.h
+    TCPAcceptor acceptor(0, "127.0.0.1");
+    ASSERT_EQ(acceptor.start(engine == TCPReactor::EPOLL), 0);
+
+    TCPReactor reactor(&acceptor, [this](TCPReactor::Connection& connection, const char* data, size_t len) {
+        return handle(connection, data, len);
+    }, engine);
+    std::atomic<int> result{0};
+    std::thread loop([&] { result = reactor.run(); });
+
+    int fd = connectTo(portOf(acceptor));
+    ASSERT_GE(fd, 0);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // Send request lines without reading a reply, until the server stops
+    // taking them for a while (or 64 MB went in, which it never should)
+    std::string lines;
+    for (int i = 0; i < 8192; ++i) lines += "x\n";
+    size_t sent = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (sent < (64u << 20) && std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(300)) {
+        ssize_t n = ::send(fd, lines.data() + sent % lines.size(), lines.size() - sent % lines.size(), MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+            lastProgress = std::chrono::steady_clock::now();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    if (result != 0) {
+        loop.join();
+        ::close(fd);
+        GTEST_SKIP() << "engine not available on this kernel";
+    }
+    EXPECT_LT(sent, 64u << 20) << "the server kept reading from a client that reads nothing";
+    EXPECT_LE(maxPending, TCPReactor::OUTPUT_LIMIT + REPLY.size());
+
+    // Once the client reads, every request it sent is answered
+    size_t expected = sent / 2 * REPLY.size();
+    size_t received = 0;
+    char buffer[64 * 1024];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (received < expected && std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd{fd, POLLIN, 0};
+        if (::poll(&pfd, 1, 100) <= 0) continue;
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        received += n;
+    }
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(requests, sent / 2);
+    EXPECT_LE(maxPending, TCPReactor::OUTPUT_LIMIT + REPLY.size());
+
+    ::close(fd);
+    reactor.stop();
+    loop.join();
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, TCPReactorTest, ::testing::Values(TCPReactor::EPOLL, TCPReactor::URING),
+                         [](const ::testing::TestParamInfo<TCPReactor::Engine>& info) {
+                             return std::string(info.param == TCPReactor::EPOLL ? "Epoll" : "Uring");
+                         });
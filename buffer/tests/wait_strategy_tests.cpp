@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "broadcast_ring.hpp"
+#include "ring_buffer.hpp"
+#include "wait_strategy.hpp"
+
+template<typename Wait>
+class WaitStrategyTest : public ::testing::Test {
+protected:
+    static constexpr size_t BUFFER_SIZE = 64;  // small enough that both sides wait
+    RingBuffer<int, BUFFER_SIZE, Wait> buffer;
+    std::atomic<bool> running{true};
+};
+
+using Strategies = ::testing::Types<BusySpinWait, SpinYieldWait, SpinParkWait, TimedBlockingWait>;
+TYPED_TEST_SUITE(WaitStrategyTest, Strategies);
+
+// Multi-threaded tests
+TYPED_TEST(WaitStrategyTest, BlockingPushAndPopDeliverInOrder) {
+    static constexpr int NUM_OPERATIONS = 20000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < NUM_OPERATIONS; ++i) {
+            ASSERT_TRUE(this->buffer.push_wait(i, this->running));
+        }
+    });
+
+    int value;
+    for (int i = 0; i < NUM_OPERATIONS; ++i) {
+        ASSERT_TRUE(this->buffer.pop_wait(value, this->running));
+        ASSERT_EQ(value, i);
+    }
+    producer.join();
+}
+
+TYPED_TEST(WaitStrategyTest, WakeReleasesIdleConsumer) {
+    std::atomic<bool> returned{false};
+    std::thread consumer([&] {
+        int value;
+        EXPECT_FALSE(this->buffer.pop_wait(value, this->running));
+        returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let it park
+    EXPECT_FALSE(returned);
+
+    this->running = false;
+    this->buffer.wake();
+    consumer.join();
+    EXPECT_TRUE(returned);
+}
+
+TYPED_TEST(WaitStrategyTest, WakeReleasesBlockedProducer) {
+    for (size_t i = 0; i < this->buffer.capacity(); ++i) {
+        this->buffer.push(i);
+    }
+
+    std::thread producer([&] {
+        EXPECT_FALSE(this->buffer.push_wait(100, this->running));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    this->running = false;
+    this->buffer.wake();
+    producer.join();
+}
+
+TYPED_TEST(WaitStrategyTest, PopWaitDrainsAfterStop) {
+    this->buffer.push(1);
+    this->running = false;
+
+    int value;
+    EXPECT_TRUE(this->buffer.pop_wait(value, this->running));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(this->buffer.pop_wait(value, this->running));
+}
+
+TEST(BroadcastWaitTest, ParkedConsumersFollowProducer) {
+    static constexpr int NUM_ITEMS = 50000;
+    static constexpr int NUM_CONSUMERS = 3;
+
+    auto ring = std::make_unique<BroadcastRing<int, 16, 4, SpinParkWait>>();
+    std::atomic<bool> running{true};
+
+    std::vector<int> ids;
+    for (int c = 0; c < NUM_CONSUMERS; ++c) ids.push_back(ring->subscribe());
+
+    std::vector<int> received(NUM_CONSUMERS, 0);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < NUM_CONSUMERS; ++c) {
+        consumers.emplace_back([&, c] {
+            while (received[c] < NUM_ITEMS) {
+                ring->consume_wait(ids[c], [&](const int& value) {
+                    EXPECT_EQ(value, received[c]);
+                    received[c]++;
+                }, running);
+            }
+        });
+    }
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        int* slot = ring->claim_wait(running);
+        ASSERT_NE(slot, nullptr);
+        *slot = i;
+        if (i % 5 == 4) ring->commit();  // bursts
+    }
+    ring->commit();
+
+    for (auto& consumer : consumers) consumer.join();
+    for (int count : received) EXPECT_EQ(count, NUM_ITEMS);
+}
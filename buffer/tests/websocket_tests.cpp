@@ -0,0 +1,376 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "binance_stream.hpp"
+#include "websocket.hpp"
+#include "ws_replay_server.hpp"
+
+// Recorded from wss://stream.binance.com:9443
+static const std::string DEPTH_UPDATE =
+    R"({"e":"depthUpdate","E":1718000000123,"s":"BTCUSDT","U":48113512061,"u":48113512070,)"
+    R"("b":[["67012.34000000","0.51200000"],["67012.01000000","0.00000000"]],)"
+    R"("a":[["67012.35000000","1.20000000"]]})";
+
+static const std::string BOOK_TICKER =
+    R"({"u":48113512071,"s":"ETHUSDT","b":"3521.10000000","B":"12.40000000","a":"3521.11000000","A":"3.05000000"})";
+
+static const std::string TRADE =
+    R"({"e":"trade","E":1700000000001,"s":"BTCUSDT","t":12345,"p":"67010.50","q":"0.00300","T":1700000000000,"m":true,"M":true})";
+
+static const std::string AGG_TRADE =
+    R"({"e":"aggTrade","E":1700000000002,"s":"BTCUSDT","a":777,"p":"67011.00","q":"1.25000","f":100,"l":105,"T":1700000000001,"m":false,"M":true})";
+
+static const std::string COMBINED =
+    R"({"stream":"btcusdt@depth@100ms","data":)" + DEPTH_UPDATE + "}";
+
+static uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Polls until count messages arrived or timeout, returns them
+static std::vector<std::string> receive(WebSocketClient& client, size_t count, int timeoutMs = 2000) {
+    std::vector<std::string> messages;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (messages.size() < count && std::chrono::steady_clock::now() < deadline) {
+        if (!client.poll([&](std::string_view message, uint64_t) { messages.emplace_back(message); })) break;
+    }
+    return messages;
+}
+
+class WebSocketTest : public ::testing::Test {};
+
+// Parsing tests
+TEST_F(WebSocketTest, ParsesDepthUpdate) {
+    std::vector<MarketUpdate> updates;
+    size_t count = parseBinanceMessage(DEPTH_UPDATE, 42, [&](const MarketUpdate& u) { updates.push_back(u); });
+
+    ASSERT_EQ(count, 3);
+    EXPECT_STREQ(updates[0].symbol, "BTCUSDT");
+    EXPECT_EQ(updates[0].side, 'B');
+    EXPECT_DOUBLE_EQ(updates[0].price, 67012.34);
+    EXPECT_DOUBLE_EQ(updates[0].quantity, 0.512);
+    EXPECT_DOUBLE_EQ(updates[1].quantity, 0.0);  // level removed
+    EXPECT_EQ(updates[2].side, 'A');
+    EXPECT_DOUBLE_EQ(updates[2].price, 67012.35);
+    EXPECT_EQ(updates[2].timestamp, 42);
+}
+
+TEST_F(WebSocketTest, ParsesBookTicker) {
+    std::vector<MarketUpdate> updates;
+    ASSERT_EQ(parseBinanceMessage(BOOK_TICKER, 7, [&](const MarketUpdate& u) { updates.push_back(u); }), 2);
+
+    EXPECT_STREQ(updates[0].symbol, "ETHUSDT");
+    EXPECT_EQ(updates[0].side, 'B');
+    EXPECT_DOUBLE_EQ(updates[0].price, 3521.10);
+    EXPECT_DOUBLE_EQ(updates[0].quantity, 12.4);
+    EXPECT_EQ(updates[1].side, 'A');
+    EXPECT_DOUBLE_EQ(updates[1].price, 3521.11);
+    EXPECT_DOUBLE_EQ(updates[1].quantity, 3.05);
+}
+
+TEST_F(WebSocketTest, ParsesTrades) {
+    std::vector<MarketUpdate> updates;
+    auto collect = [&](const MarketUpdate& u) { updates.push_back(u); };
+    ASSERT_EQ(parseBinanceMessage(TRADE, 9, collect), 1);
+    ASSERT_EQ(parseBinanceMessage(AGG_TRADE, 10, collect), 1);
+
+    EXPECT_STREQ(updates[0].symbol, "BTCUSDT");
+    EXPECT_EQ(updates[0].side, 'T');
+    EXPECT_DOUBLE_EQ(updates[0].price, 67010.5);
+    EXPECT_DOUBLE_EQ(updates[0].quantity, 0.003);
+    EXPECT_EQ(updates[1].side, 'T');
+    EXPECT_DOUBLE_EQ(updates[1].quantity, 1.25);
+}
+
+TEST_F(WebSocketTest, ParsesCombinedStream) {
+    size_t count = parseBinanceMessage(COMBINED, 0, [](const MarketUpdate&) {});
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(WebSocketTest, IgnoresOtherMessages) {
+    auto ignore = [](const MarketUpdate&) {};
+    EXPECT_EQ(parseBinanceMessage(R"({"result":null,"id":1})", 0, ignore), 0);
+    EXPECT_EQ(parseBinanceMessage("not json", 0, ignore), 0);
+    EXPECT_EQ(parseBinanceMessage(R"({"e":"depthUpdate","s":"BTCUSDT","b":[["1.0")", 0, ignore), 0);
+}
+
+// Protocol tests
+TEST_F(WebSocketTest, HandshakeAndText) {
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        session.sendText(DEPTH_UPDATE);
+        session.sendText(BOOK_TICKER);
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    auto messages = receive(client, 2);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], DEPTH_UPDATE);
+    EXPECT_EQ(messages[1], BOOK_TICKER);
+}
+
+TEST_F(WebSocketTest, ReassemblesFragments) {
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        session.send(0x1, DEPTH_UPDATE.substr(0, 10), false);
+        session.send(0x9, "mid-message ping");  // control frames may interleave
+        session.send(0x0, DEPTH_UPDATE.substr(10, 20), false);
+        session.send(0x0, DEPTH_UPDATE.substr(30), true);
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    auto messages = receive(client, 1);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0], DEPTH_UPDATE);
+    EXPECT_EQ(client.pingsAnswered(), 1);
+}
+
+TEST_F(WebSocketTest, ExtendedLengths) {
+    std::string medium(300, 'm');      // 16-bit length
+    std::string large(100000, 'L');    // 64-bit length
+
+    WsReplayServer server([&](WsReplayServer::Session& session) {
+        session.sendText(medium);
+        session.sendText(large);
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    auto messages = receive(client, 2);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], medium);
+    EXPECT_EQ(messages[1], large);
+}
+
+TEST_F(WebSocketTest, FramesSplitAcrossReads) {
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        std::string bytes = WsReplayServer::Session::frame(0x1, BOOK_TICKER);
+        for (char c : bytes) {
+            session.sendRaw(std::string(1, c));
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    auto messages = receive(client, 1);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0], BOOK_TICKER);
+}
+
+TEST_F(WebSocketTest, AnswersPingWithMaskedPong) {
+    std::atomic<bool> gotPong{false};
+    std::atomic<bool> masked{false};
+
+    WsReplayServer server([&](WsReplayServer::Session& session) {
+        session.send(0x9, "heartbeat");
+
+        uint8_t opcode;
+        std::string payload;
+        while (session.read(opcode, payload)) {
+            if (opcode == 0xA) {
+                gotPong = payload == "heartbeat";
+                masked = session.clientMasked;
+                return;
+            }
+        }
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    for (int i = 0; i < 20 && !gotPong; ++i) {
+        client.poll([](std::string_view, uint64_t) {});
+    }
+
+    EXPECT_TRUE(gotPong);
+    EXPECT_TRUE(masked);
+    EXPECT_EQ(client.pingsAnswered(), 1);
+}
+
+TEST_F(WebSocketTest, EchoesClientText) {
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        uint8_t opcode;
+        std::string payload;
+        while (session.read(opcode, payload)) {
+            if (opcode == 0x1) session.sendText(payload);
+        }
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    std::string big(70000, 'x');
+    ASSERT_TRUE(client.sendText("hello"));
+    ASSERT_TRUE(client.sendText(big));
+
+    auto messages = receive(client, 2);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], "hello");
+    EXPECT_EQ(messages[1], big);
+}
+
+TEST_F(WebSocketTest, CloseEndsConnection) {
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        session.send(0x8, std::string("\x03\xe8", 2));
+    });
+
+    WebSocketClient client(server.url());
+    ASSERT_TRUE(client.connect());
+
+    receive(client, 1, 500);
+    EXPECT_FALSE(client.isConnected());
+}
+
+TEST_F(WebSocketTest, ConnectFailure) {
+    WebSocketClient client("ws://127.0.0.1:1/ws");  // nothing listens there
+    EXPECT_FALSE(client.connect());
+}
+
+TEST_F(WebSocketTest, ReconnectsAndResubscribes) {
+    std::atomic<int> subscriptions{0};
+
+    // First connection is dropped right after the subscription, the
+    // second one serves data
+    WsReplayServer server([&](WsReplayServer::Session& session) {
+        uint8_t opcode;
+        std::string payload;
+        if (!session.read(opcode, payload)) return;
+        if (payload.find("SUBSCRIBE") != std::string::npos) subscriptions++;
+
+        if (subscriptions == 1) {
+            session.drop();
+            return;
+        }
+        session.sendText(BOOK_TICKER);
+        while (session.read(opcode, payload)) {}
+    });
+
+    WebSocketClient client(server.url());
+    client.addSubscription(R"({"method":"SUBSCRIBE","params":["ethusdt@bookTicker"],"id":1})");
+
+    std::atomic<bool> running{true};
+    std::atomic<int> received{0};
+    std::thread reader([&] {
+        client.run([&](std::string_view, uint64_t) {
+            if (++received == 1) running = false;
+        }, running);
+    });
+
+    for (int i = 0; i < 200 && running; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    running = false;
+    reader.join();
+
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(subscriptions, 2);
+    EXPECT_EQ(server.connections(), 2);
+    EXPECT_GE(client.reconnects(), 1);
+}
+
+TEST_F(WebSocketTest, ReconnectsWhenPeerClosesAfterPing) {
+    // First connection pings, sends a close and closes its socket. The
+    // client's pong draws a reset and its close echo then writes into a
+    // reset socket, which must fail the connection rather than raise
+    // SIGPIPE
+    WsReplayServer server([&](WsReplayServer::Session& session) {
+        if (server.connections() == 1) {
+            session.sendRaw(WsReplayServer::Session::frame(0x9, "heartbeat") +
+                            WsReplayServer::Session::frame(0x8, std::string("\x03\xe8", 2)));
+            session.close();
+            return;
+        }
+        session.sendText(BOOK_TICKER);
+        uint8_t opcode;
+        std::string payload;
+        while (session.read(opcode, payload)) {}
+    });
+
+    WebSocketClient client(server.url());
+    std::atomic<bool> running{true};
+    std::atomic<int> received{0};
+    std::thread reader([&] {
+        client.run([&](std::string_view, uint64_t) {
+            if (++received == 1) running = false;
+        }, running);
+    });
+
+    for (int i = 0; i < 200 && running; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    running = false;
+    reader.join();
+
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(server.connections(), 2);
+    EXPECT_GE(client.reconnects(), 1);
+}
+
+// Performance test
+TEST_F(WebSocketTest, FrameToPopLatency) {
+    static constexpr int NUM_FRAMES = 20000;
+    static constexpr size_t LEVELS_PER_FRAME = 3;
+
+    WsReplayServer server([](WsReplayServer::Session& session) {
+        // Replay in bursts, as a venue flushes a 100ms depth batch
+        std::string burst;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            burst += WsReplayServer::Session::frame(0x1, DEPTH_UPDATE);
+            if (burst.size() > 16 * 1024 || i == NUM_FRAMES - 1) {
+                session.sendRaw(burst);
+                burst.clear();
+            }
+        }
+        uint8_t opcode;
+        std::string payload;
+        while (session.read(opcode, payload)) {}
+    });
+
+    RingBuffer<MarketUpdate, 4096> ring;
+    std::atomic<bool> running{true};
+
+    WebSocketClient client(server.url());
+    std::thread producer([&] {
+        client.run([&](std::string_view message, uint64_t arrival) {
+            pushBinanceMessage(ring, message, arrival);
+        }, running);
+    });
+
+    std::vector<double> latencies;
+    latencies.reserve(NUM_FRAMES * LEVELS_PER_FRAME);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    MarketUpdate update;
+    while (latencies.size() < NUM_FRAMES * LEVELS_PER_FRAME && std::chrono::steady_clock::now() < deadline) {
+        if (ring.pop(update)) {
+            latencies.push_back(static_cast<double>(nowNanos() - update.timestamp));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    running = false;
+    producer.join();
+
+    ASSERT_EQ(latencies.size(), NUM_FRAMES * LEVELS_PER_FRAME);
+
+    std::sort(latencies.begin(), latencies.end());
+    double p50 = latencies[latencies.size() / 2];
+    double p99 = latencies[static_cast<size_t>(latencies.size() * 0.99)];
+
+    std::cout << "Frame arrival -> pop p50: " << p50 / 1000 << " us\n";
+    std::cout << "Frame arrival -> pop p99: " << p99 / 1000 << " us\n";
+
+    EXPECT_LT(p99, 10e6);  // bursts queue behind the consumer, but never for 10ms
+}
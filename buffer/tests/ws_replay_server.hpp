@@ -0,0 +1,231 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+/**
+    WebSocket server on 127.0.0.1 for testing WebSocketClient without
+    network access. Every accepted connection is upgraded and handed to
+    the session callback, which replays recorded frames, echoes, pings or
+    drops the connection as the test needs.
+*/
+class WsReplayServer {
+    public:
+        class Session {
+            private:
+                int fd_;
+                std::string pending_;
+
+                bool readBytes(size_t n) {
+                    char buf[4096];
+                    while (pending_.size() < n) {
+                        ssize_t len = ::recv(fd_, buf, sizeof(buf), 0);
+                        if (len <= 0) return false;
+                        pending_.append(buf, len);
+                    }
+                    return true;
+                }
+
+            public:
+                bool clientMasked = true;  // every client frame so far was masked
+
+                explicit Session(int fd, std::string leftover) : fd_(fd), pending_(std::move(leftover)) {}
+
+                void sendRaw(const std::string& bytes) {
+                    ::send(fd_, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+                }
+
+                static std::string frame(uint8_t opcode, const std::string& payload, bool fin = true) {
+                    std::string out;
+                    out += static_cast<char>((fin ? 0x80 : 0) | opcode);
+
+                    if (payload.size() < 126) {
+                        out += static_cast<char>(payload.size());
+                    } else if (payload.size() <= 0xFFFF) {
+                        out += static_cast<char>(126);
+                        out += static_cast<char>(payload.size() >> 8);
+                        out += static_cast<char>(payload.size() & 0xFF);
+                    } else {
+                        out += static_cast<char>(127);
+                        for (int shift = 56; shift >= 0; shift -= 8) {
+                            out += static_cast<char>((uint64_t(payload.size()) >> shift) & 0xFF);
+                        }
+                    }
+                    return out + payload;
+                }
+
+                void send(uint8_t opcode, const std::string& payload, bool fin = true) {
+                    sendRaw(frame(opcode, payload, fin));
+                }
+
+                void sendText(const std::string& payload) { send(0x1, payload); }
+
+                // Next client frame, unmasked. false when the client is gone.
+                bool read(uint8_t& opcode, std::string& payload) {
+                    if (!readBytes(2)) return false;
+
+                    opcode = pending_[0] & 0x0F;
+                    bool masked = pending_[1] & 0x80;
+                    uint64_t len = pending_[1] & 0x7F;
+                    size_t header = 2;
+
+                    if (len == 126) {
+                        if (!readBytes(4)) return false;
+                        len = (uint64_t(uint8_t(pending_[2])) << 8) | uint8_t(pending_[3]);
+                        header = 4;
+                    } else if (len == 127) {
+                        if (!readBytes(10)) return false;
+                        len = 0;
+                        for (int i = 2; i < 10; ++i) len = (len << 8) | uint8_t(pending_[i]);
+                        header = 10;
+                    }
+
+                    size_t maskOffset = header;
+                    if (masked) header += 4;
+                    if (!readBytes(header + len)) return false;
+
+                    payload = pending_.substr(header, len);
+                    if (masked) {
+                        for (size_t i = 0; i < len; ++i) payload[i] ^= pending_[maskOffset + (i & 3)];
+                    } else {
+                        clientMasked = false;
+                    }
+
+                    pending_.erase(0, header + len);
+                    return true;
+                }
+
+                void drop() { ::shutdown(fd_, SHUT_RDWR); }
+
+                // Closes the socket outright, unlike drop(): anything the
+                // client writes afterwards is answered with a reset. fd_ is
+                // swapped for an unconnected socket so the server's own
+                // cleanup stays harmless.
+                void close() {
+                    int spare = ::socket(AF_INET, SOCK_STREAM, 0);
+                    ::dup2(spare, fd_);
+                    ::close(spare);
+                }
+        };
+
+        using Handler = std::function<void(Session&)>;
+
+    private:
+        int listenFd_ = -1;
+        int port_ = 0;
+        Handler handler_;
+        std::atomic<bool> running_{true};
+        std::atomic<int> connections_{0};
+
+        std::thread acceptor_;
+        std::mutex clientsMutex_;
+        std::vector<int> clientFds_;
+        std::vector<std::thread> clients_;
+
+        static std::string acceptKey(const std::string& key) {
+            std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+            unsigned char digest[SHA_DIGEST_LENGTH];
+            SHA1(reinterpret_cast<const unsigned char*>(input.data()), input.size(), digest);
+
+            std::string out(28, '\0');
+            EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&out[0]), digest, sizeof(digest));
+            return out;
+        }
+
+        void acceptLoop() {
+            while (running_) {
+                pollfd pfd{listenFd_, POLLIN, 0};
+                if (::poll(&pfd, 1, 50) <= 0) continue;
+
+                int fd = ::accept(listenFd_, nullptr, nullptr);
+                if (fd < 0) continue;
+
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+                connections_++;
+                std::lock_guard<std::mutex> lock(clientsMutex_);
+                clientFds_.push_back(fd);
+                clients_.emplace_back(&WsReplayServer::serve, this, fd);
+            }
+        }
+
+        void serve(int fd) {
+            std::string request;
+            char buf[4096];
+            size_t end;
+
+            while ((end = request.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t len = ::recv(fd, buf, sizeof(buf), 0);
+                if (len <= 0) return;
+                request.append(buf, len);
+            }
+
+            size_t keyStart = request.find("Sec-WebSocket-Key: ");
+            if (keyStart == std::string::npos) return;
+            keyStart += 19;
+            std::string key = request.substr(keyStart, request.find("\r\n", keyStart) - keyStart);
+
+            std::string response =
+                "HTTP/1.1 101 Switching Protocols\r\n"
+                "Upgrade: websocket\r\n"
+                "Connection: Upgrade\r\n"
+                "Sec-WebSocket-Accept: " + acceptKey(key) + "\r\n"
+                "\r\n";
+            ::send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+
+            Session session(fd, request.substr(end + 4));
+            handler_(session);
+        }
+
+    public:
+        explicit WsReplayServer(Handler handler) : handler_(std::move(handler)) {
+            listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+            int one = 1;
+            setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            ::listen(listenFd_, 16);
+
+            socklen_t len = sizeof(addr);
+            getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+            port_ = ntohs(addr.sin_port);
+
+            acceptor_ = std::thread(&WsReplayServer::acceptLoop, this);
+        }
+
+        ~WsReplayServer() {
+            running_ = false;
+            acceptor_.join();
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex_);
+                for (int fd : clientFds_) ::shutdown(fd, SHUT_RDWR);
+            }
+            for (auto& client : clients_) client.join();
+            for (int fd : clientFds_) ::close(fd);
+            ::close(listenFd_);
+        }
+
+        std::string url(const std::string& path = "/ws") const {
+            return "ws://127.0.0.1:" + std::to_string(port_) + path;
+        }
+
+        int connections() const { return connections_; }
+};
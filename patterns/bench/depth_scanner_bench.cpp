@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../src/utils/depth_scanner.hpp"
+
+/**
+    Top-of-book extraction: nlohmann DOM + std::stod (what the exchange tools
+    used to do) against DepthScanner, on depth payloads in each venue's
+    response format at several book depths.
+*/
+
+using json = nlohmann::json;
+
+struct Payload {
+    const char* venue;
+    int depth;
+    std::string body;
+    const char* bidKey = "bids";
+    const char* askKey = "asks";
+    const char* book = nullptr;   // object holding the book, if nested
+};
+
+static std::string levels(int depth, double start, double step, const char* extra) {
+    std::string out = "[";
+    char level[96];
+    for (int i = 0; i < depth; ++i) {
+        snprintf(level, sizeof(level), "%s[\"%.2f\",\"%.8f\"%s]",
+                 i ? "," : "", start + i * step, 0.01 + (i % 17) * 0.137, extra);
+        out += level;
+    }
+    return out + "]";
+}
+
+static Payload binance(int depth) {
+    return {"binance", depth, "{\"lastUpdateId\":51839920017,\"bids\":" + levels(depth, 67120.01, -0.01, "") +
+                              ",\"asks\":" + levels(depth, 67120.02, 0.01, "") + "}"};
+}
+
+static Payload bybit(int depth) {
+    return {"bybit", depth, "{\"retCode\":0,\"retMsg\":\"OK\",\"result\":{\"s\":\"BTCUSDT\",\"a\":" +
+                            levels(depth, 67120.02, 0.01, "") + ",\"b\":" + levels(depth, 67120.01, -0.01, "") +
+                            ",\"ts\":1716863719031,\"u\":230704,\"seq\":1432604333,\"cts\":1716863718905},"
+                            "\"retExtInfo\":{},\"time\":1716863719382}", "b", "a", "result"};
+}
+
+static Payload coinbase(int depth) {
+    return {"coinbase", depth, "{\"bids\":" + levels(depth, 67120.01, -0.01, ",3") +
+                               ",\"asks\":" + levels(depth, 67120.02, 0.01, ",1") +
+                               ",\"sequence\":92338283712,\"auction_mode\":false,\"auction\":null,"
+                               "\"time\":\"2024-11-05T19:53:42.553Z\"}"};
+}
+
+static Payload okx(int depth) {
+    return {"okx", depth, "{\"code\":\"0\",\"msg\":\"\",\"data\":[{\"asks\":" + levels(depth, 67120.02, 0.01, ",\"0\",\"4\"") +
+                          ",\"bids\":" + levels(depth, 67120.01, -0.01, ",\"0\",\"2\"") +
+                          ",\"ts\":\"1629966436396\"}]}", "bids", "asks", "data"};
+}
+
+static double domPath(const Payload& p) {
+    json data = json::parse(p.body);
+    const json* book = &data;
+    if (p.book) {
+        book = &data[p.book];
+        if (book->is_array()) book = &(*book)[0];
+    }
+    return std::stod((*book)[p.bidKey][0][0].get<std::string>()) + std::stod((*book)[p.askKey][0][0].get<std::string>());
+}
+
+static double scannerPath(const Payload& p) {
+    DepthScanner scanner(p.body);
+    double bid = 0, ask = 0, size;
+    if (scanner.seek(p.bidKey)) scanner.nextLevel(bid, size);
+    if (scanner.seek(p.askKey)) scanner.nextLevel(ask, size);
+    return bid + ask;
+}
+
+// Median ns per call over several rounds
+static double measure(const std::function<double(const Payload&)>& fn, const Payload& p, int iterations) {
+    std::vector<double> rounds;
+    volatile double sink = 0;
+
+    for (int round = 0; round < 7; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink = sink + fn(p);
+        }
+        auto end = std::chrono::steady_clock::now();
+        rounds.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+    }
+
+    std::sort(rounds.begin(), rounds.end());
+    return rounds[rounds.size() / 2];
+}
+
+int main() {
+    std::vector<Payload> payloads;
+    for (int depth : {1, 20, 100}) {
+        payloads.push_back(binance(depth));
+        payloads.push_back(bybit(depth));
+        payloads.push_back(coinbase(depth));
+        payloads.push_back(okx(depth));
+    }
+
+    printf("%-10s %6s %8s %12s %12s %8s\n", "venue", "depth", "bytes", "dom ns", "scanner ns", "speedup");
+    for (const auto& p : payloads) {
+        if (domPath(p) != scannerPath(p)) {
+            printf("%s depth %d: results differ\n", p.venue, p.depth);
+            return 1;
+        }
+
+        int iterations = p.depth >= 100 ? 2000 : 20000;
+        double dom = measure(domPath, p, iterations);
+        double scan = measure(scannerPath, p, iterations);
+
+        printf("%-10s %6d %8zu %12.1f %12.1f %7.1fx\n", p.venue, p.depth, p.body.size(), dom, scan, dom / scan);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+#include "../src/decorator/orderbook.hpp"
+
+/**
+    Replays a synthetic L2 update stream into OrderBook and, for reference,
+    into a std::map based book, and reports per-update latency against the
+    README's "order book updates < 5 us (p99)" target.
+
+    The stream follows a random-walk mid; update distance from the touch is
+    geometric, so most traffic lands in the first few levels as on a real
+    venue. A quarter of the updates delete their level.
+*/
+
+struct Update {
+    Side side;
+    double price;
+    double size;
+};
+
+static constexpr double TICK = 0.01;
+static constexpr int SNAPSHOT_LEVELS = 1000;
+static constexpr int NUM_UPDATES = 1000000;
+
+static std::vector<Update> syntheticStream(double& mid) {
+    std::mt19937_64 rng(42);
+    std::geometric_distribution<int> distance(0.3);
+    std::uniform_real_distribution<double> size(0.001, 5.0);
+    std::uniform_int_distribution<int> coin(0, 3);
+    std::uniform_int_distribution<int> walk(-1, 1);
+
+    std::vector<Update> updates;
+    updates.reserve(NUM_UPDATES);
+
+    long midTicks = static_cast<long>(mid / TICK);
+    for (int i = 0; i < NUM_UPDATES; ++i) {
+        if (i % 50 == 0) midTicks += walk(rng);
+
+        Side side = coin(rng) & 1 ? Side::BID : Side::ASK;
+        long ticks = 1 + distance(rng);
+        long priceTicks = side == Side::BID ? midTicks - ticks : midTicks + ticks;
+
+        updates.push_back({side, priceTicks * TICK, coin(rng) == 0 ? 0.0 : size(rng)});
+    }
+    return updates;
+}
+
+struct MapBook {
+    std::map<double, double, std::greater<double>> bids;
+    std::map<double, double> asks;
+
+    void apply(Side side, double price, double size) {
+        if (side == Side::BID) {
+            if (size <= 0) bids.erase(price); else bids[price] = size;
+        } else {
+            if (size <= 0) asks.erase(price); else asks[price] = size;
+        }
+    }
+};
+
+template<typename Book>
+static void replay(const char* name, Book book, const std::vector<Update>& updates) {
+    // Untimed pass on a copy for throughput, then a per-update timed pass
+    Book warm = book;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& u : updates) {
+        warm.apply(u.side, u.price, u.size);
+    }
+    double total = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::vector<double> latencies;
+    latencies.reserve(updates.size());
+
+    for (const auto& u : updates) {
+        auto start = std::chrono::steady_clock::now();
+        book.apply(u.side, u.price, u.size);
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) { return latencies[static_cast<size_t>(latencies.size() * p)]; };
+
+    printf("%-10s %10.0f upd/s   p50 %6.0f ns   p99 %6.0f ns   p999 %7.0f ns   max %8.0f ns\n",
+           name, updates.size() / total, pct(0.50), pct(0.99), pct(0.999), latencies.back());
+}
+
+int main() {
+    double mid = 67000.00;
+    std::vector<Update> updates = syntheticStream(mid);
+
+    std::vector<PriceLevel> bids, asks;
+    for (int i = 1; i <= SNAPSHOT_LEVELS; ++i) {
+        bids.push_back({mid - i * TICK, 1.0});
+        asks.push_back({mid + i * TICK, 1.0});
+    }
+
+    OrderBook flat(4 * SNAPSHOT_LEVELS);
+    flat.loadSnapshot(bids, asks);
+
+    MapBook tree;
+    for (int i = 0; i < SNAPSHOT_LEVELS; ++i) {
+        tree.apply(Side::BID, bids[i].price, bids[i].size);
+        tree.apply(Side::ASK, asks[i].price, asks[i].size);
+    }
+
+    printf("%d updates, %d-level snapshot (percentiles include timer overhead)\n", NUM_UPDATES, SNAPSHOT_LEVELS);
+    replay("flat", flat, updates);
+    replay("std::map", tree, updates);
+
+    return 0;
+}
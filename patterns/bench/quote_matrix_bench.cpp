@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../src/decorator/quote_matrix.hpp"
+
+/**
+    Cross-exchange and triangular scans over a 116-symbol x 4-exchange
+    QuoteMatrix, reported per symbol, against the nested per-pair loop over
+    BBO structs the bot used before.
+
+    Every token has a USD price and symbol mids follow from it, so quote
+    currencies stay consistent; each venue's quote then jitters around the
+    mid so that a small fraction of symbols cross after fees on any given
+    scan, as in a live market.
+*/
+
+static constexpr int NUM_BASES = 30;
+static constexpr int NUM_EXCHANGES = 4;
+static constexpr int NUM_SNAPSHOTS = 8;
+static constexpr int ROUNDS = 20000;
+
+static const double FEES[NUM_EXCHANGES] = {0.001, 0.001, 0.001, 0.006};
+
+// Symbol-major BBOs, one vector per snapshot
+using Snapshot = std::vector<BBO>;
+
+static std::vector<Snapshot> syntheticSnapshots(const std::vector<Symbol>& symbols) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> usd(0.01, 5000.0);
+    std::normal_distribution<double> jitter(0, 0.0005);
+    std::uniform_real_distribution<double> size(0.01, 10.0);
+
+    std::vector<double> usdPrice(NUM_BASES);
+    for (double& price : usdPrice) price = usd(rng);
+    usdPrice[int(Token::USDC)] = usdPrice[int(Token::USDT)] = 1.0;
+
+    std::vector<double> mids;
+    for (const Symbol& symbol : symbols) {
+        mids.push_back(usdPrice[int(symbol.base)] / usdPrice[int(symbol.quote)]);
+    }
+
+    std::vector<Snapshot> snapshots(NUM_SNAPSHOTS);
+    for (Snapshot& snap : snapshots) {
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            for (int e = 0; e < NUM_EXCHANGES; ++e) {
+                double m = mids[s] * (1 + jitter(rng));
+                BBO bbo{};
+                bbo.bid = PriceLevel{m * 0.9999, size(rng)};
+                bbo.ask = PriceLevel{m * 1.0001, size(rng)};
+                snap.push_back(bbo);
+            }
+        }
+    }
+    return snapshots;
+}
+
+// The pre-matrix scan: every (buy, sell) pair of every symbol, on BBOs
+static size_t naiveScan(const Snapshot& snap, size_t symbols, std::vector<CrossOpportunity>& out) {
+    size_t found = 0;
+    for (size_t s = 0; s < symbols; ++s) {
+        const BBO* row = &snap[s * NUM_EXCHANGES];
+        for (int buy = 0; buy < NUM_EXCHANGES; ++buy) {
+            for (int sell = 0; sell < NUM_EXCHANGES; ++sell) {
+                if (buy == sell) continue;
+
+                double cost = row[buy].ask.price * (1 + FEES[buy]);
+                double proceeds = row[sell].bid.price * (1 - FEES[sell]);
+                if (proceeds <= cost) continue;
+
+                out.push_back({uint32_t(s), uint32_t(buy), uint32_t(sell),
+                               (proceeds - cost) / cost * 100,
+                               std::min(row[buy].ask.size, row[sell].bid.size)});
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+template<typename F>
+static double timeRounds(F&& body) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) body(r);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main() {
+    const Token quotes[] = {Token::USDT, Token::USDC, Token::BTC, Token::ETH};
+
+    std::vector<Symbol> symbols;
+    for (Token quote : quotes) {
+        for (int b = 0; b < NUM_BASES; ++b) {
+            if (static_cast<Token>(b) != quote) symbols.push_back({static_cast<Token>(b), quote});
+        }
+    }
+
+    std::vector<Snapshot> snapshots = syntheticSnapshots(symbols);
+    std::vector<double> fees(FEES, FEES + NUM_EXCHANGES);
+
+    // One matrix per snapshot, so the scans are timed on their own; the
+    // cost of writing quotes in is reported separately
+    std::vector<QuoteMatrix> matrices;
+    for (int i = 0; i < NUM_SNAPSHOTS; ++i) matrices.emplace_back(symbols, fees);
+
+    double loadNs = timeRounds([&](int r) {
+        const Snapshot& snap = snapshots[r % NUM_SNAPSHOTS];
+        QuoteMatrix& matrix = matrices[r % NUM_SNAPSHOTS];
+        for (size_t s = 0; s < symbols.size(); ++s) {
+            for (int e = 0; e < NUM_EXCHANGES; ++e) {
+                matrix.set(s, e, snap[s * NUM_EXCHANGES + e]);
+            }
+        }
+    });
+
+    std::vector<CrossOpportunity> cross;
+    std::vector<TriangleOpportunity> triangles;
+    cross.reserve(4096);
+    triangles.reserve(4096);
+
+    size_t naiveFound = 0, crossFound = 0, triangleFound = 0;
+
+    double naiveNs = timeRounds([&](int r) {
+        cross.clear();
+        naiveFound += naiveScan(snapshots[r % NUM_SNAPSHOTS], symbols.size(), cross);
+    });
+
+    double crossNs = timeRounds([&](int r) {
+        cross.clear();
+        crossFound += matrices[r % NUM_SNAPSHOTS].scanCross(0, cross);
+    });
+
+    double triangleNs = timeRounds([&](int r) {
+        triangles.clear();
+        triangleFound += matrices[r % NUM_SNAPSHOTS].scanTriangular(0, triangles);
+    });
+
+    double perScan = symbols.size() * double(ROUNDS);
+    printf("%zu symbols x %d exchanges, %zu triangles, %d scans\n",
+           symbols.size(), NUM_EXCHANGES, matrices[0].triangleCount(), ROUNDS);
+    printf("%-22s %7.2f ns/symbol   %6.2f hits/scan\n", "naive pair loop", naiveNs / perScan, double(naiveFound) / ROUNDS);
+    printf("%-22s %7.2f ns/symbol   %6.2f hits/scan\n", "matrix cross", crossNs / perScan, double(crossFound) / ROUNDS);
+    printf("%-22s %7.2f ns/symbol   %6.2f hits/scan   (%.2f ns/triangle/exchange)\n", "matrix triangular",
+           triangleNs / perScan, double(triangleFound) / ROUNDS,
+           triangleNs / (matrices[0].triangleCount() * NUM_EXCHANGES * double(ROUNDS)));
+    printf("%-22s %7.2f ns/symbol\n", "matrix load", loadNs / perScan);
+
+    return 0;
+}
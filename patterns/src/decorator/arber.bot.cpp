@@ -1,6 +1,11 @@
 #include "interface.hpp"
 #include <vector>
+#include <algorithm>
 #include "decorator.cpp"
+#include "sizing.hpp"
+#include "quote_matrix.hpp"
+#include "quote_board.hpp"
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <csignal>
@@ -8,54 +13,178 @@
 class ArbitrageBot {
     private:
         std::vector<IExchange*> exchanges;
-        double tradeAmount;
-        double minProfit;
+        double tradeAmount;  // max base quantity per opportunity
+        double minProfit;    // percent, after fees
+        size_t bookDepth;
 
-        bool running;
+        std::atomic<bool> running;
 
+        HttpClient http;
         ArbLogDecorator logger;
         ArbLatencyDecorator latencyMonitor;
 
+        // One depth request per (symbol, exchange) per scan, all in flight at
+        // once, so a scan costs the slowest venue's RTT rather than the sum of
+        // them. Every pair is then compared against this snapshot, and all
+        // books in it were taken at (roughly) the same moment. Books come
+        // back symbol-major: books[s][e].
+        std::vector<std::vector<OrderBook>> snapshot(const std::vector<Symbol>& symbols) {
+            std::vector<HttpRequest> requests;
+            requests.reserve(symbols.size() * exchanges.size());
+
+            for (const Symbol& symbol : symbols) {
+                for (IExchange* exchange : exchanges) {
+                    requests.push_back(exchange->depthRequest(symbol.base, symbol.quote, bookDepth));
+                }
+            }
+
+            std::vector<HttpResponse> responses = http.fetchAll(requests);
+
+            std::vector<std::vector<OrderBook>> books(symbols.size());
+            for (size_t s = 0; s < symbols.size(); ++s) {
+                books[s].reserve(exchanges.size());
+                for (size_t e = 0; e < exchanges.size(); ++e) {
+                    books[s].push_back(exchanges[e]->parseBook(responses[s * exchanges.size() + e], bookDepth));
+                }
+            }
+
+            return books;
+        }
+
+        // Sizes buy -> sell by walking both books, net of each venue's taker
+        // fee, and keeps it only when it clears minProfit
+        void addOpportunity(std::vector<Arber>& opportunities, const Symbol& symbol,
+                            const OrderBook& buyBook, const OrderBook& sellBook, size_t buy, size_t sell) {
+            Execution exec = sizeArbitrage(
+                buyBook, sellBook,
+                exchanges[buy]->takerFee, exchanges[sell]->takerFee,
+                tradeAmount, minProfit
+            );
+            if (exec.quantity <= 0) return;
+
+            Arber arb(
+                exchanges[buy]->name,
+                exchanges[sell]->name,
+                exec.profitPercent(),
+                exec.quantity,
+                toBBO(buyBook),
+                toBBO(sellBook),
+                true
+            );
+            arb.symbol = symbol;
+            arb.buyVwap = exec.buyVwap;
+            arb.sellVwap = exec.sellVwap;
+            opportunities.push_back(arb);
+        }
+
+        static void rank(std::vector<Arber>& opportunities) {
+            std::sort(opportunities.begin(), opportunities.end(),
+                [](const Arber& a, const Arber& b) { return a.profit > b.profit; });
+        }
+
+        // Every profitable (buy, sell) pair for one symbol, best profit first
+        std::vector<Arber> findOpportunities(const Symbol& symbol, const std::vector<OrderBook>& books) {
+            std::vector<Arber> opportunities;
+
+            for (size_t buy = 0; buy < books.size(); ++buy) {
+                const PriceLevel* bestAsk = books[buy].bestAsk();
+                if (!bestAsk) continue;  // failed fetches come back empty
+
+                for (size_t sell = 0; sell < books.size(); ++sell) {
+                    if (buy == sell) continue;
+
+                    const PriceLevel* bestBid = books[sell].bestBid();
+                    if (!bestBid || bestBid->price <= bestAsk->price) continue;
+
+                    addOpportunity(opportunities, symbol, books[buy], books[sell], buy, sell);
+                }
+            }
+
+            rank(opportunities);
+            return opportunities;
+        }
+
         Arber findArbitrage(Token base, Token quote) {
-            Arber bestArb(Exchange::BINANCE, Exchange::BINANCE, 0, 0, BBO(), BBO(), false);
-
-            for (IExchange* buyEx : exchanges) {
-                BBO buyBBO = buyEx->getBBO(base, quote);
-
-                for (IExchange* sellEx : exchanges) {
-                    if (buyEx == sellEx) continue;
-
-                    BBO sellBBO = sellEx->getBBO(base, quote);
-
-                    double profit = (sellBBO.bid.price - buyBBO.ask.price) / buyBBO.ask.price * 100;
-
-                    // if (profit > minProfit && profit > bestArb.profit) {
-                    if (sellBBO.bid.price > buyBBO.ask.price) {
-                        double amount = std::min({
-                            tradeAmount,
-                            buyBBO.ask.size * buyBBO.ask.price,
-                            sellBBO.bid.size * sellBBO.bid.price
-                        });
-
-                        bestArb = Arber(
-                            buyEx->name,
-                            sellEx->name,
-                            profit,
-                            amount,
-                            buyBBO,
-                            sellBBO,
-                            true
-                        );
+            std::vector<Arber> opportunities = scanAll(base, quote);
+
+            if (opportunities.empty()) {
+                return Arber(Exchange::BINANCE, Exchange::BINANCE, 0, 0, BBO(), BBO(), false);
+            }
+            return opportunities.front();
+        }
+
+        std::vector<double> takerFees() const {
+            std::vector<double> fees;
+            for (IExchange* exchange : exchanges) {
+                fees.push_back(exchange->takerFee);
+            }
+            return fees;
+        }
+
+        // One thread per exchange: walks the symbol list one depth request at
+        // a time, paced by the venue's requestInterval, and publishes every
+        // book to the board. A slow venue only delays its own slots.
+        void poll(size_t e, const std::vector<Symbol>& symbols, QuoteBoard& board) {
+            IExchange* exchange = exchanges[e];
+            auto interval = std::chrono::milliseconds(exchange->requestInterval);
+            auto next = std::chrono::steady_clock::now();
+
+            while (running) {
+                for (size_t s = 0; s < symbols.size() && running; ++s) {
+                    std::this_thread::sleep_until(next);
+                    next = std::max(next + interval, std::chrono::steady_clock::now());
+
+                    OrderBook book = exchange->getBook(symbols[s].base, symbols[s].quote, bookDepth);
+                    if (!book.empty()) {
+                        board.publish(s, e, book, nowNanos());
+                    }
+                }
+            }
+
+            board.wake();
+        }
+
+        // Screens the board on top of book and sizes the crossed candidates
+        // on the published books. Slots older than maxAge are left out, so
+        // a venue that stopped answering can't hold a phantom opportunity.
+        std::vector<Arber> evaluate(const QuoteBoard& board, QuoteMatrix& matrix, uint64_t maxAge,
+                                    std::vector<TriangleOpportunity>& triangles) {
+            uint64_t now = nowNanos();
+
+            for (size_t s = 0; s < matrix.symbolCount(); ++s) {
+                for (size_t e = 0; e < exchanges.size(); ++e) {
+                    BBO bbo;
+                    uint64_t updatedAt = board.readTop(s, e, bbo);
+
+                    if (QuoteBoard::isFresh(updatedAt, now, maxAge)) {
+                        matrix.set(s, e, bbo);
+                    } else {
+                        matrix.clear(s, e);
                     }
                 }
             }
 
-            return bestArb;
+            std::vector<CrossOpportunity> candidates;
+            matrix.scanCross(minProfit, candidates);
+
+            std::vector<Arber> opportunities;
+            OrderBook buyBook, sellBook;
+            for (const CrossOpportunity& c : candidates) {
+                board.readBook(c.symbol, c.buyExchange, buyBook);
+                board.readBook(c.symbol, c.sellExchange, sellBook);
+                addOpportunity(opportunities, matrix.symbol(c.symbol), buyBook, sellBook, c.buyExchange, c.sellExchange);
+            }
+            rank(opportunities);
+
+            triangles.clear();
+            matrix.scanTriangular(minProfit, triangles);
+
+            return opportunities;
         }
 
     public:
-        ArbitrageBot(double minProfit, double tradeAmount)
-            : minProfit(minProfit), tradeAmount(tradeAmount), running(true) {}
+        ArbitrageBot(double minProfit, double tradeAmount, size_t bookDepth = 20)
+            : minProfit(minProfit), tradeAmount(tradeAmount), bookDepth(bookDepth), running(true) {}
 
         void addExchange(IExchange* exchange) {
             exchanges.push_back(exchange);
@@ -65,28 +194,106 @@ class ArbitrageBot {
             running = false;
         }
 
+        // Scanning is event driven now, there is no interval to wait out;
+        // these keep old callers building while they move to watch()
+        [[deprecated("scanInterval is ignored; use watch(base, quote, maxQuoteAge)")]]
         void run(Token base, Token quote, int scanInterval = 1000) {
-            std::cout << "Starting arbitrage scanner..." << std::endl;
+            watch(std::vector<Symbol>{{base, quote}});
+        }
 
+        [[deprecated("scanInterval is ignored; use watch(symbols, maxQuoteAge)")]]
+        void run(const std::vector<Symbol>& symbols, int scanInterval = 1000) {
+            watch(symbols);
+        }
+
+        void watch(Token base, Token quote, int maxQuoteAge = 2000) {
+            watch(std::vector<Symbol>{{base, quote}}, maxQuoteAge);
+        }
+
+        // Event driven: each exchange is polled on its own thread and the
+        // board is re-evaluated as soon as any slot changes. Quotes older
+        // than maxQuoteAge ms are ignored.
+        void watch(const std::vector<Symbol>& symbols, int maxQuoteAge = 2000) {
+            if (exchanges.empty()) return;  // nothing would ever wake the evaluator
+            std::cout << "Starting arbitrage scanner on " << symbols.size() << " symbols..." << std::endl;
+
+            QuoteBoard board(symbols.size(), exchanges.size());
+            QuoteMatrix matrix(symbols, takerFees());
+            std::vector<TriangleOpportunity> triangles;
+            uint64_t maxAge = static_cast<uint64_t>(maxQuoteAge) * 1000000;
+
+            std::vector<std::thread> pollers;
+            for (size_t e = 0; e < exchanges.size(); ++e) {
+                pollers.emplace_back(&ArbitrageBot::poll, this, e, std::cref(symbols), std::ref(board));
+            }
+
+            uint64_t seen = 0;
             while (running) {
-                auto start_time = latencyMonitor.start();
+                seen = board.waitForChange(seen);
+                if (!running) break;
 
-                Arber opportunity = findArbitrage(base, quote);
+                auto start_time = latencyMonitor.start();
+                std::vector<Arber> opportunities = evaluate(board, matrix, maxAge, triangles);
+                latencyMonitor.end(start_time);
 
-                if (opportunity.getExecute()) {
+                for (const Arber& opportunity : opportunities) {
                     logger.logOpportunity(opportunity);
                 }
+                for (const TriangleOpportunity& t : triangles) {
+                    logger.logTriangle(
+                        exchanges[t.exchange]->name,
+                        matrix.symbol(t.first), matrix.symbol(t.second), matrix.symbol(t.bridge),
+                        t.profitPercent
+                    );
+                }
+            }
 
-                latencyMonitor.end(start_time);
-
-                std::this_thread::sleep_for(std::chrono::milliseconds(scanInterval));
+            for (std::thread& poller : pollers) {
+                poller.join();
             }
+            logger.flush();
+            latencyMonitor.flush();
         }
 
         Arber scan(Token base, Token quote) {
             return findArbitrage(base, quote);
         }
 
+        // All profitable pairs from a single snapshot, ranked by profit
+        std::vector<Arber> scanAll(Token base, Token quote) {
+            Symbol symbol{base, quote};
+            return findOpportunities(symbol, snapshot({symbol})[0]);
+        }
+
+        // One snapshot of every symbol in the matrix. The matrix screens all
+        // symbols on top of book, and only the crossed (symbol, buy, sell)
+        // candidates are sized against the full books. Single-venue
+        // triangles found on the same snapshot are written to triangles.
+        std::vector<Arber> scanAll(QuoteMatrix& matrix, std::vector<TriangleOpportunity>& triangles) {
+            std::vector<std::vector<OrderBook>> books = snapshot(matrix.symbolList());
+
+            for (size_t s = 0; s < books.size(); ++s) {
+                for (size_t e = 0; e < exchanges.size(); ++e) {
+                    matrix.set(s, e, toBBO(books[s][e]));
+                }
+            }
+
+            std::vector<CrossOpportunity> candidates;
+            matrix.scanCross(minProfit, candidates);
+
+            std::vector<Arber> opportunities;
+            for (const CrossOpportunity& c : candidates) {
+                addOpportunity(opportunities, matrix.symbol(c.symbol), books[c.symbol][c.buyExchange],
+                               books[c.symbol][c.sellExchange], c.buyExchange, c.sellExchange);
+            }
+            rank(opportunities);
+
+            triangles.clear();
+            matrix.scanTriangular(minProfit, triangles);
+
+            return opportunities;
+        }
+
         ~ArbitrageBot() {
             for (auto* exchange : exchanges) {
                 delete exchange;
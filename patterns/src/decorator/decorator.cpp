@@ -1,5 +1,6 @@
 #include "interface.hpp"
-#include <fstream>
+#include <chrono>
+#include "async_logger.hpp"
 
 class ExchangeDecorator : public IExchange {
     protected:
@@ -9,12 +10,30 @@ class ExchangeDecorator : public IExchange {
         ExchangeDecorator(IExchange* exchange) : exchange(exchange) {
             this->url = exchange->url;
             this->name = exchange->name;
+            this->takerFee = exchange->takerFee;
+            this->requestInterval = exchange->requestInterval;
         }
 
         virtual BBO getBBO(Token base, Token quote) override {
             return exchange->getBBO(base, quote);
         }
 
+        virtual OrderBook getBook(Token base, Token quote, size_t depth) override {
+            return exchange->getBook(base, quote, depth);
+        }
+
+        virtual HttpRequest depthRequest(Token base, Token quote, size_t depth) override {
+            return exchange->depthRequest(base, quote, depth);
+        }
+
+        virtual BBO parseBBO(const HttpResponse& res) override {
+            return exchange->parseBBO(res);
+        }
+
+        virtual OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            return exchange->parseBook(res, depth);
+        }
+
         virtual std::string getTicker(Token& base, Token& quote) override {
             return exchange->getTicker(base, quote);
         }
@@ -26,38 +45,73 @@ class ExchangeDecorator : public IExchange {
 
 class LoggingDecorator : public ExchangeDecorator {
     private:
-        std::ofstream logFile;
+        AsyncLogger& logger;
 
-    public:
-        LoggingDecorator(IExchange* exchange) : ExchangeDecorator(exchange) {
-            logFile.open("exchange_logs.txt", std::ios::app);
+        static constexpr LogFormat BBO_LINE{"{} {}{} Bid: {}@{} Ask: {}@{}"};
+        static constexpr LogFormat PARSED_BBO_LINE{"{} Bid: {}@{} Ask: {}@{}"};
+        static constexpr LogFormat BOOK_LINE{"{} {}{} book Bid: {}@{} Ask: {}@{} Levels: {}/{}"};
+        static constexpr LogFormat PARSED_BOOK_LINE{"{} book Bid: {}@{} Ask: {}@{} Levels: {}/{}"};
+
+        static PriceLevel touch(const PriceLevel* level) {
+            return level ? *level : PriceLevel{0, 0};
         }
 
+    public:
+        LoggingDecorator(IExchange* exchange) : ExchangeDecorator(exchange),
+            logger(AsyncLogger::file("exchange_logs.txt")) {}
+
         BBO getBBO(Token base, Token quote) override {
             BBO bbo = exchange->getBBO(base, quote);
 
-            logFile << "[" << std::time(nullptr) << "] "
-                    << name << " " << base << quote
-                    << " Bid: " << bbo.bid.price << "@" << bbo.bid.size
-                    << " Ask: " << bbo.ask.price << "@" << bbo.ask.size
-                    << std::endl;
+            logger.log(BBO_LINE, name, base, quote,
+                       bbo.bid.price, bbo.bid.size, bbo.ask.price, bbo.ask.size);
+
+            return bbo;
+        }
+
+        // Batched fetches bypass getBBO, so log on the parse side as well
+        BBO parseBBO(const HttpResponse& res) override {
+            BBO bbo = exchange->parseBBO(res);
+
+            logger.log(PARSED_BBO_LINE, name, bbo.bid.price, bbo.bid.size, bbo.ask.price, bbo.ask.size);
 
             return bbo;
         }
 
-        ~LoggingDecorator() {
-            logFile.close();
+        // The bot polls books rather than BBOs; log their touch and depth
+        OrderBook getBook(Token base, Token quote, size_t depth) override {
+            OrderBook book = exchange->getBook(base, quote, depth);
+            PriceLevel bid = touch(book.bestBid());
+            PriceLevel ask = touch(book.bestAsk());
+
+            logger.log(BOOK_LINE, name, base, quote, bid.price, bid.size, ask.price, ask.size,
+                       book.depth(Side::BID), book.depth(Side::ASK));
+
+            return book;
+        }
+
+        OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            OrderBook book = exchange->parseBook(res, depth);
+            PriceLevel bid = touch(book.bestBid());
+            PriceLevel ask = touch(book.bestAsk());
+
+            logger.log(PARSED_BOOK_LINE, name, bid.price, bid.size, ask.price, ask.size,
+                       book.depth(Side::BID), book.depth(Side::ASK));
+
+            return book;
         }
 };
 
 class LatencyDecorator : public ExchangeDecorator {
     private:
-        std::ofstream logFile;
+        AsyncLogger& logger;
+
+        static constexpr LogFormat BBO_LATENCY{"[LATENCY] {} request took {}ms"};
+        static constexpr LogFormat BOOK_LATENCY{"[LATENCY] {} {}{} book request took {}ms"};
 
     public:
-        LatencyDecorator(IExchange* exchange) : ExchangeDecorator(exchange) {
-            logFile.open("exchange_logs.txt", std::ios::app);
-        }
+        LatencyDecorator(IExchange* exchange) : ExchangeDecorator(exchange),
+            logger(AsyncLogger::file("exchange_logs.txt")) {}
 
         BBO getBBO(Token base, Token quote) override {
             auto start = std::chrono::high_resolution_clock::now();
@@ -67,68 +121,86 @@ class LatencyDecorator : public ExchangeDecorator {
             auto end = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-            logFile << "[LATENCY] " << name << " request took "
-                    << duration.count() << "ms" << std::endl;
+            logger.log(BBO_LATENCY, name, duration.count());
 
             return bbo;
         }
 
-        ~LatencyDecorator() {
-            logFile.close();
+        OrderBook getBook(Token base, Token quote, size_t depth) override {
+            auto start = std::chrono::high_resolution_clock::now();
+
+            OrderBook book = exchange->getBook(base, quote, depth);
+
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+            logger.log(BOOK_LATENCY, name, base, quote, duration.count());
+
+            return book;
         }
 };
 
 class ArbLogDecorator {
     private:
-        std::ofstream logFile;
+        AsyncLogger& logFile;
+        AsyncLogger& console;
+
+        static constexpr LogFormat OPPORTUNITY_LINE{
+            "{} Buy: {} @ {} Sell: {} @ {} Amount: {} VWAP: {}/{} Spread: {} Profit: {} %"};
+        static constexpr LogFormat OPPORTUNITY_BANNER{
+            "\n=== Arbitrage Opportunity Found! ===\n"
+            "Symbol: {}\n"
+            "Buy from: {} at {}\n"
+            "Sell to: {} at {}\n"
+            "Amount: {}\n"
+            "VWAP: buy {} sell {}\n"
+            "Spread: {}\n"
+            "Profit: {} %\n"
+            "==============================\n"};
+        static constexpr LogFormat TRIANGLE_LINE{"Triangle on {}: buy {} sell {} via {} Profit: {} %"};
+        static constexpr LogFormat TRIANGLE_CONSOLE{"Triangle on {}: buy {}, sell {}, via {} -> {} %"};
 
     public:
-        ArbLogDecorator() {
-            logFile.open(
-                "arbitrage_logs.txt",
-                std::ios::app
-            );
-        }
+        ArbLogDecorator() : logFile(AsyncLogger::file("arbitrage_logs.txt")), console(AsyncLogger::console()) {}
 
         void logOpportunity(const Arber& arb) {
-            std::string timestamp = std::to_string(std::time(nullptr));
-
-            logFile << "[" << timestamp << "] "
-                    << "Buy: " << arb.buyExchange
-                    << " @ " << arb.buyBBO.ask.price
-                    << " Sell: " << arb.sellExchange
-                    << " @ " << arb.sellBBO.bid.price
-                    << " Amount: " << arb.amount
-                    << " Spread: " << (arb.sellBBO.bid.price - arb.buyBBO.ask.price)
-                    << " Profit: " << arb.profit << " %"
-                    << std::endl;
+            double spread = arb.sellBBO.bid.price - arb.buyBBO.ask.price;
+
+            logFile.log(OPPORTUNITY_LINE, arb.symbol,
+                        arb.buyExchange, arb.buyBBO.ask.price,
+                        arb.sellExchange, arb.sellBBO.bid.price,
+                        arb.amount, arb.buyVwap, arb.sellVwap, spread, arb.profit);
 
             // Also print to console
-            std::cout << "\n=== Arbitrage Opportunity Found! ===" << std::endl;
-            std::cout << "Buy from: " << arb.buyExchange
-                        << " at " << arb.buyBBO.ask.price << std::endl;
-            std::cout << "Sell to: " << arb.sellExchange
-                        << " at " << arb.sellBBO.bid.price << std::endl;
-            std::cout << "Amount: " << arb.amount << std::endl;
-            std::cout << "Spread: " << (arb.sellBBO.bid.price - arb.buyBBO.ask.price) << std::endl
-            << "Profit: " << arb.profit << " %" << std::endl;
-            std::cout << "==============================\n" << std::endl;
+            console.log(OPPORTUNITY_BANNER, arb.symbol,
+                        arb.buyExchange, arb.buyBBO.ask.price,
+                        arb.sellExchange, arb.sellBBO.bid.price,
+                        arb.amount, arb.buyVwap, arb.sellVwap, spread, arb.profit);
+        }
+
+        void logTriangle(Exchange exchange, const Symbol& first, const Symbol& second, const Symbol& bridge, double profit) {
+            logFile.log(TRIANGLE_LINE, exchange, first, second, bridge, profit);
+            console.log(TRIANGLE_CONSOLE, exchange, first, second, bridge, profit);
         }
 
-        ~ArbLogDecorator() {
-            logFile.close();
+        // Waits until everything logged so far is written
+        void flush() {
+            logFile.flush();
+            console.flush();
         }
 };
 
 
+// Times each evaluation of the quote board. The bot evaluates on every
+// publish, so lines go to the file only and in microseconds.
 class ArbLatencyDecorator {
     private:
-        std::ofstream logFile;
+        AsyncLogger& logFile;
+
+        static constexpr LogFormat SCAN_LINE{"Scan duration: {}us"};
 
     public:
-        ArbLatencyDecorator() {
-            logFile.open("arbitrage_latency.txt", std::ios::app);
-        }
+        ArbLatencyDecorator() : logFile(AsyncLogger::file("arbitrage_latency.txt")) {}
 
         auto start() {
             return std::chrono::high_resolution_clock::now();
@@ -136,17 +208,12 @@ class ArbLatencyDecorator {
 
         void end(std::chrono::time_point<std::chrono::high_resolution_clock> start_time) {
             auto end = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start_time);
-
-            std::string timestamp = std::to_string(std::time(nullptr));
-
-            logFile << "[" << timestamp << "] "
-                    << "Scan duration: " << duration.count() << "ms" << std::endl;
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_time);
 
-            std::cout << "Scan completed in " << duration.count() << "ms" << std::endl;
+            logFile.log(SCAN_LINE, duration.count());
         }
 
-        ~ArbLatencyDecorator() {
-            logFile.close();
+        void flush() {
+            logFile.flush();
         }
 };
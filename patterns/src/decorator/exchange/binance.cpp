@@ -1,4 +1,5 @@
 #include "../interface.hpp"
+#include "../../utils/depth_scanner.hpp"
 #include <cstdint>
 #include <exception>
 #include <vector>
@@ -16,6 +17,8 @@ class BinanceTool : public IExchange {
         BinanceTool(std::string url = "https://api.binance.com/api/v3") {
             this->url = url;
             this->name = Exchange::BINANCE;
+            this->takerFee = 0.001;
+            this->requestInterval = 50;
         }
 
         std::string getTicker(Token& base, Token& quote) override {
@@ -24,34 +27,30 @@ class BinanceTool : public IExchange {
             return ss.str();
         }
 
-        BBO getBBO(Token base, Token quote) override {
-            try {
-                auto& http = getHttp();
-
-                const std::string depthsUrl = this->url + "/depth?symbol=" + getTicker(base, quote);
-                HttpRequestOptions options;
-                options.headers = {
-                    {"Accept", "application/json"}
-                };
+        HttpRequest depthRequest(Token base, Token quote, size_t depth) override {
+            HttpRequest req;
+            req.url = this->url + "/depth?symbol=" + getTicker(base, quote) + "&limit=" + std::to_string(depth);
+            req.options.headers = {
+                {"Accept", "application/json"}
+            };
 
-                HttpResponse res = http.fetch(depthsUrl, options);
+            return req;
+        }
 
+        BBO parseBBO(const HttpResponse& res) override {
+            try {
                 if (res.statusCode != 200) {
                     std::cerr << "[ERROR] Exception fetching BBO for " << this->name << " details: " << res.body << std::endl;
                     return BBO();
                 }
 
-                json data = json::parse(res.body);
+                DepthScanner scanner(res.body);
                 BBO bbo;
 
-                double bidPrice = std::stod(data["bids"][0][0].get<std::string>());
-                double bidSize = std::stod(data["bids"][0][1].get<std::string>());
-
-                double askPrice = std::stod(data["asks"][0][0].get<std::string>());
-                double askSize = std::stod(data["asks"][0][1].get<std::string>());
-
-                bbo.bid = PriceLevel{bidPrice, bidSize};
-                bbo.ask = PriceLevel{askPrice, askSize};
+                if (!scanner.seek("bids") || !scanner.nextLevel(bbo.bid.price, bbo.bid.size) ||
+                    !scanner.seek("asks") || !scanner.nextLevel(bbo.ask.price, bbo.ask.size)) {
+                    throw std::runtime_error("malformed depth response");
+                }
 
                 auto now = std::chrono::system_clock::now();
                 bbo.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -65,4 +64,35 @@ class BinanceTool : public IExchange {
                 return BBO();
             }
         }
+
+        OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            try {
+                if (res.statusCode != 200) {
+                    std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << res.body << std::endl;
+                    return OrderBook();
+                }
+
+                DepthScanner scanner(res.body);
+                OrderBook book(depth);
+
+                uint64_t sequence = 0;
+                if (scanner.seek("lastUpdateId")) scanner.readUint(sequence);
+
+                // Document order: lastUpdateId, bids, asks
+                std::vector<PriceLevel> bids = readLevels(scanner, "bids", depth);
+                std::vector<PriceLevel> asks = readLevels(scanner, "asks", depth);
+                book.loadSnapshot(bids, asks, sequence);
+
+                auto now = std::chrono::system_clock::now();
+                book.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now.time_since_epoch()
+                ).count();
+
+                return book;
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << e.what() << std::endl;
+                return OrderBook();
+            }
+        }
 };
@@ -1,4 +1,5 @@
 #include "../interface.hpp"
+#include "../../utils/depth_scanner.hpp"
 #include <cstdint>
 #include <exception>
 #include <string>
@@ -9,6 +10,8 @@ class ByBitTool : public IExchange {
         ByBitTool(std::string url = "https://api.bybit.com/v5") {
             this->url = url;
             this->name = Exchange::BYBIT;
+            this->takerFee = 0.001;
+            this->requestInterval = 20;
         }
 
         std::string getTicker(Token& base, Token& quote) override {
@@ -17,36 +20,32 @@ class ByBitTool : public IExchange {
             return ss.str();
         }
 
-        BBO getBBO(Token base, Token quote) override {
-            try {
-                auto& http = getHttp();
-
-                const std::string depthsUrl = this->url + "/market/orderbook?category=spot&symbol=" + getTicker(base, quote);
-                HttpRequestOptions options;
-                options.headers = {
-                    {"Accept", "application/json"}
-                };
+        HttpRequest depthRequest(Token base, Token quote, size_t depth) override {
+            HttpRequest req;
+            req.url = this->url + "/market/orderbook?category=spot&symbol=" + getTicker(base, quote) + "&limit=" + std::to_string(depth);
+            req.options.headers = {
+                {"Accept", "application/json"}
+            };
 
-                HttpResponse res = http.fetch(depthsUrl, options);
+            return req;
+        }
 
+        BBO parseBBO(const HttpResponse& res) override {
+            try {
                 if (res.statusCode != 200) {
                     std::cerr << "[ERROR] Exception fetching BBO for " << this->name << " details: " << res.body << std::endl;
                     return BBO();
                 }
 
-                json data = json::parse(res.body);
+                DepthScanner scanner(res.body);
                 BBO bbo;
 
-                double bidPrice = std::stod(data["result"]["b"][0][0].get<std::string>());
-                double bidSize = std::stod(data["result"]["b"][0][1].get<std::string>());
-
-                double askPrice = std::stod(data["result"]["a"][0][0].get<std::string>());
-                double askSize = std::stod(data["result"]["a"][0][1].get<std::string>());
-
-                bbo.bid = PriceLevel{bidPrice, bidSize};
-                bbo.ask = PriceLevel{askPrice, askSize};
-
-                bbo.timestamp = data["time"];
+                // Document order: a, b, ..., time
+                if (!scanner.seek("a") || !scanner.nextLevel(bbo.ask.price, bbo.ask.size) ||
+                    !scanner.seek("b") || !scanner.nextLevel(bbo.bid.price, bbo.bid.size) ||
+                    !scanner.seek("time") || !scanner.readUint(bbo.timestamp)) {
+                    throw std::runtime_error("malformed depth response");
+                }
 
                 return bbo;
 
@@ -56,4 +55,30 @@ class ByBitTool : public IExchange {
             }
         }
 
+        OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            try {
+                if (res.statusCode != 200) {
+                    std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << res.body << std::endl;
+                    return OrderBook();
+                }
+
+                DepthScanner scanner(res.body);
+                OrderBook book(depth);
+
+                // Document order: a, b, ts, u
+                std::vector<PriceLevel> asks = readLevels(scanner, "a", depth);
+                std::vector<PriceLevel> bids = readLevels(scanner, "b", depth);
+                if (scanner.seek("ts")) scanner.readUint(book.timestamp);
+                uint64_t sequence = 0;
+                if (scanner.seek("u")) scanner.readUint(sequence);
+
+                book.loadSnapshot(bids, asks, sequence);
+
+                return book;
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << e.what() << std::endl;
+                return OrderBook();
+            }
+        }
 };
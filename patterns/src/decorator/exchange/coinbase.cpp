@@ -1,4 +1,5 @@
 #include "../interface.hpp"
+#include "../../utils/depth_scanner.hpp"
 #include <cstdint>
 #include <exception>
 #include <vector>
@@ -10,6 +11,8 @@ class CoinBaseTool : public IExchange {
         CoinBaseTool(std::string url = "https://api.exchange.coinbase.com/products") {
             this->url = url;
             this->name = Exchange::COINBASE;
+            this->takerFee = 0.006;
+            this->requestInterval = 100;
         }
 
         std::string getTicker(Token& base, Token& quote) override {
@@ -24,35 +27,32 @@ class CoinBaseTool : public IExchange {
             return ss.str();
         }
 
-        BBO getBBO(Token base, Token quote) override {
-            try {
-                auto& http = getHttp();
-
-                const std::string depthsUrl = this->url + "/" + getTicker(base, quote) + "/book";
-                HttpRequestOptions options;
-                options.headers = {
-                    {"Content-Type", "application/json"},
-                    {"User-Agent", "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/132.0.0.0 Safari/537.36"}
-                };
+        HttpRequest depthRequest(Token base, Token quote, size_t depth) override {
+            HttpRequest req;
+            // level=1 is the best bid/ask only, level=2 the aggregated full book
+            req.url = this->url + "/" + getTicker(base, quote) + "/book?level=" + (depth > 1 ? "2" : "1");
+            req.options.headers = {
+                {"Content-Type", "application/json"},
+                {"User-Agent", "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/132.0.0.0 Safari/537.36"}
+            };
 
-                HttpResponse res = http.fetch(depthsUrl, options);
+            return req;
+        }
 
+        BBO parseBBO(const HttpResponse& res) override {
+            try {
                 if (res.statusCode != 200) {
                     std::cerr << "[ERROR] Exception fetching BBO for " << this->name << " details: " << res.body << std::endl;
                     return BBO();
                 }
 
-                json data = json::parse(res.body);
+                DepthScanner scanner(res.body);
                 BBO bbo;
 
-                double bidPrice = std::stod(data["bids"][0][0].get<std::string>());
-                double bidSize = std::stod(data["bids"][0][1].get<std::string>());
-
-                double askPrice = std::stod(data["asks"][0][0].get<std::string>());
-                double askSize = std::stod(data["asks"][0][1].get<std::string>());
-
-                bbo.bid = PriceLevel{bidPrice, bidSize};
-                bbo.ask = PriceLevel{askPrice, askSize};
+                if (!scanner.seek("bids") || !scanner.nextLevel(bbo.bid.price, bbo.bid.size) ||
+                    !scanner.seek("asks") || !scanner.nextLevel(bbo.ask.price, bbo.ask.size)) {
+                    throw std::runtime_error("malformed depth response");
+                }
 
                 auto now = std::chrono::system_clock::now();
                 bbo.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -67,4 +67,34 @@ class CoinBaseTool : public IExchange {
             }
         }
 
+        OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            try {
+                if (res.statusCode != 200) {
+                    std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << res.body << std::endl;
+                    return OrderBook();
+                }
+
+                DepthScanner scanner(res.body);
+                OrderBook book(depth);
+
+                // Document order: bids, asks, sequence
+                std::vector<PriceLevel> bids = readLevels(scanner, "bids", depth);
+                std::vector<PriceLevel> asks = readLevels(scanner, "asks", depth);
+                uint64_t sequence = 0;
+                if (scanner.seek("sequence")) scanner.readUint(sequence);
+
+                book.loadSnapshot(bids, asks, sequence);
+
+                auto now = std::chrono::system_clock::now();
+                book.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now.time_since_epoch()
+                ).count();
+
+                return book;
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << e.what() << std::endl;
+                return OrderBook();
+            }
+        }
 };
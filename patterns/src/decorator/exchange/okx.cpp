@@ -1,4 +1,5 @@
 #include "../interface.hpp"
+#include "../../utils/depth_scanner.hpp"
 #include <cstdint>
 #include <exception>
 #include <sstream>
@@ -8,6 +9,8 @@ class OkxTool : public IExchange {
         OkxTool(std::string url = "https://www.okx.com/api/v5") {
             this->url = url;
             this->name = Exchange::OKX;
+            this->takerFee = 0.001;
+            this->requestInterval = 100;
         }
 
         std::string getTicker(Token& base, Token& quote) override {
@@ -16,38 +19,32 @@ class OkxTool : public IExchange {
             return ss.str();
         }
 
-        BBO getBBO(Token base, Token quote) override {
-            try {
-                auto& http = getHttp();
-
-                const std::string depthsUrl = this->url + "/market/books?instId=" + getTicker(base, quote);
-                HttpRequestOptions options;
-                options.headers = {
-                    {"Accept", "application/json"},
-                };
+        HttpRequest depthRequest(Token base, Token quote, size_t depth) override {
+            HttpRequest req;
+            req.url = this->url + "/market/books?instId=" + getTicker(base, quote) + "&sz=" + std::to_string(depth);
+            req.options.headers = {
+                {"Accept", "application/json"},
+            };
 
-                HttpResponse res = http.fetch(depthsUrl, options);
+            return req;
+        }
 
+        BBO parseBBO(const HttpResponse& res) override {
+            try {
                 if (res.statusCode != 200) {
                     std::cerr << "[ERROR] Exception fetching BBO for " << this->name << " details: " << res.body << std::endl;
                     return BBO();
                 }
 
-                json data = json::parse(res.body);
+                DepthScanner scanner(res.body);
                 BBO bbo;
 
-                const auto& orderbook = data["data"][0];
-
-                double bidPrice = std::stod(orderbook["bids"][0][0].get<std::string>());
-                double bidSize = std::stod(orderbook["bids"][0][1].get<std::string>());
-
-                double askPrice = std::stod(orderbook["asks"][0][0].get<std::string>());
-                double askSize = std::stod(orderbook["asks"][0][1].get<std::string>());
-
-                bbo.bid = PriceLevel{bidPrice, bidSize};
-                bbo.ask = PriceLevel{askPrice, askSize};
-
-                bbo.timestamp = std::stoull(orderbook["ts"].get<std::string>());
+                // Document order: asks, bids, ts
+                if (!scanner.seek("asks") || !scanner.nextLevel(bbo.ask.price, bbo.ask.size) ||
+                    !scanner.seek("bids") || !scanner.nextLevel(bbo.bid.price, bbo.bid.size) ||
+                    !scanner.seek("ts") || !scanner.readUint(bbo.timestamp)) {
+                    throw std::runtime_error("malformed depth response");
+                }
 
                 return bbo;
 
@@ -57,4 +54,27 @@ class OkxTool : public IExchange {
             }
         }
 
+        OrderBook parseBook(const HttpResponse& res, size_t depth) override {
+            try {
+                if (res.statusCode != 200) {
+                    std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << res.body << std::endl;
+                    return OrderBook();
+                }
+
+                DepthScanner scanner(res.body);
+                OrderBook book(depth);
+
+                // Document order: asks, bids, ts
+                std::vector<PriceLevel> asks = readLevels(scanner, "asks", depth);
+                std::vector<PriceLevel> bids = readLevels(scanner, "bids", depth);
+                book.loadSnapshot(bids, asks);
+                if (scanner.seek("ts")) scanner.readUint(book.timestamp);
+
+                return book;
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << e.what() << std::endl;
+                return OrderBook();
+            }
+        }
 };
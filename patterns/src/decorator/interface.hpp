@@ -4,13 +4,12 @@
 #include <string>
 #include <ctime>
 #include <format>
+#include <map>
+#include <tuple>
 #include <vector>
 #include "../utils/http.hpp"
-
-struct PriceLevel {
-    double price;
-    double size;
-};
+#include "../utils/depth_scanner.hpp"
+#include "orderbook.hpp"
 
 struct BBO {
     PriceLevel bid;
@@ -31,7 +30,38 @@ enum class Token {
     BTC,
     ETH,
     USDC,
-    USDT
+    USDT,
+    SOL,
+    XRP,
+    DOGE,
+    ADA,
+    AVAX,
+    LINK,
+    DOT,
+    LTC,
+    BNB,
+    TRX,
+    BCH,
+    NEAR,
+    ATOM,
+    UNI,
+    APT,
+    ARB,
+    OP,
+    SUI,
+    PEPE,
+    SHIB,
+    FIL,
+    ETC,
+    XLM,
+    INJ,
+    AAVE,
+    TON
+};
+
+struct Symbol {
+    Token base;
+    Token quote;
 };
 
 inline std::ostream& operator<<(std::ostream& os, Exchange ex) {
@@ -52,21 +82,62 @@ inline std::ostream& operator<<(std::ostream& os, Token token) {
         case Token::ETH: return os << "ETH";
         case Token::USDC: return os << "USDC";
         case Token::USDT: return os << "USDT";
+        case Token::SOL: return os << "SOL";
+        case Token::XRP: return os << "XRP";
+        case Token::DOGE: return os << "DOGE";
+        case Token::ADA: return os << "ADA";
+        case Token::AVAX: return os << "AVAX";
+        case Token::LINK: return os << "LINK";
+        case Token::DOT: return os << "DOT";
+        case Token::LTC: return os << "LTC";
+        case Token::BNB: return os << "BNB";
+        case Token::TRX: return os << "TRX";
+        case Token::BCH: return os << "BCH";
+        case Token::NEAR: return os << "NEAR";
+        case Token::ATOM: return os << "ATOM";
+        case Token::UNI: return os << "UNI";
+        case Token::APT: return os << "APT";
+        case Token::ARB: return os << "ARB";
+        case Token::OP: return os << "OP";
+        case Token::SUI: return os << "SUI";
+        case Token::PEPE: return os << "PEPE";
+        case Token::SHIB: return os << "SHIB";
+        case Token::FIL: return os << "FIL";
+        case Token::ETC: return os << "ETC";
+        case Token::XLM: return os << "XLM";
+        case Token::INJ: return os << "INJ";
+        case Token::AAVE: return os << "AAVE";
+        case Token::TON: return os << "TON";
     }
     return os;
 }
 
+inline std::ostream& operator<<(std::ostream& os, const Symbol& symbol) {
+    return os << symbol.base << "/" << symbol.quote;
+}
+
+inline BBO toBBO(const OrderBook& book) {
+    BBO bbo{};
+    if (book.bestBid()) bbo.bid = *book.bestBid();
+    if (book.bestAsk()) bbo.ask = *book.bestAsk();
+    bbo.timestamp = book.timestamp;
+    return bbo;
+}
+
 class Arber {
     private:
         bool execute;
 
     public:
+        Symbol symbol{};
         Exchange buyExchange;
         Exchange sellExchange;
         double profit;
         double amount;
         BBO buyBBO;
         BBO sellBBO;
+        double buyVwap = 0;
+        double sellVwap = 0;
 
         Arber(
             Exchange buyExchange,
@@ -87,15 +158,80 @@ class IExchange {
     private:
         HttpClient http;
 
+        // getBook's polling state: a request prepared once per (base, quote,
+        // depth), and a response whose body keeps its capacity across polls
+        std::map<std::tuple<Token, Token, size_t>, PreparedRequest> prepared;
+        HttpBuffer pollBuffer;
+        HttpResponse polled;
+
     protected:
         HttpClient& getHttp() {return http;}
 
+        // Reads up to depth levels of the array under key, best first
+        static std::vector<PriceLevel> readLevels(DepthScanner& scanner, const char* key, size_t depth) {
+            std::vector<PriceLevel> levels;
+            levels.reserve(depth);
+
+            PriceLevel level;
+            if (scanner.seek(key)) {
+                while (levels.size() < depth && scanner.nextLevel(level.price, level.size)) {
+                    levels.push_back(level);
+                }
+            }
+            return levels;
+        }
+
     public:
         std::string url;
         Exchange name;
+        double takerFee = 0;  // fraction of notional, e.g. 0.001 = 10 bps
+        int requestInterval = 100;  // ms between depth requests, within the venue's public rate limit
 
-        virtual BBO getBBO(Token base, Token quote) = 0;
+        // Fetching and parsing are split so a caller can issue the depth
+        // requests of several venues at once through HttpClient::fetchAll
+        // and hand each response back to its exchange for parsing.
+        virtual HttpRequest depthRequest(Token base, Token quote, size_t depth) = 0;
+        virtual BBO parseBBO(const HttpResponse& res) = 0;
+        virtual OrderBook parseBook(const HttpResponse& res, size_t depth) = 0;
         virtual std::string getTicker(Token& base, Token& quote) = 0;
 
+        virtual BBO getBBO(Token base, Token quote) {
+            try {
+                HttpRequest req = depthRequest(base, quote, 1);
+                return parseBBO(getHttp().fetch(req.url, req.options));
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching BBO for " << this->name << " details: " << e.what() << std::endl;
+                return BBO();
+            }
+        }
+
+        // Up to depth levels per side. Empty book on failure. Goes through
+        // HttpClient::fetchInto, so one thread per exchange at a time, as
+        // the bot's pollers call it.
+        virtual OrderBook getBook(Token base, Token quote, size_t depth) {
+            try {
+                auto key = std::make_tuple(base, quote, depth);
+                auto it = prepared.find(key);
+                if (it == prepared.end()) {
+                    HttpRequest req = depthRequest(base, quote, depth);
+                    it = prepared.try_emplace(key, req.url, req.options).first;
+                }
+                getHttp().fetchInto(it->second, pollBuffer);
+
+                // parseBook reads an HttpResponse: lend it the buffer's body
+                // (a swap, not a copy) and take it back for the next poll
+                polled.statusCode = pollBuffer.statusCode;
+                polled.body.swap(pollBuffer.body);
+                OrderBook book = parseBook(polled, depth);
+                polled.body.swap(pollBuffer.body);
+                return book;
+
+            } catch(const std::exception& e) {
+                std::cerr << "[ERROR] Exception fetching book for " << this->name << " details: " << e.what() << std::endl;
+                return OrderBook();
+            }
+        }
+
         virtual ~IExchange() = default;
 };
@@ -51,10 +51,20 @@ int main() {
         )
     );
 
+    std::vector<Symbol> symbols = {
+        {Token::BTC, Token::USDT}, {Token::BTC, Token::USDC},
+        {Token::ETH, Token::USDT}, {Token::ETH, Token::USDC},
+        {Token::SOL, Token::USDT}, {Token::SOL, Token::USDC},
+        {Token::XRP, Token::USDT}, {Token::DOGE, Token::USDT},
+        {Token::ADA, Token::USDT}, {Token::AVAX, Token::USDT},
+        {Token::LINK, Token::USDT}, {Token::LTC, Token::USDT},
+        {Token::USDC, Token::USDT}
+    };
+
     std::cout << "Press Ctrl+C to stop the bot" << std::endl;
 
-    std::thread bot_thread([&bot]() {
-        bot->run(Token::BTC, Token::USDC, 1000);
+    std::thread bot_thread([&bot, &symbols]() {
+        bot->watch(symbols, 2000);  // ignore quotes older than 2s
     });
 
     while (!stop_flag) {
@@ -62,8 +72,8 @@ int main() {
     }
 
     bot->stop();
-    delete bot;
     bot_thread.join();
+    delete bot;
 
     std::cout << "\nBot stopped successfully" << std::endl;
 
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct PriceLevel {
+    double price;
+    double size;
+};
+
+enum class Side {
+    BID,
+    ASK
+};
+
+/**
+    L2 order book on two sorted flat arrays instead of node-based maps.
+
+    Each side is kept with its best level at the back: bids ascending, asks
+    descending. Best bid/ask is then back(), O(1), and since almost all
+    updates land near the touch, an insert or delete only shifts the few
+    levels behind it. Levels are contiguous, so depth walks stay in cache.
+*/
+class OrderBook {
+    private:
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+        uint64_t sequence = 0;
+
+        std::vector<PriceLevel>& levels(Side side) { return side == Side::BID ? bids : asks; }
+        const std::vector<PriceLevel>& levels(Side side) const { return side == Side::BID ? bids : asks; }
+
+        static bool worse(Side side, double a, double b) {
+            return side == Side::BID ? a < b : a > b;
+        }
+
+        // First position whose price is not worse than price: the slot where
+        // price lives or would be inserted. Probes the few levels at the
+        // touch linearly before falling back to a binary search.
+        static std::vector<PriceLevel>::iterator find(std::vector<PriceLevel>& book, Side side, double price) {
+            static constexpr size_t TOUCH_PROBE = 8;
+
+            size_t probe = std::min(book.size(), TOUCH_PROBE);
+            auto it = book.end();
+            for (size_t i = 0; i < probe; ++i, --it) {
+                if (worse(side, (it - 1)->price, price)) return it;
+            }
+
+            return std::lower_bound(book.begin(), it, price,
+                [side](const PriceLevel& level, double p) { return worse(side, level.price, p); });
+        }
+
+    public:
+        uint64_t timestamp = 0;
+
+        explicit OrderBook(size_t capacity = 256) {
+            bids.reserve(capacity);
+            asks.reserve(capacity);
+        }
+
+        void clear() {
+            bids.clear();
+            asks.clear();
+            sequence = 0;
+        }
+
+        // Levels in venue order, best first
+        void loadSnapshot(const std::vector<PriceLevel>& bidLevels, const std::vector<PriceLevel>& askLevels, uint64_t seq = 0) {
+            bids.assign(bidLevels.rbegin(), bidLevels.rend());
+            asks.assign(askLevels.rbegin(), askLevels.rend());
+            sequence = seq;
+        }
+
+        // Sets the size at price; size 0 removes the level
+        void apply(Side side, double price, double size) {
+            std::vector<PriceLevel>& book = levels(side);
+            auto it = find(book, side, price);
+            bool exists = it != book.end() && it->price == price;
+
+            if (size <= 0) {
+                if (exists) book.erase(it);
+            } else if (exists) {
+                it->size = size;
+            } else {
+                book.insert(it, PriceLevel{price, size});
+            }
+        }
+
+        // Applies an update carrying the venue's sequence number. Stale
+        // updates (at or before the current sequence) are ignored.
+        bool apply(Side side, double price, double size, uint64_t seq) {
+            if (seq <= sequence) return false;
+            apply(side, price, size);
+            sequence = seq;
+            return true;
+        }
+
+        const PriceLevel* bestBid() const { return bids.empty() ? nullptr : &bids.back(); }
+        const PriceLevel* bestAsk() const { return asks.empty() ? nullptr : &asks.back(); }
+
+        size_t depth(Side side) const { return levels(side).size(); }
+
+        // n-th level from the touch, 0 = best. n must be < depth(side).
+        const PriceLevel& level(Side side, size_t n) const {
+            const std::vector<PriceLevel>& book = levels(side);
+            return book[book.size() - 1 - n];
+        }
+
+        // Copies up to n levels from the touch into out, returns the count
+        size_t top(Side side, size_t n, PriceLevel* out) const {
+            const std::vector<PriceLevel>& book = levels(side);
+            size_t count = std::min(n, book.size());
+            std::copy(book.rbegin(), book.rbegin() + count, out);
+            return count;
+        }
+
+        uint64_t getSequence() const { return sequence; }
+        bool empty() const { return bids.empty() || asks.empty(); }
+};
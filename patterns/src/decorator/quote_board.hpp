@@ -0,0 +1,157 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "interface.hpp"
+
+inline uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+    Latest book for every (symbol, exchange), written by one poller thread
+    per exchange and read by the evaluator without locks.
+
+    Each slot is a seqlock: the writer makes the sequence odd, stores the
+    levels, then makes it even again; a reader retries if the sequence was
+    odd or moved while it copied. Writers never wait on readers and a
+    reader only spins for the few hundred nanoseconds of a concurrent
+    publish. Fields are relaxed atomics so the torn copies a reader throws
+    away are not data races.
+
+    Every publish bumps a board-wide version, which the evaluator blocks
+    on (std::atomic::wait) instead of polling on a timer.
+*/
+class QuoteBoard {
+    public:
+        static constexpr size_t MAX_DEPTH = 20;
+
+    private:
+        struct alignas(64) Slot {
+            std::atomic<uint64_t> seq{0};
+            std::atomic<uint64_t> updatedAt{0};  // nowNanos() of the publish, 0 = never
+            std::atomic<uint32_t> depth[2]{};
+            std::atomic<double> price[2][MAX_DEPTH]{};
+            std::atomic<double> size[2][MAX_DEPTH]{};
+        };
+
+        size_t exchangeCount;
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<uint64_t> version{0};
+
+        Slot& slot(size_t symbol, size_t exchange) { return slots[symbol * exchangeCount + exchange]; }
+        const Slot& slot(size_t symbol, size_t exchange) const { return slots[symbol * exchangeCount + exchange]; }
+
+        // Runs copy() until it saw a consistent slot, returns its timestamp
+        template<typename Copy>
+        static uint64_t readConsistent(const Slot& s, Copy&& copy) {
+            while (true) {
+                uint64_t before = s.seq.load(std::memory_order_acquire);
+                if (before & 1) continue;  // publish in progress
+
+                uint64_t updatedAt = s.updatedAt.load(std::memory_order_relaxed);
+                copy();
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) == before) return updatedAt;
+            }
+        }
+
+    public:
+        QuoteBoard(size_t symbolCount, size_t exchangeCount)
+            : exchangeCount(exchangeCount), slots(new Slot[symbolCount * exchangeCount]) {}
+
+        // Single writer per slot: only the exchange's own poller publishes
+        void publish(size_t symbol, size_t exchange, const OrderBook& book, uint64_t receivedAt) {
+            Slot& s = slot(symbol, exchange);
+            uint64_t seq = s.seq.load(std::memory_order_relaxed);
+
+            s.seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (Side side : {Side::BID, Side::ASK}) {
+                int i = static_cast<int>(side);
+                size_t depth = std::min(book.depth(side), MAX_DEPTH);
+
+                for (size_t n = 0; n < depth; ++n) {
+                    const PriceLevel& level = book.level(side, n);
+                    s.price[i][n].store(level.price, std::memory_order_relaxed);
+                    s.size[i][n].store(level.size, std::memory_order_relaxed);
+                }
+                s.depth[i].store(static_cast<uint32_t>(depth), std::memory_order_relaxed);
+            }
+            s.updatedAt.store(receivedAt, std::memory_order_relaxed);
+
+            s.seq.store(seq + 2, std::memory_order_release);
+
+            version.fetch_add(1, std::memory_order_release);
+            version.notify_all();
+        }
+
+        // Best bid and ask of the slot; returns when they were published
+        // (0 if never, bbo then left empty)
+        uint64_t readTop(size_t symbol, size_t exchange, BBO& out) const {
+            const Slot& s = slot(symbol, exchange);
+
+            return readConsistent(s, [&] {
+                out = BBO{};
+                if (s.depth[0].load(std::memory_order_relaxed) > 0) {
+                    out.bid = PriceLevel{s.price[0][0].load(std::memory_order_relaxed), s.size[0][0].load(std::memory_order_relaxed)};
+                }
+                if (s.depth[1].load(std::memory_order_relaxed) > 0) {
+                    out.ask = PriceLevel{s.price[1][0].load(std::memory_order_relaxed), s.size[1][0].load(std::memory_order_relaxed)};
+                }
+            });
+        }
+
+        // Full slot into out (levels scratch reused across calls)
+        uint64_t readBook(size_t symbol, size_t exchange, OrderBook& out) const {
+            const Slot& s = slot(symbol, exchange);
+            thread_local std::vector<PriceLevel> levels[2];
+
+            uint64_t updatedAt = readConsistent(s, [&] {
+                for (int i = 0; i < 2; ++i) {
+                    size_t depth = std::min<size_t>(s.depth[i].load(std::memory_order_relaxed), MAX_DEPTH);
+                    levels[i].resize(depth);
+                    for (size_t n = 0; n < depth; ++n) {
+                        levels[i][n] = PriceLevel{
+                            s.price[i][n].load(std::memory_order_relaxed),
+                            s.size[i][n].load(std::memory_order_relaxed)
+                        };
+                    }
+                }
+            });
+
+            out.loadSnapshot(levels[0], levels[1]);
+            out.timestamp = updatedAt;
+            return updatedAt;
+        }
+
+        // Whether a slot published at updatedAt is at most maxAge old at now.
+        // A poller can publish after the evaluator read now, so updatedAt
+        // may be ahead of it; that slot is as fresh as it gets.
+        static bool isFresh(uint64_t updatedAt, uint64_t now, uint64_t maxAge) {
+            if (updatedAt == 0) return false;
+            return (updatedAt > now ? 0 : now - updatedAt) <= maxAge;
+        }
+
+        uint64_t getVersion() const {
+            return version.load(std::memory_order_acquire);
+        }
+
+        // Blocks until the board has changed since seen, returns the new version
+        uint64_t waitForChange(uint64_t seen) const {
+            version.wait(seen, std::memory_order_acquire);
+            return version.load(std::memory_order_acquire);
+        }
+
+        // Releases waitForChange without publishing, e.g. on shutdown
+        void wake() {
+            version.fetch_add(1, std::memory_order_release);
+            version.notify_all();
+        }
+};
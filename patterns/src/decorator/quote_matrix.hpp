@@ -0,0 +1,227 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "interface.hpp"
+
+struct CrossOpportunity {
+    uint32_t symbol;
+    uint32_t buyExchange;
+    uint32_t sellExchange;
+    double profitPercent;  // after taker fees
+    double quantity;       // top-of-book, base units
+};
+
+// Starts and ends in first's quote currency: buy `first` at its ask, sell
+// the base on `second` at its bid, then convert back through `bridge`.
+struct TriangleOpportunity {
+    uint32_t exchange;
+    uint32_t first;
+    uint32_t second;
+    uint32_t bridge;
+    double profitPercent;  // after three taker fees
+};
+
+/**
+    Latest top-of-book for every (symbol, exchange), stored as four flat
+    arrays (bid/ask price and size) with one contiguous column of symbols
+    per exchange.
+
+    Cross-exchange scan: the first pass reduces every exchange column into
+    per-symbol max(bid * (1 - fee)) and min(ask * (1 + fee)), a straight
+    loop over contiguous doubles that the compiler vectorizes across
+    symbols. Only symbols where the two cross are expanded into their
+    profitable (buy, sell) pairs, so a quiet symbol costs a few nanoseconds.
+    Missing quotes are stored as bid 0 / ask +inf, which can never cross,
+    so neither pass branches on them.
+
+    Triangular scan: triangles over quote currencies (e.g. BTC/USDT,
+    BTC/USDC, USDC/USDT) are found once from the symbol list and evaluated
+    per exchange.
+*/
+class QuoteMatrix {
+    private:
+        struct Triangle {
+            uint32_t first, second, bridge;
+            bool bridgeInverted;  // bridge quoted as from/to rather than to/from
+        };
+
+        std::vector<Symbol> symbols;
+        size_t exchangeCount;
+
+        std::vector<double> bidPx, bidSz, askPx, askSz;
+        std::vector<double> buyFactor;   // 1 + fee
+        std::vector<double> sellFactor;  // 1 - fee
+        std::vector<Triangle> triangles;
+
+        // Per-symbol best net bid / ask, scratch for scanCross
+        mutable std::vector<double> bestBid, bestAsk;
+
+        size_t index(size_t symbol, size_t exchange) const { return exchange * symbols.size() + symbol; }
+
+        int find(Token base, Token quote) const {
+            for (size_t s = 0; s < symbols.size(); ++s) {
+                if (symbols[s].base == base && symbols[s].quote == quote) return static_cast<int>(s);
+            }
+            return -1;
+        }
+
+        void buildTriangles() {
+            for (size_t a = 0; a < symbols.size(); ++a) {
+                for (size_t b = 0; b < symbols.size(); ++b) {
+                    if (a == b || symbols[a].base != symbols[b].base || symbols[a].quote == symbols[b].quote) continue;
+
+                    // Buy base with quote A, sell it for quote B, convert B back to A
+                    Token from = symbols[a].quote;
+                    Token to = symbols[b].quote;
+
+                    int bridge = find(to, from);
+                    if (bridge >= 0) {
+                        triangles.push_back({uint32_t(a), uint32_t(b), uint32_t(bridge), false});
+                    } else if ((bridge = find(from, to)) >= 0) {
+                        triangles.push_back({uint32_t(a), uint32_t(b), uint32_t(bridge), true});
+                    }
+                }
+            }
+        }
+
+        // Every profitable (buy, sell) pair of a crossed symbol. Kept out of
+        // scanCross so the screening loop stays small.
+        size_t expand(size_t s, double hurdle, std::vector<CrossOpportunity>& out) const {
+            size_t found = 0;
+
+            for (size_t buy = 0; buy < exchangeCount; ++buy) {
+                double cost = askPx[index(s, buy)] * buyFactor[buy];
+
+                for (size_t sell = 0; sell < exchangeCount; ++sell) {
+                    double proceeds = bidPx[index(s, sell)] * sellFactor[sell];
+                    if (buy == sell || proceeds <= cost * hurdle) continue;
+
+                    out.push_back({
+                        uint32_t(s), uint32_t(buy), uint32_t(sell),
+                        (proceeds - cost) / cost * 100,
+                        std::min(askSz[index(s, buy)], bidSz[index(s, sell)])
+                    });
+                    found++;
+                }
+            }
+
+            return found;
+        }
+
+    public:
+        QuoteMatrix(std::vector<Symbol> symbolList, const std::vector<double>& takerFees)
+            : symbols(std::move(symbolList)), exchangeCount(takerFees.size()),
+              bidPx(symbols.size() * exchangeCount, 0),
+              bidSz(symbols.size() * exchangeCount, 0),
+              askPx(symbols.size() * exchangeCount, std::numeric_limits<double>::infinity()),
+              askSz(symbols.size() * exchangeCount, 0),
+              bestBid(symbols.size()), bestAsk(symbols.size()) {
+            for (double fee : takerFees) {
+                buyFactor.push_back(1 + fee);
+                sellFactor.push_back(1 - fee);
+            }
+            buildTriangles();
+        }
+
+        const std::vector<Symbol>& symbolList() const { return symbols; }
+        size_t symbolCount() const { return symbols.size(); }
+        size_t exchanges() const { return exchangeCount; }
+        size_t triangleCount() const { return triangles.size(); }
+        const Symbol& symbol(size_t s) const { return symbols[s]; }
+
+        void set(size_t symbol, size_t exchange, const BBO& bbo) {
+            size_t i = index(symbol, exchange);
+            bool valid = bbo.bid.price > 0 && bbo.ask.price > 0;
+
+            bidPx[i] = valid ? bbo.bid.price : 0;
+            bidSz[i] = valid ? bbo.bid.size : 0;
+            askPx[i] = valid ? bbo.ask.price : std::numeric_limits<double>::infinity();
+            askSz[i] = valid ? bbo.ask.size : 0;
+        }
+
+        void clear(size_t symbol, size_t exchange) {
+            set(symbol, exchange, BBO{});
+        }
+
+        BBO get(size_t symbol, size_t exchange) const {
+            size_t i = index(symbol, exchange);
+            BBO bbo{};
+            if (bidPx[i] > 0) {
+                bbo.bid = PriceLevel{bidPx[i], bidSz[i]};
+                bbo.ask = PriceLevel{askPx[i], askSz[i]};
+            }
+            return bbo;
+        }
+
+        // Appends every cross-exchange pair clearing minProfit (percent,
+        // after fees) and returns how many were found
+        size_t scanCross(double minProfit, std::vector<CrossOpportunity>& out) const {
+            double hurdle = 1 + minProfit / 100;
+            size_t count = symbols.size();
+            size_t found = 0;
+
+            double* maxBid = bestBid.data();
+            double* minAsk = bestAsk.data();
+            std::fill(maxBid, maxBid + count, 0.0);
+            std::fill(minAsk, minAsk + count, std::numeric_limits<double>::infinity());
+
+            for (size_t e = 0; e < exchangeCount; ++e) {
+                const double* bid = bidPx.data() + index(0, e);
+                const double* ask = askPx.data() + index(0, e);
+                double sell = sellFactor[e];
+                double buy = buyFactor[e] * hurdle;
+
+                for (size_t s = 0; s < count; ++s) {
+                    maxBid[s] = std::max(maxBid[s], bid[s] * sell);
+                    minAsk[s] = std::min(minAsk[s], ask[s] * buy);
+                }
+            }
+
+            // Branch-free count first: almost every scan ends here
+            size_t crossed = 0;
+            for (size_t s = 0; s < count; ++s) {
+                crossed += maxBid[s] > minAsk[s];
+            }
+
+            for (size_t s = 0; crossed > 0 && s < count; ++s) {
+                if (maxBid[s] > minAsk[s]) {
+                    found += expand(s, hurdle, out);
+                    crossed--;
+                }
+            }
+
+            return found;
+        }
+
+        // Appends every single-exchange triangle clearing minProfit
+        size_t scanTriangular(double minProfit, std::vector<TriangleOpportunity>& out) const {
+            double hurdle = 1 + minProfit / 100;
+            size_t found = 0;
+
+            // Compared as products so the hot path has no divisions:
+            // sell * bridge * fees > buy * hurdle, or with an inverted
+            // bridge, sell * fees > buy * bridgeAsk * hurdle
+            for (const Triangle& t : triangles) {
+                for (size_t e = 0; e < exchangeCount; ++e) {
+                    double fees = sellFactor[e] * sellFactor[e] * sellFactor[e];
+                    double proceeds = bidPx[index(t.second, e)] * fees;
+                    double cost = askPx[index(t.first, e)];
+
+                    if (t.bridgeInverted) {
+                        cost *= askPx[index(t.bridge, e)];
+                    } else {
+                        proceeds *= bidPx[index(t.bridge, e)];
+                    }
+
+                    if (proceeds > cost * hurdle) {
+                        out.push_back({uint32_t(e), t.first, t.second, t.bridge, (proceeds / cost - 1) * 100});
+                        found++;
+                    }
+                }
+            }
+
+            return found;
+        }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include "orderbook.hpp"
+
+struct Execution {
+    double quantity = 0;    // base units
+    double buyVwap = 0;     // before fees
+    double sellVwap = 0;
+    double cost = 0;        // quote spent on the buy leg, fees included
+    double proceeds = 0;    // quote received on the sell leg, net of fees
+
+    double profit() const { return proceeds - cost; }
+    double profitPercent() const { return cost > 0 ? profit() / cost * 100 : 0; }
+};
+
+/**
+    Largest quantity that can be bought on buyBook's asks and sold into
+    sellBook's bids at a profit, walking both books level by level from the
+    touch.
+
+    A slice is taken only while its marginal edge after taker fees still
+    clears minProfit (percent). Marginal edges only shrink as the walk goes
+    deeper, so stopping at the first failing slice gives the maximum
+    profitable quantity. Works on the in-memory books only: no I/O, no
+    allocation.
+*/
+inline Execution sizeArbitrage(const OrderBook& buyBook, const OrderBook& sellBook,
+                               double buyFee, double sellFee,
+                               double maxQuantity, double minProfit = 0) {
+    Execution exec;
+
+    size_t askDepth = buyBook.depth(Side::ASK);
+    size_t bidDepth = sellBook.depth(Side::BID);
+    if (askDepth == 0 || bidDepth == 0) return exec;
+
+    double hurdle = 1 + minProfit / 100;
+    size_t a = 0, b = 0;
+    double askLeft = buyBook.level(Side::ASK, 0).size;
+    double bidLeft = sellBook.level(Side::BID, 0).size;
+    double notionalBuy = 0, notionalSell = 0;
+
+    while (maxQuantity > 0) {
+        double ask = buyBook.level(Side::ASK, a).price;
+        double bid = sellBook.level(Side::BID, b).price;
+
+        if (bid * (1 - sellFee) <= ask * (1 + buyFee) * hurdle) break;
+
+        double remaining = maxQuantity - exec.quantity;
+        double slice = std::min({askLeft, bidLeft, remaining});
+        exec.quantity += slice;
+        notionalBuy += slice * ask;
+        notionalSell += slice * bid;
+
+        // Compared rather than recomputed so rounding can't leave a sliver
+        if (slice >= remaining) break;
+
+        askLeft -= slice;
+        bidLeft -= slice;
+
+        if (askLeft <= 0) {
+            if (++a == askDepth) break;
+            askLeft = buyBook.level(Side::ASK, a).size;
+        }
+        if (bidLeft <= 0) {
+            if (++b == bidDepth) break;
+            bidLeft = sellBook.level(Side::BID, b).size;
+        }
+    }
+
+    if (exec.quantity > 0) {
+        exec.buyVwap = notionalBuy / exec.quantity;
+        exec.sellVwap = notionalSell / exec.quantity;
+        exec.cost = notionalBuy * (1 + buyFee);
+        exec.proceeds = notionalSell * (1 - sellFee);
+    }
+
+    return exec;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+/**
+    Forward scanner over a raw exchange depth document.
+
+    Instead of building a DOM of every level and reading only level 0, it
+    finds a key, walks its [[price, size, ...], ...] array one level at a
+    time and converts the price strings with std::from_chars. Nothing is
+    allocated and the scan stops as soon as the caller has what it needs.
+
+    seek() continues from where the last read stopped and only goes back
+    to the start when the key is not ahead, so keys read in document order
+    cost a single pass; out of order they still resolve, at the price of a
+    rescan.
+
+    Levels may carry extra elements (order count, liquidation flags) which
+    are skipped. Numbers may be quoted or bare.
+*/
+class DepthScanner {
+    private:
+        std::string_view json;
+        size_t pos = 0;
+        bool inArray = false;
+
+        void skipSpace() {
+            while (pos < json.size() &&
+                   (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r' || json[pos] == '\t')) {
+                ++pos;
+            }
+        }
+
+        bool expect(char c) {
+            skipSpace();
+            if (pos >= json.size() || json[pos] != c) return false;
+            ++pos;
+            return true;
+        }
+
+        // Quoted or bare number token
+        std::string_view token() {
+            skipSpace();
+            if (pos >= json.size()) return {};
+
+            if (json[pos] == '"') {
+                size_t end = json.find('"', pos + 1);
+                if (end == std::string_view::npos) return {};
+                std::string_view value = json.substr(pos + 1, end - pos - 1);
+                pos = end + 1;
+                return value;
+            }
+
+            size_t start = pos;
+            while (pos < json.size() && json[pos] != ',' && json[pos] != ']' && json[pos] != '}' &&
+                   json[pos] != ' ' && json[pos] != '\n' && json[pos] != '\r' && json[pos] != '\t') {
+                ++pos;
+            }
+            return json.substr(start, pos - start);
+        }
+
+        template<typename T>
+        bool number(T& value) {
+            std::string_view tok = token();
+            if (tok.empty()) return false;
+            auto result = std::from_chars(tok.data(), tok.data() + tok.size(), value);
+            return result.ec == std::errc() && result.ptr == tok.data() + tok.size();
+        }
+
+        // Finds "key": with the key starting in [from, to) and moves past it
+        bool find(std::string_view key, size_t from, size_t to) {
+            while (true) {
+                size_t at = json.find(key, from);
+                if (at == std::string_view::npos || at >= to) return false;
+
+                from = at + 1;
+                if (at == 0 || json[at - 1] != '"') continue;
+                if (at + key.size() >= json.size() || json[at + key.size()] != '"') continue;
+
+                // A key, not a string value that happens to match
+                pos = at + key.size() + 1;
+                if (expect(':')) {
+                    skipSpace();
+                    return true;
+                }
+            }
+        }
+
+    public:
+        explicit DepthScanner(std::string_view json) : json(json) {}
+
+        // Positions the scanner on the value of the next "key" after the
+        // current position, or failing that the first one in the document
+        bool seek(std::string_view key) {
+            inArray = false;
+            size_t start = pos;
+            return find(key, start, json.size()) || (start > 0 && find(key, 0, start));
+        }
+
+        // Reads the next level of the array the scanner was seeked to.
+        // Returns false at the end of the array or on malformed input.
+        bool nextLevel(double& price, double& size) {
+            if (!inArray) {
+                if (!expect('[')) return false;
+                inArray = true;
+            } else if (!expect(',')) {
+                return false;
+            }
+
+            if (!expect('[')) return false;
+            if (!number(price) || !expect(',') || !number(size)) return false;
+
+            // Skip whatever else the venue packs into a level
+            size_t end = json.find(']', pos);
+            if (end == std::string_view::npos) return false;
+            pos = end + 1;
+            return true;
+        }
+
+        // Reads the integer value at the current key (quoted or bare)
+        bool readUint(uint64_t& value) {
+            return number(value);
+        }
+};
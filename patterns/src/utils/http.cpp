@@ -2,20 +2,69 @@
 #include <curl/curl.h>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 
-HttpClient::HttpClient() : initialized(false) {
+namespace {
+    std::atomic<uint64_t> nextPreparedId{1};
+}
+
+HttpConnectionPool& HttpConnectionPool::instance() {
+    static HttpConnectionPool pool;
+    return pool;
+}
+
+HttpConnectionPool::HttpConnectionPool() {
     curl_global_init(CURL_GLOBAL_ALL);
+
+    handle = curl_share_init();
+    curl_share_setopt(handle, CURLSHOPT_LOCKFUNC, lock);
+    curl_share_setopt(handle, CURLSHOPT_UNLOCKFUNC, unlock);
+    curl_share_setopt(handle, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    // Not CURL_LOCK_DATA_CONNECT: clients run on their own poller threads,
+    // and libcurl does not support a connection cache shared across threads.
+    // Each client's handles keep their own connections alive instead.
+}
+
+HttpConnectionPool::~HttpConnectionPool() {
+    curl_share_cleanup(handle);
+    curl_global_cleanup();
+}
+
+void HttpConnectionPool::lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+    static_cast<HttpConnectionPool*>(userptr)->locks[data].lock();
+}
+
+void HttpConnectionPool::unlock(CURL*, curl_lock_data data, void* userptr) {
+    static_cast<HttpConnectionPool*>(userptr)->locks[data].unlock();
+}
+
+HttpClient::HttpClient() : configuredFor(0), multi(nullptr), initialized(false) {
+    HttpConnectionPool::instance();
+
     curl = curl_easy_init();
     if (curl) {
-        initialized = true;
+        multi = curl_multi_init();
+        if (multi) {
+            curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            initialized = true;
+        }
     }
 }
 
 HttpClient::~HttpClient() {
+    for (CURL* handle : batchHandles) {
+        curl_easy_cleanup(handle);
+    }
+    if (multi) {
+        curl_multi_cleanup(multi);
+    }
     if (curl) {
         curl_easy_cleanup(curl);
     }
-    curl_global_cleanup();
 }
 
 size_t HttpClient::WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
@@ -31,73 +80,130 @@ size_t HttpClient::HeaderCallback(void* contents, size_t size, size_t nmemb, std
     size_t colonPos = header.find(':');
     if (colonPos != std::string::npos) {
         std::string key = header.substr(0, colonPos);
-        std::string value = header.substr(colonPos + 2, header.length() - colonPos - 3); // -3 for \r\n
+        std::string value = header.substr(colonPos + 2, header.length() - colonPos - 4); // -4 for ": " and \r\n
         (*headers)[key] = value;
     }
 
     return totalSize;
 }
 
-HttpResponse HttpClient::fetch(const std::string& url, const HttpRequestOptions& options) {
-    HttpResponse response;
-    response.statusCode = -1;
+size_t HttpClient::RawHeaderCallback(void* contents, size_t size, size_t nmemb, std::string* raw) {
+    size_t totalSize = size * nmemb;
+    raw->append(static_cast<char*>(contents), totalSize);
+    return totalSize;
+}
 
-    if (!initialized || !curl) {
-        throw std::runtime_error("CURL not initialized");
-    }
+HttpTimings HttpClient::readTimings(CURL* handle) {
+    curl_off_t nameLookup = 0, connect = 0, appConnect = 0, startTransfer = 0, total = 0;
+    curl_easy_getinfo(handle, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+    curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+    curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME_T, &startTransfer);
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME_T, &total);
 
-    std::string responseBody;
-    struct curl_slist* headersList = nullptr;
+    // curl reports cumulative offsets from the start of the request
+    HttpTimings timings;
+    timings.dnsUs = nameLookup;
+    timings.connectUs = connect > nameLookup ? connect - nameLookup : 0;
+    timings.tlsUs = appConnect > connect ? appConnect - connect : 0;
+    timings.firstByteUs = startTransfer;
+    timings.totalUs = total;
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &timings.newConnections);
+    return timings;
+}
 
-    // Reset CURL options
-    curl_easy_reset(curl);
+void HttpClient::configure(CURL* handle, const std::string& url, const HttpRequestOptions& options) {
+    // Reset CURL options; the handle's connection cache survives this, only
+    // the per-request options are cleared
+    curl_easy_reset(handle);
+
+    // Pooled, kept-alive connections, multiplexed over HTTP/2 where the
+    // server negotiates it. Waiting for a multiplexable connection only pays
+    // off over TLS, where ALPN tells us early; on plain http it would queue
+    // a cold batch behind the first response.
+    curl_easy_setopt(handle, CURLOPT_SHARE, HttpConnectionPool::instance().share());
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    if (url.rfind("https://", 0) == 0) {
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    }
 
     // Set URL
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
 
     // Set method
     switch (options.method) {
         case HttpMethod::POST:
-            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            curl_easy_setopt(handle, CURLOPT_POST, 1L);
             break;
         case HttpMethod::PUT:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+            curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "PUT");
             break;
         case HttpMethod::DELETE:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+            curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "DELETE");
             break;
         case HttpMethod::PATCH:
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
+            curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "PATCH");
             break;
         default:
-            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+            curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
     }
 
-    // Set headers
+    // Set other options
+    curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, options.followRedirects ? 1L : 0L);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT, options.timeout);
+}
+
+curl_slist* HttpClient::buildHeaders(const HttpRequestOptions& options) {
+    struct curl_slist* headersList = nullptr;
+
     for (const auto& header : options.headers) {
         std::string headerString = header.first + ": " + header.second;
         headersList = curl_slist_append(headersList, headerString.c_str());
     }
 
     if (!options.body.empty()) {
-        std::string bodyStr = options.body.dump();
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
         headersList = curl_slist_append(headersList, "Content-Type: application/json");
     }
 
+    return headersList;
+}
+
+curl_slist* HttpClient::prepare(CURL* handle, const std::string& url, const HttpRequestOptions& options,
+                                std::string* responseBody, HttpResponse* response) {
+    configure(handle, url, options);
+
+    // Set headers
+    struct curl_slist* headersList = buildHeaders(options);
     if (headersList) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headersList);
+        curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headersList);
+    }
+
+    if (!options.body.empty()) {
+        // COPYPOSTFIELDS: the dumped string does not outlive this function
+        std::string bodyStr = options.body.dump();
+        curl_easy_setopt(handle, CURLOPT_COPYPOSTFIELDS, bodyStr.c_str());
     }
 
     // Set callbacks
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, responseBody);
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, &response->headers);
 
-    // Set other options
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, options.followRedirects ? 1L : 0L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, options.timeout);
+    return headersList;
+}
+
+HttpResponse HttpClient::fetch(const std::string& url, const HttpRequestOptions& options) {
+    HttpResponse response;
+    response.statusCode = -1;
+
+    if (!initialized || !curl) {
+        throw std::runtime_error("CURL not initialized");
+    }
+
+    struct curl_slist* headersList = prepare(curl, url, options, &response.body, &response);
+    configuredFor = 0;
 
     // Perform request
     CURLcode res = curl_easy_perform(curl);
@@ -113,7 +219,7 @@ HttpResponse HttpClient::fetch(const std::string& url, const HttpRequestOptions&
     long httpCode;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
     response.statusCode = static_cast<int>(httpCode);
-    response.body = responseBody;
+    response.timings = readTimings(curl);
 
     if (headersList) {
         curl_slist_free_all(headersList);
@@ -121,3 +227,170 @@ HttpResponse HttpClient::fetch(const std::string& url, const HttpRequestOptions&
 
     return response;
 }
+
+std::vector<HttpResponse> HttpClient::fetchAll(const std::vector<HttpRequest>& requests) {
+    if (!initialized || !multi) {
+        throw std::runtime_error("CURL not initialized");
+    }
+
+    std::vector<HttpResponse> responses(requests.size());
+    std::vector<curl_slist*> headerLists(requests.size(), nullptr);
+
+    // Easy handles are kept between batches so their connections stay warm
+    while (batchHandles.size() < requests.size()) {
+        CURL* handle = curl_easy_init();
+        if (!handle) {
+            throw std::runtime_error("CURL not initialized");
+        }
+        batchHandles.push_back(handle);
+    }
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        CURL* handle = batchHandles[i];
+        responses[i].statusCode = -1;
+        headerLists[i] = prepare(handle, requests[i].url, requests[i].options, &responses[i].body, &responses[i]);
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, reinterpret_cast<char*>(i));
+        curl_multi_add_handle(multi, handle);
+    }
+
+    int running = 0;
+    do {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running) {
+            mc = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+        if (mc != CURLM_OK) {
+            std::cerr << "[ERROR] curl multi: " << curl_multi_strerror(mc) << std::endl;
+            break;
+        }
+    } while (running);
+
+    int queued = 0;
+    while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        char* priv = nullptr;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &priv);
+        HttpResponse& response = responses[reinterpret_cast<size_t>(priv)];
+
+        if (msg->data.result == CURLE_OK) {
+            long httpCode;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &httpCode);
+            response.statusCode = static_cast<int>(httpCode);
+            response.timings = readTimings(msg->easy_handle);
+        } else {
+            response.body = std::string("Curl error: ") + curl_easy_strerror(msg->data.result);
+        }
+    }
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        curl_multi_remove_handle(multi, batchHandles[i]);
+        if (headerLists[i]) {
+            curl_slist_free_all(headerLists[i]);
+        }
+    }
+
+    return responses;
+}
+
+PreparedRequest::PreparedRequest(std::string url, const HttpRequestOptions& options)
+    : url(std::move(url)), options(options), headers(HttpClient::buildHeaders(options)),
+      id(nextPreparedId++) {
+    if (!options.body.empty()) {
+        postBody = options.body.dump();
+    }
+}
+
+PreparedRequest::PreparedRequest(PreparedRequest&& other) noexcept
+    : url(std::move(other.url)), options(std::move(other.options)),
+      postBody(std::move(other.postBody)), headers(other.headers), id(other.id) {
+    other.headers = nullptr;
+}
+
+PreparedRequest::~PreparedRequest() {
+    if (headers) {
+        curl_slist_free_all(headers);
+    }
+}
+
+std::string_view HttpBuffer::header(std::string_view key) const {
+    for (const auto& header : headers) {
+        if (header.key.size() == key.size() &&
+            std::equal(key.begin(), key.end(), header.key.begin(),
+                [](unsigned char a, unsigned char b) { return std::tolower(a) == std::tolower(b); })) {
+            return header.value;
+        }
+    }
+    return {};
+}
+
+void HttpBuffer::reserve(size_t bodyBytes, size_t headerBytes, size_t headerCount) {
+    body.reserve(bodyBytes);
+    rawHeaders.reserve(headerBytes);
+    headers.reserve(headerCount);
+}
+
+void HttpClient::fetchInto(const PreparedRequest& request, HttpBuffer& buffer, bool parseHeaders) {
+    if (!initialized || !curl) {
+        throw std::runtime_error("CURL not initialized");
+    }
+
+    // clear() keeps capacity: once the buffer has seen the largest response
+    // nothing below allocates
+    buffer.statusCode = -1;
+    buffer.body.clear();
+    buffer.rawHeaders.clear();
+    buffer.headers.clear();
+
+    // configure() resets the handle and libcurl strdups the URL, so only
+    // when the request changed. The header list and post body are the
+    // request's own and outlive it.
+    if (configuredFor != request.id) {
+        configure(curl, request.url, request.options);
+
+        if (request.headers) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, request.headers);
+        }
+        if (!request.postBody.empty()) {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.postBody.data());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.postBody.size()));
+        }
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        configuredFor = request.id;
+    }
+
+    // Pointer options, no copies: set for every fetch
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, parseHeaders ? RawHeaderCallback : nullptr);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, parseHeaders ? &buffer.rawHeaders : nullptr);
+
+    CURLcode res = curl_easy_perform(curl);
+
+    if (res != CURLE_OK) {
+        throw std::runtime_error(std::string("Curl error: ") + curl_easy_strerror(res));
+    }
+
+    long httpCode;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+    buffer.statusCode = static_cast<int>(httpCode);
+    buffer.timings = readTimings(curl);
+
+    if (parseHeaders) {
+        // "Key: value\r\n" lines; views point into rawHeaders
+        std::string_view raw(buffer.rawHeaders);
+        while (!raw.empty()) {
+            size_t eol = raw.find("\r\n");
+            std::string_view line = raw.substr(0, eol);
+            raw.remove_prefix(eol == std::string_view::npos ? raw.size() : eol + 2);
+
+            size_t colonPos = line.find(':');
+            if (colonPos == std::string_view::npos) continue;
+
+            std::string_view value = line.substr(colonPos + 1);
+            while (!value.empty() && value.front() == ' ') {
+                value.remove_prefix(1);
+            }
+            buffer.headers.push_back(HttpHeaderView{line.substr(0, colonPos), value});
+        }
+    }
+}
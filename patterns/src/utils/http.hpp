@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <map>
+#include <vector>
+#include <mutex>
 #include <functional>
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
@@ -15,10 +18,22 @@ enum class HttpMethod {
     PATCH
 };
 
+// Per-request phase durations in microseconds, from curl_easy_getinfo.
+// connect and tls are 0 when the request rode on a reused connection.
+struct HttpTimings {
+    long long dnsUs = 0;
+    long long connectUs = 0;
+    long long tlsUs = 0;
+    long long firstByteUs = 0;
+    long long totalUs = 0;
+    long newConnections = 0;
+};
+
 struct HttpResponse {
     int statusCode;
     std::string body;
     std::map<std::string, std::string> headers;
+    HttpTimings timings;
 };
 
 struct HttpRequestOptions {
@@ -29,6 +44,82 @@ struct HttpRequestOptions {
     long timeout = 30L;
 };
 
+struct HttpRequest {
+    std::string url;
+    HttpRequestOptions options;
+};
+
+struct HttpHeaderView {
+    std::string_view key;
+    std::string_view value;
+};
+
+// Caller-owned response storage for HttpClient::fetchInto. Every fetch
+// clears it without releasing capacity, so a buffer reused across polls
+// stops allocating once it has held the largest response. Header views
+// point into rawHeaders and are valid until the next fetch.
+struct HttpBuffer {
+    int statusCode = -1;
+    std::string body;
+    std::string rawHeaders;
+    std::vector<HttpHeaderView> headers;
+    HttpTimings timings;
+
+    // Case-insensitive lookup, empty if absent
+    std::string_view header(std::string_view key) const;
+    void reserve(size_t bodyBytes, size_t headerBytes = 4096, size_t headerCount = 32);
+};
+
+// URL, options and the curl header list built once and reused for every
+// fetchInto, instead of rebuilding the curl_slist per request. A client
+// that fetches the same PreparedRequest again keeps its handle configured
+// for it, so libcurl copies nothing per request either.
+class PreparedRequest {
+    public:
+        PreparedRequest(std::string url, const HttpRequestOptions& options = HttpRequestOptions());
+        PreparedRequest(PreparedRequest&& other) noexcept;
+        ~PreparedRequest();
+
+        PreparedRequest(const PreparedRequest&) = delete;
+        PreparedRequest& operator=(const PreparedRequest&) = delete;
+        PreparedRequest& operator=(PreparedRequest&&) = delete;
+
+    private:
+        friend class HttpClient;
+
+        std::string url;
+        HttpRequestOptions options;
+        std::string postBody;
+        curl_slist* headers;
+        uint64_t id;  // unique per request, kept across moves
+};
+
+// Process-wide curl state. Runs curl_global_init exactly once and owns a
+// share handle through which every HttpClient, on any thread, reuses DNS
+// lookups and TLS sessions. Open connections are not shared: each client
+// keeps its own alive, so one polling thread per client reuses its
+// connection, and a new client only pays the TCP handshake (its TLS
+// session resumes).
+class HttpConnectionPool {
+    public:
+        static HttpConnectionPool& instance();
+
+        CURLSH* share() { return handle; }
+
+        HttpConnectionPool(const HttpConnectionPool&) = delete;
+        HttpConnectionPool& operator=(const HttpConnectionPool&) = delete;
+
+    private:
+        HttpConnectionPool();
+        ~HttpConnectionPool();
+
+        static void lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+        static void unlock(CURL* handle, curl_lock_data data, void* userptr);
+
+        CURLSH* handle;
+        std::mutex locks[CURL_LOCK_DATA_LAST];
+};
+
 class HttpClient {
     public:
         HttpClient();
@@ -36,10 +127,36 @@ class HttpClient {
 
         HttpResponse fetch(const std::string& url, const HttpRequestOptions& options = HttpRequestOptions());
 
+        // Runs all requests concurrently on a curl multi handle and returns the
+        // responses in request order. A transport failure does not throw; that
+        // response gets statusCode -1 and the curl error text as body.
+        std::vector<HttpResponse> fetchAll(const std::vector<HttpRequest>& requests);
+
+        // Polling path: the body lands in the caller's buffer and headers are
+        // only split (into string_views) on request, so once the buffer is
+        // sized nothing here allocates. Fetching the same request again
+        // skips reconfiguring the handle; what remains is libcurl's own
+        // per-transfer bookkeeping inside curl_easy_perform, a fixed few
+        // dozen small mallocs per request. Throws on transport errors like
+        // fetch.
+        void fetchInto(const PreparedRequest& request, HttpBuffer& buffer, bool parseHeaders = false);
+
     private:
         static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
         static size_t HeaderCallback(void* contents, size_t size, size_t nmemb, std::map<std::string, std::string>* headers);
 
+        static size_t RawHeaderCallback(void* contents, size_t size, size_t nmemb, std::string* raw);
+
+        friend class PreparedRequest;
+        static HttpTimings readTimings(CURL* handle);
+        static void configure(CURL* handle, const std::string& url, const HttpRequestOptions& options);
+        static curl_slist* buildHeaders(const HttpRequestOptions& options);
+        static curl_slist* prepare(CURL* handle, const std::string& url, const HttpRequestOptions& options,
+                                   std::string* responseBody, HttpResponse* response);
+
         CURL* curl;
+        uint64_t configuredFor;  // PreparedRequest id curl is set up for, 0 if none
+        CURLM* multi;
+        std::vector<CURL*> batchHandles;
         bool initialized;
 };
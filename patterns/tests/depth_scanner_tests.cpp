@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "../src/utils/depth_scanner.hpp"
+
+using json = nlohmann::json;
+
+// Response shapes as returned by each venue's depth endpoint
+static const std::string BINANCE_DEPTH = R"({"lastUpdateId":1027024,
+    "bids":[["4.00000000","431.00000000"],["3.99000000","12.50000000"]],
+    "asks":[["4.00000200","12.00000000"],["4.00000300","1.00000000"]]})";
+
+static const std::string BYBIT_DEPTH = R"({"retCode":0,"retMsg":"OK","result":{"s":"BTCUSDT",
+    "a":[["65557.7","16.606555"],["65558.1","0.5"]],"b":[["65485.47","47.081829"],["65485.1","2"]],
+    "ts":1716863719031,"u":230704,"seq":1432604333,"cts":1716863718905},"retExtInfo":{},"time":1716863719382})";
+
+static const std::string COINBASE_DEPTH = R"({"bids":[["295.96","4.39088265",2]],
+    "asks":[["295.97","25.23542881",12]],"sequence":3,"auction_mode":false,"auction":null,
+    "time":"2024-11-05T19:53:42.553Z"})";
+
+static const std::string OKX_DEPTH = R"({"code":"0","msg":"","data":[{
+    "asks":[["41006.8","0.60038921","0","1"]],
+    "bids":[["41006.3","0.30178218","0","2"]],
+    "ts":"1629966436396"}]})";
+
+class DepthScannerTest : public ::testing::Test {
+protected:
+    // The DOM path the exchange tools used before
+    static void domTopOfBook(const json& book, double& bidPrice, double& askPrice) {
+        bidPrice = std::stod(book["bids"][0][0].get<std::string>());
+        askPrice = std::stod(book["asks"][0][0].get<std::string>());
+    }
+};
+
+// Basic functionality tests
+TEST_F(DepthScannerTest, BinanceTopOfBook) {
+    DepthScanner scanner(BINANCE_DEPTH);
+    double price, size;
+
+    ASSERT_TRUE(scanner.seek("bids"));
+    ASSERT_TRUE(scanner.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 4.0);
+    EXPECT_DOUBLE_EQ(size, 431.0);
+
+    ASSERT_TRUE(scanner.seek("asks"));
+    ASSERT_TRUE(scanner.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 4.000002);
+    EXPECT_DOUBLE_EQ(size, 12.0);
+}
+
+TEST_F(DepthScannerTest, BybitKeysAndTimestamp) {
+    DepthScanner scanner(BYBIT_DEPTH);
+    double price, size;
+    uint64_t time;
+
+    ASSERT_TRUE(scanner.seek("b"));
+    ASSERT_TRUE(scanner.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 65485.47);
+
+    ASSERT_TRUE(scanner.seek("a"));
+    ASSERT_TRUE(scanner.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 65557.7);
+
+    ASSERT_TRUE(scanner.seek("time"));
+    ASSERT_TRUE(scanner.readUint(time));
+    EXPECT_EQ(time, 1716863719382u);
+}
+
+TEST_F(DepthScannerTest, SkipsExtraLevelFields) {
+    double price, size;
+    uint64_t ts;
+
+    DepthScanner coinbase(COINBASE_DEPTH);
+    ASSERT_TRUE(coinbase.seek("asks"));
+    ASSERT_TRUE(coinbase.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(size, 25.23542881);
+    EXPECT_FALSE(coinbase.nextLevel(price, size));  // single level
+
+    DepthScanner okx(OKX_DEPTH);
+    ASSERT_TRUE(okx.seek("bids"));
+    ASSERT_TRUE(okx.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 41006.3);
+    ASSERT_TRUE(okx.seek("ts"));
+    ASSERT_TRUE(okx.readUint(ts));
+    EXPECT_EQ(ts, 1629966436396u);
+}
+
+TEST_F(DepthScannerTest, SeeksForwardThenWraps) {
+    static const std::string NESTED = R"({"a":{"ts":1},"b":{"ts":2}})";
+    DepthScanner scanner(NESTED);
+    uint64_t ts;
+
+    // The next "ts" after "b", not the first in the document
+    ASSERT_TRUE(scanner.seek("b"));
+    ASSERT_TRUE(scanner.seek("ts"));
+    ASSERT_TRUE(scanner.readUint(ts));
+    EXPECT_EQ(ts, 2u);
+
+    // Nothing ahead: back to the start
+    ASSERT_TRUE(scanner.seek("ts"));
+    ASSERT_TRUE(scanner.readUint(ts));
+    EXPECT_EQ(ts, 1u);
+    ASSERT_TRUE(scanner.seek("a"));
+    EXPECT_FALSE(scanner.seek("c"));
+}
+
+TEST_F(DepthScannerTest, WalksAllLevels) {
+    DepthScanner scanner(BINANCE_DEPTH);
+    double price, size;
+    int levels = 0;
+
+    ASSERT_TRUE(scanner.seek("asks"));
+    while (scanner.nextLevel(price, size)) {
+        levels++;
+    }
+    EXPECT_EQ(levels, 2);
+    EXPECT_DOUBLE_EQ(price, 4.000003);
+}
+
+TEST_F(DepthScannerTest, MatchesDomPath) {
+    for (const auto& body : {BINANCE_DEPTH, COINBASE_DEPTH}) {
+        double domBid, domAsk, bid, ask, size;
+        domTopOfBook(json::parse(body), domBid, domAsk);
+
+        DepthScanner scanner(body);
+        ASSERT_TRUE(scanner.seek("bids") && scanner.nextLevel(bid, size));
+        ASSERT_TRUE(scanner.seek("asks") && scanner.nextLevel(ask, size));
+        EXPECT_EQ(bid, domBid);
+        EXPECT_EQ(ask, domAsk);
+    }
+}
+
+// Error handling tests
+TEST_F(DepthScannerTest, RejectsMalformedInput) {
+    double price, size;
+
+    DepthScanner missing(R"({"asks":[]})");
+    EXPECT_FALSE(missing.seek("bids"));
+
+    DepthScanner empty(R"({"bids":[]})");
+    ASSERT_TRUE(empty.seek("bids"));
+    EXPECT_FALSE(empty.nextLevel(price, size));
+
+    DepthScanner truncated(R"({"bids":[["4.0)");
+    ASSERT_TRUE(truncated.seek("bids"));
+    EXPECT_FALSE(truncated.nextLevel(price, size));
+
+    DepthScanner garbage(R"({"bids":[["abc","1"]]})");
+    ASSERT_TRUE(garbage.seek("bids"));
+    EXPECT_FALSE(garbage.nextLevel(price, size));
+
+    // A string value equal to the key is not the key
+    DepthScanner value(R"({"side":"bids","bids":[["1.5","2"]]})");
+    ASSERT_TRUE(value.seek("bids"));
+    ASSERT_TRUE(value.nextLevel(price, size));
+    EXPECT_DOUBLE_EQ(price, 1.5);
+}
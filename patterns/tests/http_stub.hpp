@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+    Minimal keep-alive HTTP/1.1 server on 127.0.0.1 so HttpClient can be
+    tested without network access.
+
+    GET /delay/<ms>/... waits <ms> before answering, every other path answers
+    immediately. The body echoes the request path.
+*/
+class HttpStub {
+    private:
+        int listenFd = -1;
+        int listenPort = 0;
+        std::atomic<bool> running{true};
+        std::atomic<int> acceptedConnections{0};
+        std::atomic<int> servedRequests{0};
+
+        std::thread acceptor;
+        std::mutex clientsMutex;
+        std::vector<int> clientFds;
+        std::vector<std::thread> clients;
+
+        void acceptLoop() {
+            while (running) {
+                pollfd pfd{listenFd, POLLIN, 0};
+                if (poll(&pfd, 1, 50) <= 0) continue;
+
+                int fd = ::accept(listenFd, nullptr, nullptr);
+                if (fd < 0) continue;
+
+                acceptedConnections++;
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clientFds.push_back(fd);
+                clients.emplace_back(&HttpStub::serve, this, fd);
+            }
+        }
+
+        void serve(int fd) {
+            std::string pending;
+            char buf[4096];
+
+            while (running) {
+                size_t end = pending.find("\r\n\r\n");
+                if (end == std::string::npos) {
+                    ssize_t len = ::recv(fd, buf, sizeof(buf), 0);
+                    if (len <= 0) break;
+                    pending.append(buf, len);
+                    continue;
+                }
+
+                std::string request = pending.substr(0, end);
+                pending.erase(0, end + 4);
+
+                size_t pathStart = request.find(' ') + 1;
+                std::string path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+
+                if (path.rfind("/delay/", 0) == 0) {
+                    int ms = std::atoi(path.c_str() + 7);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+                }
+
+                std::string body = "{\"path\":\"" + path + "\"}";
+                std::string response =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Content-Type: application/json\r\n"
+                    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                    "\r\n" + body;
+
+                servedRequests++;
+                if (::send(fd, response.data(), response.size(), MSG_NOSIGNAL) < 0) break;
+            }
+        }
+
+    public:
+        HttpStub() {
+            listenFd = socket(AF_INET, SOCK_STREAM, 0);
+
+            int optval = 1;
+            setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof optval);
+
+            sockaddr_in address;
+            memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_port = 0;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            bind(listenFd, (sockaddr*)&address, sizeof(address));
+            listen(listenFd, 128);
+
+            socklen_t len = sizeof(address);
+            getsockname(listenFd, (sockaddr*)&address, &len);
+            listenPort = ntohs(address.sin_port);
+
+            acceptor = std::thread(&HttpStub::acceptLoop, this);
+        }
+
+        ~HttpStub() {
+            running = false;
+            acceptor.join();
+
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            for (int fd : clientFds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+            for (int fd : clientFds) {
+                close(fd);
+            }
+            close(listenFd);
+        }
+
+        HttpStub(const HttpStub&) = delete;
+        HttpStub& operator=(const HttpStub&) = delete;
+
+        std::string url(const std::string& path) const {
+            return "http://127.0.0.1:" + std::to_string(listenPort) + path;
+        }
+
+        int connections() const { return acceptedConnections.load(); }
+        int requests() const { return servedRequests.load(); }
+};
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/decorator/orderbook.hpp"
+
+class OrderBookTest : public ::testing::Test {
+protected:
+    OrderBook book;
+
+    void SetUp() override {
+        book.loadSnapshot(
+            {{100.0, 1.0}, {99.5, 2.0}, {99.0, 3.0}},
+            {{100.5, 1.5}, {101.0, 2.5}, {101.5, 3.5}},
+            10
+        );
+    }
+};
+
+// Basic functionality tests
+TEST_F(OrderBookTest, SnapshotBestLevels) {
+    ASSERT_NE(book.bestBid(), nullptr);
+    ASSERT_NE(book.bestAsk(), nullptr);
+    EXPECT_DOUBLE_EQ(book.bestBid()->price, 100.0);
+    EXPECT_DOUBLE_EQ(book.bestAsk()->price, 100.5);
+    EXPECT_EQ(book.depth(Side::BID), 3u);
+    EXPECT_EQ(book.getSequence(), 10u);
+}
+
+TEST_F(OrderBookTest, EmptyBook) {
+    OrderBook empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.bestBid(), nullptr);
+    EXPECT_EQ(empty.bestAsk(), nullptr);
+}
+
+TEST_F(OrderBookTest, InsertUpdateDelete) {
+    book.apply(Side::BID, 100.25, 4.0);   // new best
+    EXPECT_DOUBLE_EQ(book.bestBid()->price, 100.25);
+
+    book.apply(Side::BID, 99.5, 7.0);     // resize
+    EXPECT_DOUBLE_EQ(book.level(Side::BID, 2).size, 7.0);
+
+    book.apply(Side::ASK, 100.5, 0.0);    // remove best
+    EXPECT_DOUBLE_EQ(book.bestAsk()->price, 101.0);
+
+    book.apply(Side::ASK, 102.0, 1.0);    // new worst
+    EXPECT_DOUBLE_EQ(book.level(Side::ASK, 2).price, 102.0);
+
+    book.apply(Side::ASK, 200.0, 0.0);    // removing an absent level is a no-op
+    EXPECT_EQ(book.depth(Side::ASK), 3u);
+}
+
+TEST_F(OrderBookTest, DepthQuery) {
+    PriceLevel levels[5];
+
+    size_t count = book.top(Side::ASK, 5, levels);
+    ASSERT_EQ(count, 3u);
+    EXPECT_DOUBLE_EQ(levels[0].price, 100.5);
+    EXPECT_DOUBLE_EQ(levels[1].price, 101.0);
+    EXPECT_DOUBLE_EQ(levels[2].price, 101.5);
+
+    count = book.top(Side::BID, 2, levels);
+    ASSERT_EQ(count, 2u);
+    EXPECT_DOUBLE_EQ(levels[1].price, 99.5);
+}
+
+TEST_F(OrderBookTest, SequencedUpdates) {
+    EXPECT_FALSE(book.apply(Side::BID, 100.1, 1.0, 10));  // stale
+    EXPECT_DOUBLE_EQ(book.bestBid()->price, 100.0);
+
+    EXPECT_TRUE(book.apply(Side::BID, 100.1, 1.0, 11));
+    EXPECT_DOUBLE_EQ(book.bestBid()->price, 100.1);
+    EXPECT_EQ(book.getSequence(), 11u);
+}
+
+TEST_F(OrderBookTest, StaysSorted) {
+    for (int i = 0; i < 200; ++i) {
+        double price = 90.0 + (i * 37 % 100) * 0.1;
+        book.apply(Side::BID, price, (i % 5) ? 1.0 : 0.0);
+    }
+
+    for (size_t i = 1; i < book.depth(Side::BID); ++i) {
+        EXPECT_GT(book.level(Side::BID, i - 1).price, book.level(Side::BID, i).price);
+    }
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "../src/decorator/quote_board.hpp"
+
+static OrderBook makeBook(double bid, double ask, size_t levels = 5, double size = 1.0) {
+    std::vector<PriceLevel> bids, asks;
+    for (size_t i = 0; i < levels; ++i) {
+        bids.push_back({bid - i, size});
+        asks.push_back({ask + i, size});
+    }
+
+    OrderBook book;
+    book.loadSnapshot(bids, asks);
+    return book;
+}
+
+class QuoteBoardTest : public ::testing::Test {
+protected:
+    QuoteBoard board{3, 2};  // 3 symbols x 2 exchanges
+};
+
+// Basic functionality tests
+TEST_F(QuoteBoardTest, EmptySlot) {
+    BBO bbo;
+    EXPECT_EQ(board.readTop(0, 0, bbo), 0);
+    EXPECT_EQ(bbo.bid.price, 0);
+    EXPECT_EQ(bbo.ask.price, 0);
+
+    OrderBook book;
+    EXPECT_EQ(board.readBook(0, 0, book), 0);
+    EXPECT_TRUE(book.empty());
+}
+
+TEST_F(QuoteBoardTest, PublishAndRead) {
+    board.publish(1, 1, makeBook(100.0, 101.0), 42);
+
+    BBO bbo;
+    EXPECT_EQ(board.readTop(1, 1, bbo), 42);
+    EXPECT_DOUBLE_EQ(bbo.bid.price, 100.0);
+    EXPECT_DOUBLE_EQ(bbo.ask.price, 101.0);
+
+    OrderBook book;
+    EXPECT_EQ(board.readBook(1, 1, book), 42);
+    EXPECT_EQ(book.depth(Side::BID), 5);
+    EXPECT_DOUBLE_EQ(book.level(Side::ASK, 4).price, 105.0);
+    EXPECT_EQ(book.timestamp, 42);
+
+    // Neighbouring slots untouched
+    EXPECT_EQ(board.readTop(1, 0, bbo), 0);
+    EXPECT_EQ(board.readTop(2, 1, bbo), 0);
+}
+
+TEST_F(QuoteBoardTest, RepublishReplacesSlot) {
+    board.publish(0, 0, makeBook(100.0, 101.0, 10), 1);
+    board.publish(0, 0, makeBook(200.0, 201.0, 3), 2);
+
+    OrderBook book;
+    EXPECT_EQ(board.readBook(0, 0, book), 2);
+    EXPECT_EQ(book.depth(Side::BID), 3);
+    EXPECT_DOUBLE_EQ(book.bestBid()->price, 200.0);
+}
+
+TEST_F(QuoteBoardTest, DepthIsCapped) {
+    board.publish(0, 0, makeBook(1000.0, 1001.0, QuoteBoard::MAX_DEPTH + 10), 1);
+
+    OrderBook book;
+    board.readBook(0, 0, book);
+    EXPECT_EQ(book.depth(Side::BID), QuoteBoard::MAX_DEPTH);
+    EXPECT_EQ(book.depth(Side::ASK), QuoteBoard::MAX_DEPTH);
+}
+
+TEST_F(QuoteBoardTest, VersionCountsPublishes) {
+    uint64_t v = board.getVersion();
+    board.publish(0, 0, makeBook(100.0, 101.0), 1);
+    board.publish(0, 1, makeBook(100.0, 101.0), 1);
+    EXPECT_EQ(board.getVersion(), v + 2);
+    EXPECT_EQ(board.waitForChange(v), v + 2);  // already changed, no block
+}
+
+TEST(QuoteBoardFreshness, AgesAgainstMaxAge) {
+    EXPECT_FALSE(QuoteBoard::isFresh(0, 1000, 5000));  // never published
+    EXPECT_TRUE(QuoteBoard::isFresh(1000, 1000, 0));
+    EXPECT_TRUE(QuoteBoard::isFresh(1000, 3000, 2000));
+    EXPECT_FALSE(QuoteBoard::isFresh(1000, 3001, 2000));
+}
+
+TEST(QuoteBoardFreshness, PublishedAfterNowIsFresh) {
+    // A poller published between the evaluator's clock read and its
+    // readTop; now - updatedAt must not wrap to a huge age
+    uint64_t now = nowNanos();
+    EXPECT_TRUE(QuoteBoard::isFresh(now + 1, now, 2'000'000'000));
+    EXPECT_TRUE(QuoteBoard::isFresh(now + 1'000'000, now, 0));
+}
+
+// Concurrency tests
+TEST_F(QuoteBoardTest, WaitWakesOnPublish) {
+    uint64_t v = board.getVersion();
+
+    std::thread writer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        board.publish(2, 0, makeBook(100.0, 101.0), 7);
+    });
+
+    EXPECT_GT(board.waitForChange(v), v);
+
+    BBO bbo;
+    EXPECT_EQ(board.readTop(2, 0, bbo), 7);
+    writer.join();
+}
+
+TEST_F(QuoteBoardTest, WakeReleasesWaiter) {
+    uint64_t v = board.getVersion();
+    std::thread waker([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        board.wake();
+    });
+
+    EXPECT_GT(board.waitForChange(v), v);
+    waker.join();
+}
+
+TEST_F(QuoteBoardTest, ReadersNeverSeeTornBooks) {
+    // Every publish writes one value k to every price and size and the
+    // timestamp; a consistent read must see the same k everywhere
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (uint64_t k = 1; k <= 100000; ++k) {
+            double v = static_cast<double>(k);
+            std::vector<PriceLevel> levels(QuoteBoard::MAX_DEPTH, PriceLevel{v, v});
+            OrderBook book;
+            book.loadSnapshot(levels, levels);
+            board.publish(0, 0, book, k);
+        }
+        done = true;
+    });
+
+    size_t reads = 0;
+    OrderBook book;
+    while (!done) {
+        uint64_t k = board.readBook(0, 0, book);
+        if (k == 0) continue;
+
+        double v = static_cast<double>(k);
+        for (Side side : {Side::BID, Side::ASK}) {
+            ASSERT_EQ(book.depth(side), QuoteBoard::MAX_DEPTH);
+            for (size_t n = 0; n < book.depth(side); ++n) {
+                ASSERT_EQ(book.level(side, n).price, v);
+                ASSERT_EQ(book.level(side, n).size, v);
+            }
+        }
+        reads++;
+    }
+
+    writer.join();
+    EXPECT_GT(reads, 0);
+}
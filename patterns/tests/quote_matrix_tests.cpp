@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include "../src/decorator/quote_matrix.hpp"
+
+static BBO quote(double bid, double ask, double size = 1.0) {
+    BBO bbo{};
+    bbo.bid = PriceLevel{bid, size};
+    bbo.ask = PriceLevel{ask, size};
+    return bbo;
+}
+
+class QuoteMatrixTest : public ::testing::Test {
+protected:
+    // BTC/USDT, BTC/USDC, USDC/USDT on three fee-free exchanges
+    QuoteMatrix matrix{
+        {{Token::BTC, Token::USDT}, {Token::BTC, Token::USDC}, {Token::USDC, Token::USDT}},
+        {0, 0, 0}
+    };
+
+    void SetUp() override {
+        for (size_t e = 0; e < 3; ++e) {
+            matrix.set(0, e, quote(100.0, 100.1));
+            matrix.set(1, e, quote(100.0, 100.1));
+            matrix.set(2, e, quote(0.9999, 1.0001));
+        }
+    }
+};
+
+// Basic functionality tests
+TEST_F(QuoteMatrixTest, QuietMarketFindsNothing) {
+    std::vector<CrossOpportunity> cross;
+    std::vector<TriangleOpportunity> triangles;
+
+    EXPECT_EQ(matrix.scanCross(0, cross), 0);
+    EXPECT_EQ(matrix.scanTriangular(0, triangles), 0);
+    EXPECT_TRUE(cross.empty());
+    EXPECT_TRUE(triangles.empty());
+}
+
+TEST_F(QuoteMatrixTest, FindsCrossedPair) {
+    matrix.set(0, 2, quote(101.0, 101.2, 0.5));
+
+    std::vector<CrossOpportunity> cross;
+    ASSERT_EQ(matrix.scanCross(0, cross), 2);  // buy on 0 or 1, sell on 2
+
+    for (const CrossOpportunity& c : cross) {
+        EXPECT_EQ(c.symbol, 0);
+        EXPECT_EQ(c.sellExchange, 2);
+        EXPECT_NEAR(c.profitPercent, (101.0 - 100.1) / 100.1 * 100, 1e-9);
+        EXPECT_DOUBLE_EQ(c.quantity, 0.5);
+    }
+}
+
+TEST_F(QuoteMatrixTest, FeesAndMinProfitFilter) {
+    matrix.set(0, 2, quote(100.3, 100.4));  // +0.2% gross over exchanges 0 and 1
+
+    std::vector<CrossOpportunity> cross;
+    EXPECT_EQ(matrix.scanCross(0, cross), 2);
+    EXPECT_EQ(matrix.scanCross(0.5, cross), 0);
+
+    QuoteMatrix taxed({{Token::BTC, Token::USDT}}, {0.001, 0.001});
+    taxed.set(0, 0, quote(100.0, 100.1));
+    taxed.set(0, 1, quote(100.3, 100.4));
+
+    cross.clear();
+    EXPECT_EQ(taxed.scanCross(0, cross), 0);  // 0.2% edge, 0.2% in fees
+}
+
+TEST_F(QuoteMatrixTest, MissingQuotesNeverCross) {
+    matrix.clear(0, 0);
+    matrix.set(0, 1, BBO{});
+
+    EXPECT_EQ(matrix.get(0, 0).bid.price, 0);
+
+    std::vector<CrossOpportunity> cross;
+    EXPECT_EQ(matrix.scanCross(0, cross), 0);
+
+    matrix.clear(2, 0);
+    std::vector<TriangleOpportunity> triangles;
+    EXPECT_EQ(matrix.scanTriangular(0, triangles), 0);
+}
+
+TEST_F(QuoteMatrixTest, BuildsTrianglesBothWays) {
+    // USDT -> BTC -> USDC -> USDT and USDC -> BTC -> USDT -> USDC
+    EXPECT_EQ(matrix.triangleCount(), 2);
+}
+
+TEST_F(QuoteMatrixTest, FindsTriangleOnOneExchange) {
+    // BTC is rich in USDC on exchange 1: buy with USDT at 100.1, sell for
+    // 101 USDC, convert back at 0.9999
+    matrix.set(1, 1, quote(101.0, 101.1));
+
+    std::vector<TriangleOpportunity> triangles;
+    ASSERT_EQ(matrix.scanTriangular(0, triangles), 1);
+
+    const TriangleOpportunity& t = triangles[0];
+    EXPECT_EQ(t.exchange, 1);
+    EXPECT_EQ(t.first, 0);
+    EXPECT_EQ(t.second, 1);
+    EXPECT_EQ(t.bridge, 2);
+    EXPECT_NEAR(t.profitPercent, (101.0 * 0.9999 / 100.1 - 1) * 100, 1e-9);
+}
+
+TEST_F(QuoteMatrixTest, InvertedBridge) {
+    // USDC -> BTC (BTC/USDC ask), BTC -> USDT (BTC/USDT bid), then buy USDC
+    // with USDT on the USDC/USDT ask
+    matrix.set(0, 0, quote(101.0, 101.1));
+
+    std::vector<TriangleOpportunity> triangles;
+    ASSERT_EQ(matrix.scanTriangular(0, triangles), 1);
+
+    EXPECT_EQ(triangles[0].first, 1);
+    EXPECT_EQ(triangles[0].second, 0);
+    EXPECT_NEAR(triangles[0].profitPercent, (101.0 / 1.0001 / 100.1 - 1) * 100, 1e-9);
+}
+
+// Performance test
+TEST(QuoteMatrixPerfTest, ScansManySymbols) {
+    const Token quotes[] = {Token::USDT, Token::USDC, Token::BTC, Token::ETH};
+
+    std::vector<Symbol> symbols;
+    for (int i = 0; i < 120; ++i) {
+        symbols.push_back({static_cast<Token>(i % 30), quotes[i / 30]});
+    }
+
+    QuoteMatrix matrix(symbols, {0.001, 0.001, 0.001, 0.006});
+    for (size_t s = 0; s < symbols.size(); ++s) {
+        for (size_t e = 0; e < 4; ++e) {
+            matrix.set(s, e, quote(100.0, 100.1));
+        }
+    }
+
+    std::vector<CrossOpportunity> cross;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < 10000; ++i) {
+        cross.clear();
+        matrix.scanCross(0, cross);
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - start);
+
+    EXPECT_TRUE(cross.empty());
+    EXPECT_LT(duration.count(), 1000);  // 1.2M symbol scans
+}
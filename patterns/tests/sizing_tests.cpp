@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../src/decorator/sizing.hpp"
+
+class SizingTest : public ::testing::Test {
+protected:
+    OrderBook buyBook;   // we lift its asks
+    OrderBook sellBook;  // we hit its bids
+
+    void SetUp() override {
+        buyBook.loadSnapshot(
+            {{99.0, 10.0}},
+            {{100.0, 1.0}, {100.5, 2.0}, {101.0, 5.0}}
+        );
+        sellBook.loadSnapshot(
+            {{101.5, 1.5}, {100.8, 1.0}, {100.2, 4.0}},
+            {{102.0, 10.0}}
+        );
+    }
+};
+
+// Basic functionality tests
+TEST_F(SizingTest, WalksLevelsWithoutFees) {
+    Execution exec = sizeArbitrage(buyBook, sellBook, 0, 0, 100);
+
+    // 1.0 @ 100 -> 101.5, 0.5 @ 100.5 -> 101.5, 1.0 @ 100.5 -> 100.8,
+    // then 100.5 -> 100.2 is a loss and the walk stops
+    EXPECT_DOUBLE_EQ(exec.quantity, 2.5);
+    EXPECT_DOUBLE_EQ(exec.buyVwap, (100.0 + 0.5 * 100.5 + 1.0 * 100.5) / 2.5);
+    EXPECT_DOUBLE_EQ(exec.sellVwap, (1.5 * 101.5 + 1.0 * 100.8) / 2.5);
+    EXPECT_GT(exec.profit(), 0);
+}
+
+TEST_F(SizingTest, RespectsMaxQuantity) {
+    Execution exec = sizeArbitrage(buyBook, sellBook, 0, 0, 0.3);
+
+    EXPECT_DOUBLE_EQ(exec.quantity, 0.3);
+    EXPECT_DOUBLE_EQ(exec.buyVwap, 100.0);
+    EXPECT_DOUBLE_EQ(exec.sellVwap, 101.5);
+}
+
+TEST_F(SizingTest, FeesShrinkTheTrade) {
+    // 0.3% a side: 100.5 -> 100.8 no longer pays, 100 -> 101.5 and
+    // 100.5 -> 101.5 still do
+    Execution exec = sizeArbitrage(buyBook, sellBook, 0.003, 0.003, 100);
+
+    EXPECT_DOUBLE_EQ(exec.quantity, 1.5);
+    EXPECT_NEAR(exec.cost, (100.0 + 0.5 * 100.5) * 1.003, 1e-9);
+    EXPECT_NEAR(exec.proceeds, 1.5 * 101.5 * 0.997, 1e-9);
+}
+
+TEST_F(SizingTest, MinProfitIsMarginal) {
+    // 100 -> 101.5 is +1.5%, 100.5 -> 101.5 is ~+0.995%
+    Execution exec = sizeArbitrage(buyBook, sellBook, 0, 0, 100, 1.2);
+
+    EXPECT_DOUBLE_EQ(exec.quantity, 1.0);
+    EXPECT_NEAR(exec.profitPercent(), 1.5, 1e-9);
+}
+
+TEST_F(SizingTest, NoCrossNoTrade) {
+    Execution exec = sizeArbitrage(sellBook, buyBook, 0, 0, 100);
+
+    EXPECT_EQ(exec.quantity, 0);
+    EXPECT_EQ(exec.profit(), 0);
+}
+
+TEST_F(SizingTest, ExhaustsShallowBook) {
+    OrderBook deepBid;
+    deepBid.loadSnapshot({{110.0, 50.0}}, {{111.0, 1.0}});
+
+    Execution exec = sizeArbitrage(buyBook, deepBid, 0, 0, 100);
+
+    EXPECT_DOUBLE_EQ(exec.quantity, 8.0);  // every ask level
+}
+
+TEST_F(SizingTest, EmptyBook) {
+    OrderBook empty;
+    EXPECT_EQ(sizeArbitrage(empty, sellBook, 0, 0, 100).quantity, 0);
+    EXPECT_EQ(sizeArbitrage(buyBook, empty, 0, 0, 100).quantity, 0);
+}
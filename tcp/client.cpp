@@ -9,29 +9,17 @@ using namespace std;
 using namespace std::chrono;
 
 void measureLatency(TCPStream* stream, const string& message) {
-    char line[1048576];
-    int len;
-
     auto start = high_resolution_clock::now();
 
-    // Send message
-    ssize_t sent = stream->send(message.c_str(), message.size());
-    if (sent <= 0) {
+    // One framed request; the response is whole however it was segmented
+    if (stream->sendMessage(MESSAGE_REQUEST, 1, message.data(), message.size()) < 0) {
         printf("Error sending message\n");
         return;
     }
     printf("sent - %s\n", message.c_str());
 
-    string response;
-    while ((len = stream->receive(line, sizeof(line))) > 0) {
-        line[len] = '\0';
-        response += line;
-
-        // Check if we've received the complete response
-        if (len < sizeof(line)) break;
-    }
-
-    if (len < 0) {
+    TCPMessage response;
+    if (stream->recvMessage(response) <= 0) {
         printf("Error receiving response\n");
         return;
     }
@@ -39,8 +27,9 @@ void measureLatency(TCPStream* stream, const string& message) {
     auto end = high_resolution_clock::now();
     auto duration = duration_cast<microseconds>(end - start);
 
-    printf("received - %s\n", line);
-    printf("latency: %lld microseconds (%.3f ms)\n\n", duration.count(), duration.count() / 1000.0);
+    if (response.type == MESSAGE_ERROR) printf("error - %s\n", response.payload.c_str());
+    else printf("received - %s\n", response.payload.c_str());
+    printf("latency: %lld microseconds (%.3f ms)\n\n", (long long)duration.count(), duration.count() / 1000.0);
 }
 
 
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "tcpconnector.h"
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+    Closed-loop load: every connection keeps `pipeline` framed "ping"
+    requests in flight (see tcpmessage.h) and sends the next as soon as a
+    response comes back; sequence numbers match responses to the request
+    times. Connections are
+    split across worker threads, each multiplexing its share on its own
+    epoll loop.
+
+    Two phases per worker: all its connects at once, each followed by a
+    first ping (a connection counts once the server has answered, i.e.
+    accepted and served it), then the request loop for the given time.
+    Reports connections/sec for the first, requests/sec and round-trip
+    percentiles for the second.
+*/
+
+struct Client {
+    TCPStream*       stream;
+    vector<uint64_t> sentAt;    // ns, steady clock, by sequence % pipeline
+    uint32_t         sequence;  // of the next request
+    bool             ready;     // first pong seen
+};
+
+struct Worker {
+    int              connections;
+    int              pipeline;
+    vector<uint64_t> latencies;
+    uint64_t         setupNanos;
+    double           seconds;
+    size_t           connected;
+    size_t           failed;
+};
+
+static uint64_t nowNanos() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool sendPing(Client& client) {
+    static const char ping[] = "ping";
+    uint32_t sequence = client.sequence++;
+    client.sentAt[sequence % client.sentAt.size()] = nowNanos();
+    return client.stream->sendMessage(MESSAGE_REQUEST, sequence, ping, sizeof(ping) - 1) > 0;
+}
+
+static uint64_t percentile(const vector<uint64_t>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t index = min(sorted.size() - 1, (size_t)(q * sorted.size()));
+    return sorted[index];
+}
+
+static void runWorker(Worker& worker, int port, const char* server, double seconds) {
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    TCPConnector connector;
+    vector<Client> clients;
+    clients.reserve(worker.connections);
+    worker.connected = worker.failed = 0;
+
+    uint64_t start = nowNanos();
+    for (int i = 0; i < worker.connections; ++i) {
+        TCPStream* stream = connector.connectNonBlocking(port, server);
+        if (stream == NULL) {
+            worker.failed++;
+            continue;
+        }
+        // Pipelined requests are small: don't let Nagle hold them back
+        int on = 1;
+        setsockopt(stream->getDescriptor(), IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        clients.push_back(Client{stream, vector<uint64_t>(worker.pipeline), 0, false});
+        struct epoll_event event;
+        event.events = EPOLLOUT;  // connect completion
+        event.data.u64 = clients.size() - 1;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, stream->getDescriptor(), &event);
+    }
+
+    vector<struct epoll_event> events(1024);
+    TCPMessage response;
+    size_t open = clients.size();
+    uint64_t deadline = 0;  // set once every connection is up
+    uint64_t now = start;
+
+    worker.latencies.reserve(1 << 20);
+    while (open > 0 && (deadline == 0 || (now = nowNanos()) < deadline)) {
+        int n = epoll_wait(epoll, events.data(), events.size(), 100);
+        if (n < 0 && errno != EINTR) {
+            perror("epoll_wait() failed");
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            Client& client = clients[events[i].data.u64];
+            int sd = client.stream->getDescriptor();
+
+            if (events[i].events & EPOLLOUT) {
+                // Connect finished: from now on only replies matter
+                int error = 0;
+                socklen_t len = sizeof(error);
+                getsockopt(sd, SOL_SOCKET, SO_ERROR, &error, &len);
+                struct epoll_event event;
+                event.events = EPOLLIN;
+                event.data.u64 = events[i].data.u64;
+                if (error != 0 || epoll_ctl(epoll, EPOLL_CTL_MOD, sd, &event) != 0 || !sendPing(client)) {
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, sd, NULL);
+                    worker.failed++;
+                    open--;
+                }
+                continue;
+            }
+
+            // Every whole response that arrived, each replaced by a new
+            // request (the first also fills the pipeline)
+            ssize_t len;
+            bool ok = true;
+            while (ok && (len = client.stream->recvMessage(response)) > 0) {
+                if (response.type != MESSAGE_RESPONSE) {
+                    ok = false;
+                } else if (!client.ready) {
+                    client.ready = true;
+                    worker.connected++;
+                    for (int j = 0; ok && j < worker.pipeline; ++j) ok = sendPing(client);
+                } else {
+                    worker.latencies.push_back(nowNanos() - client.sentAt[response.sequence % worker.pipeline]);
+                    ok = sendPing(client);
+                }
+            }
+            if (ok && len < 0 && errno == EAGAIN) continue;
+            epoll_ctl(epoll, EPOLL_CTL_DEL, sd, NULL);
+            if (!client.ready) worker.failed++;
+            open--;
+        }
+
+        if (deadline == 0 && worker.connected + worker.failed == (size_t)worker.connections) {
+            // Every connection answered or failed: the request phase starts
+            now = nowNanos();
+            worker.setupNanos = now - start;
+            if (worker.connected == 0) break;
+            deadline = now + (uint64_t)(seconds * 1e9);
+            start = now;
+        }
+    }
+    worker.seconds = deadline ? (now - start) / 1e9 : 0;
+
+    for (size_t i = 0; i < clients.size(); ++i) delete clients[i].stream;
+    close(epoll);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 7) {
+        printf("usage: %s <port> <ip> [<connections>] [<seconds>] [<threads>] [<pipeline>]\n", argv[0]);
+        exit(1);
+    }
+    int port = atoi(argv[1]);
+    int connections = argc >= 4 ? atoi(argv[3]) : 100;
+    double seconds = argc >= 5 ? atof(argv[4]) : 5.0;
+    int threads = argc >= 6 ? max(1, atoi(argv[5])) : 1;
+    // Requests in flight per connection
+    int pipeline = argc == 7 ? max(1, atoi(argv[6])) : 1;
+
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    vector<Worker> workers(threads);
+    vector<thread> running;
+    for (int i = 0; i < threads; ++i) {
+        workers[i].connections = connections / threads + (i < connections % threads ? 1 : 0);
+        workers[i].pipeline = pipeline;
+        running.push_back(thread(runWorker, ref(workers[i]), port, argv[2], seconds));
+    }
+
+    vector<uint64_t> latencies;
+    uint64_t setupNanos = 0;
+    size_t connected = 0, failed = 0;
+    double requestRate = 0;
+    for (int i = 0; i < threads; ++i) {
+        running[i].join();
+        Worker& worker = workers[i];
+        latencies.insert(latencies.end(), worker.latencies.begin(), worker.latencies.end());
+        setupNanos = max(setupNanos, worker.setupNanos);
+        connected += worker.connected;
+        failed += worker.failed;
+        if (worker.seconds > 0) requestRate += worker.latencies.size() / worker.seconds;
+    }
+
+    sort(latencies.begin(), latencies.end());
+    printf("%zu connections (%zu failed) on %d threads in %.1f ms: %.0f connections/s\n",
+           connected, failed, threads, setupNanos / 1e6, connected / (setupNanos / 1e9));
+    printf("%zu requests in %.2f s: %.0f requests/s\n", latencies.size(), seconds, requestRate);
+    printf("latency us: p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+           percentile(latencies, 0.5) / 1e3, percentile(latencies, 0.9) / 1e3,
+           percentile(latencies, 0.99) / 1e3, percentile(latencies, 0.999) / 1e3,
+           (latencies.empty() ? 0 : latencies.back()) / 1e3);
+    return failed == 0 ? 0 : 2;
+}
@@ -1,7 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "systeminfo.h"
 #include "tcpacceptor.h"
+#include "tcpreactor.h"
 
 bool isNumber(const string& str) {
     if(str.empty()) return false;
@@ -12,45 +23,166 @@ bool isNumber(const string& str) {
     return true;
 }
 
+// Taking system stats walks every process in /proc, which would stall
+// every other connection of the reactor that ran it. A worker takes a
+// snapshot once per interval and requests only format the latest one.
+class StatsCache {
+        mutex m_lock;
+        condition_variable m_wake;
+        shared_ptr<const SystemInfo::Snapshot> m_snapshot;
+        bool m_stopping;
+        thread m_worker;
+
+        void refresh(chrono::milliseconds interval) {
+            unique_lock<mutex> lock(m_lock);
+            while (!m_wake.wait_for(lock, interval, [this] { return m_stopping; })) {
+                lock.unlock();
+                auto snapshot = make_shared<const SystemInfo::Snapshot>(SystemInfo::takeSnapshot());
+                lock.lock();
+                m_snapshot = snapshot;
+            }
+        }
+
+    public:
+        StatsCache(chrono::milliseconds interval)
+            : m_snapshot(make_shared<const SystemInfo::Snapshot>(SystemInfo::takeSnapshot())),
+              m_stopping(false), m_worker(&StatsCache::refresh, this, interval) {}
+
+        ~StatsCache() {
+            {
+                lock_guard<mutex> lock(m_lock);
+                m_stopping = true;
+            }
+            m_wake.notify_one();
+            m_worker.join();
+        }
+
+        shared_ptr<const SystemInfo::Snapshot> get() {
+            lock_guard<mutex> lock(m_lock);
+            return m_snapshot;
+        }
+};
+
+static StatsCache* stats = NULL;
+
+// The reply to command; false for an unknown command
+bool respond(const string& command, string& reply) {
+    // Cheap round trip for load tests
+    if (command == "ping") {
+        reply = "pong";
+        return true;
+    }
+
+    printf("received - %s\n", command.c_str());
+    if (isNumber(command)) {
+        errno = 0;
+        long n = strtol(command.c_str(), NULL, 10);
+        if (errno == ERANGE || n > INT_MAX) {
+            reply = "Too many processes asked for, at most " + to_string(INT_MAX);
+            return false;
+        }
+
+        reply = SystemInfo::format(*stats->get(), (int)n);
+        return true;
+    }
+    reply = "Sorry, haven't yet included this in our system. Use 'Get System Info' or 'Get System Info - n'";
+    return false;
+}
+
+// Framed clients (see tcpmessage.h): one request message per command,
+// answered with a message of the same sequence number
+size_t handleMessage(TCPReactor::Connection& connection, const char* data, size_t len) {
+    MessageView request;
+    ssize_t used = parseMessage(data, len, request);
+    if (used == 0) return 0;
+    if (used < 0) {
+        // Out of step with the stream: nothing after this can be trusted
+        connection.close();
+        return len;
+    }
+
+    string reply;
+    bool ok = request.type == MESSAGE_REQUEST && respond(string(request.payload, request.length), reply);
+    connection.sendMessage(ok ? MESSAGE_RESPONSE : MESSAGE_ERROR, request.sequence, reply.data(), reply.size());
+    return used;
+}
+
+// Line clients: one command per line; input that arrived without a
+// newline is taken whole, as clients that send bare commands expect
+size_t handleCommand(TCPReactor::Connection& connection, const char* data, size_t len) {
+    if ((uint8_t)data[0] == (MESSAGE_MAGIC >> 8)) {
+        return handleMessage(connection, data, len);
+    }
+
+    const char* newline = (const char*)memchr(data, '\n', len);
+    size_t used = newline ? newline - data + 1 : len;
+    size_t end = newline ? newline - data : len;
+    if (end > 0 && data[end - 1] == '\r') end--;
+
+    string reply;
+    respond(string(data, end), reply);
+    if (reply == "pong") reply += '\n';
+    connection.send(reply.c_str(), reply.length());
+    return used;
+}
+
+static TCPReactorPool* pool = NULL;
+
+static void onSignal(int) {
+    if (pool != NULL) pool->stop();
+}
+
 int main(int argc, char** argv) {
-    if (argc < 2 || argc > 4) {
-        printf("usage: server <port> [<ip>]\n");
+    if (argc < 2 || argc > 6) {
+        printf("usage: server <port> [<ip>] [<backlog>] [<reactors>] [epoll|uring]\n");
         exit(1);
     }
 
-    TCPStream* stream = NULL;
-    TCPAcceptor* acceptor = NULL;
-    if (argc == 3) {
-        acceptor = new TCPAcceptor(atoi(argv[1]), argv[2]);
-    }
-    else {
-        acceptor = new TCPAcceptor(atoi(argv[1]));
-    }
-    if (acceptor->start() == 0) {
-        while (1) {
-            stream = acceptor->accept();
-            if (stream != NULL) {
-                size_t len;
-                char line[256];
-                while ((len = stream->receive(line, sizeof(line))) > 0) {
-                    line[len] = '\0';
-                    string command(line);
-                    printf("received - %s\n", line);
-
-                    if (isNumber(command)) {
-                        int n = stoi(command);
-
-                        string sysinfo = SystemInfo::getSystemStats(n);
-                        stream->send(sysinfo.c_str(), sysinfo.length());
-                    } else {
-                        string error = "Sorry, haven't yet included this in our system. Use 'Get System Info' or 'Get System Info - n'";
-                        stream->send(error.c_str(), error.length());
-                    }
-                }
-                delete stream;
-            }
+    // Thousands of clients need more descriptors than the default soft limit
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    const char* address = argc >= 3 ? argv[2] : "";
+    int backlog = argc >= 4 ? atoi(argv[3]) : SOMAXCONN;
+    // One event loop per reactor, each on its own core; 0 for every core
+    int reactors = argc >= 5 ? atoi(argv[4]) : 1;
+    TCPReactor::Engine engine = TCPReactor::EPOLL;
+    if (argc == 6) {
+        if (strcmp(argv[5], "uring") == 0) {
+            engine = TCPReactor::URING;
+        } else if (strcmp(argv[5], "epoll") != 0) {
+            printf("unknown engine %s: epoll or uring\n", argv[5]);
+            exit(1);
         }
     }
-    perror("Could not start the server");
-    exit(-1);
+
+    // A client that goes away must fail the write to it, not end the
+    // server; the uring engine's writes cannot ask for that per call
+    signal(SIGPIPE, SIG_IGN);
+
+    stats = new StatsCache(chrono::seconds(1));
+    pool = new TCPReactorPool(atoi(argv[1]), address, backlog, reactors, handleCommand, engine);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    int result = pool->run();
+    if (result != 0) {
+        perror("Could not start the server");
+        exit(-1);
+    }
+
+    // How evenly the kernel spread connections over the listeners, and
+    // what each request cost in syscalls
+    for (int i = 0; i < pool->getReactors(); ++i) {
+        TCPReactor* reactor = pool->getReactor(i);
+        size_t requests = reactor->getRequests();
+        printf("reactor %d (%s): %zu connections, %zu requests, %zu syscalls, %.2f syscalls/request\n",
+               i, engine == TCPReactor::URING ? "uring" : "epoll", reactor->getAccepted(), requests,
+               reactor->getSyscalls(), requests ? (double)reactor->getSyscalls() / requests : 0.0);
+    }
+    delete pool;
+    delete stats;
+    return 0;
 }
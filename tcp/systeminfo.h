@@ -34,20 +34,44 @@ class SystemInfo {
     };
 
     public:
+        // Everything getSystemStats reports, collected once so it can be
+        // formatted for any n later on
+        struct Snapshot {
+            string cpu;
+            string memory;
+            string disk;
+            vector<ProcessInfo> processes;  // by descending cpu usage
+        };
+
         static string getSystemStats(int n = 10) {
-            stringstream ss;
+            return format(takeSnapshot(), n);
+        }
+
+        // Reads /proc and the filesystem; slow with many processes
+        static Snapshot takeSnapshot() {
+            Snapshot snapshot;
+            stringstream cpu, memory, disk;
 
-            ss << "CPU Usage:\n";
-            getCPUUsage(ss);
+            getCPUUsage(cpu);
+            getMemoryInfo(memory);
+            getDiskUsage(disk);
+            snapshot.cpu = cpu.str();
+            snapshot.memory = memory.str();
+            snapshot.disk = disk.str();
 
-            ss << "\nMemory Usage:\n";
-            getMemoryInfo(ss);
+            getProcesses(snapshot.processes);
+            return snapshot;
+        }
+
+        static string format(const Snapshot& snapshot, int n) {
+            stringstream ss;
 
-            ss << "\nDisk Usage:\n";
-            getDiskUsage(ss);
+            ss << "CPU Usage:\n" << snapshot.cpu;
+            ss << "\nMemory Usage:\n" << snapshot.memory;
+            ss << "\nDisk Usage:\n" << snapshot.disk;
 
             ss << "\nTop " << n << " Processes:\n";
-            getTopProcesses(ss, n);
+            printTopProcesses(ss, snapshot.processes, n);
 
             return ss.str();
         }
@@ -142,12 +166,13 @@ class SystemInfo {
             return cpu_usage;
         }
 
-        static void getTopProcesses(stringstream& ss, int n) {
+        static void getProcesses(vector<ProcessInfo>& processes) {
             #ifdef __linux__
-                vector<ProcessInfo> processes;
+                long pwsize = sysconf(_SC_GETPW_R_SIZE_MAX);
+                vector<char> pwbuf(pwsize > 0 ? pwsize : 16384);
+
                 DIR* dir = opendir("/proc");
                 struct dirent* ent;
-
                 if (dir != NULL) {
                     while ((ent = readdir(dir)) != NULL) {
                         if (ent->d_type == DT_DIR) {
@@ -180,12 +205,14 @@ class SystemInfo {
                                     proc.state = stat[pos + 2];
                                 }
 
-                                // Get user (owner)
+                                // Get user (owner); getpwuid shares one static
+                                // result between threads, so use the _r form
                                 struct stat st;
                                 string path = "/proc/" + pid + "/stat";
                                 if (::stat(path.c_str(), &st) == 0) {
-                                    struct passwd *pw = getpwuid(st.st_uid);
-                                    if (pw != nullptr) {
+                                    struct passwd pwd;
+                                    struct passwd *pw = nullptr;
+                                    if (getpwuid_r(st.st_uid, &pwd, pwbuf.data(), pwbuf.size(), &pw) == 0 && pw != nullptr) {
                                         proc.user = pw->pw_name;
                                     }
                                 }
@@ -198,28 +225,32 @@ class SystemInfo {
 
                     // Sort processes by CPU usage
                     sort(processes.begin(), processes.end());
+                }
+            #endif
+        }
 
-                    // Print header with formatting
-                    ss << setw(7) << "PID"
-                       << setw(20) << "NAME"
-                       << setw(10) << "CPU%"
-                       << setw(10) << "MEM(MB)"
-                       << setw(8) << "STATE"
-                       << setw(15) << "USER"
-                       << "  COMMAND\n";
-                    ss << string(100, '-') << "\n";
-
-                    // Print top n processes
-                    for (size_t i = 0; i < min(size_t(n), processes.size()); ++i) {
-                        const auto& proc = processes[i];
-                        ss << setw(7) << proc.pid
-                           << setw(20) << (proc.name.length() > 19 ? proc.name.substr(0, 16) + "..." : proc.name)
-                           << setw(10) << fixed << setprecision(1) << proc.cpu_usage
-                           << setw(10) << proc.memory_usage
-                           << setw(8) << proc.state
-                           << setw(15) << (proc.user.length() > 14 ? proc.user.substr(0, 11) + "..." : proc.user)
-                           << "  " << (proc.cmdline.empty() ? proc.name : proc.cmdline) << "\n";
-                    }
+        static void printTopProcesses(stringstream& ss, const vector<ProcessInfo>& processes, int n) {
+            #ifdef __linux__
+                // Print header with formatting
+                ss << setw(7) << "PID"
+                   << setw(20) << "NAME"
+                   << setw(10) << "CPU%"
+                   << setw(10) << "MEM(MB)"
+                   << setw(8) << "STATE"
+                   << setw(15) << "USER"
+                   << "  COMMAND\n";
+                ss << string(100, '-') << "\n";
+
+                // Print top n processes
+                for (size_t i = 0; i < min(size_t(n), processes.size()); ++i) {
+                    const auto& proc = processes[i];
+                    ss << setw(7) << proc.pid
+                       << setw(20) << (proc.name.length() > 19 ? proc.name.substr(0, 16) + "..." : proc.name)
+                       << setw(10) << fixed << setprecision(1) << proc.cpu_usage
+                       << setw(10) << proc.memory_usage
+                       << setw(8) << proc.state
+                       << setw(15) << (proc.user.length() > 14 ? proc.user.substr(0, 11) + "..." : proc.user)
+                       << "  " << (proc.cmdline.empty() ? proc.name : proc.cmdline) << "\n";
                 }
             #else
                 ss << "Process information not available on this platform\n";
@@ -1,10 +1,11 @@
 #include "tcpacceptor.h"
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <arpa/inet.h>
 
-TCPAcceptor::TCPAcceptor(int port, const char* address)
-    : m_lsd(0), m_address(address), m_port(port), m_listening(false) {}
+TCPAcceptor::TCPAcceptor(int port, const char* address, int backlog, bool reusePort)
+    : m_lsd(0), m_address(address), m_port(port), m_backlog(backlog), m_reusePort(reusePort), m_listening(false) {}
 
 TCPAcceptor::~TCPAcceptor() {
     if (m_lsd > 0) {
@@ -12,12 +13,12 @@ TCPAcceptor::~TCPAcceptor() {
     }
 }
 
-int TCPAcceptor::start() {
+int TCPAcceptor::start(bool nonBlocking) {
     if(m_listening) {
         return 0;
     }
 
-    m_lsd = socket(PF_INET, SOCK_STREAM, 0);
+    m_lsd = socket(PF_INET, SOCK_STREAM | SOCK_CLOEXEC | (nonBlocking ? SOCK_NONBLOCK : 0), 0);
 
     struct sockaddr_in address;
     memset(&address, 0, sizeof(address));
@@ -31,13 +32,16 @@ int TCPAcceptor::start() {
 
     int optval = 1;
     setsockopt(m_lsd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof optval);
+    if (m_reusePort) {
+        setsockopt(m_lsd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof optval);
+    }
 
     int result = bind(m_lsd, (struct sockaddr*)&address, sizeof(address));
     if (result != 0) {
         perror("bind() failed");
         return result;
     }
-    result = listen(m_lsd, 5);
+    result = listen(m_lsd, m_backlog);
     if (result != 0) {
         perror("listen() failed");
         return result;
@@ -61,3 +65,28 @@ TCPStream* TCPAcceptor::accept() {
     }
     return new TCPStream(sd, &address);
 }
+
+size_t TCPAcceptor::acceptBatch(vector<TCPStream*>& streams, size_t max) {
+    if (m_listening == false) {
+        return 0;
+    }
+
+    size_t accepted = 0;
+    while (accepted < max) {
+        struct sockaddr_in address;
+        socklen_t len = sizeof(address);
+        int sd = ::accept4(m_lsd, (struct sockaddr*)&address, &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (sd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept4() failed");
+            break;
+        }
+        streams.push_back(new TCPStream(sd, &address));
+        accepted++;
+    }
+    return accepted;
+}
+
+int TCPAcceptor::getDescriptor() {
+    return m_lsd;
+}
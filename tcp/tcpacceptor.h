@@ -1,5 +1,8 @@
+#pragma once
 #include <string>
+#include <vector>
 #include <netinet/in.h>
+#include <sys/socket.h>
 #include "tcpstream.h"
 
 using namespace std;
@@ -8,14 +11,28 @@ class TCPAcceptor {
     int    m_lsd;
     string m_address;
     int    m_port;
+    int    m_backlog;
+    bool   m_reusePort;
     bool   m_listening;
 
     public:
-        TCPAcceptor(int port, const char* address="");
+        // backlog: pending connections the kernel queues (capped by
+        // net.core.somaxconn). reusePort: SO_REUSEPORT, so several
+        // acceptors can bind the same port and the kernel spreads new
+        // connections across them
+        TCPAcceptor(int port, const char* address="", int backlog=SOMAXCONN, bool reusePort=false);
         ~TCPAcceptor();
 
-        int        start();
+        // nonBlocking: accept()/acceptBatch() return instead of waiting
+        // for a connection, as an event loop needs
+        int        start(bool nonBlocking=false);
         TCPStream* accept();
+        // Accepts up to max queued connections, non-blocking and
+        // close-on-exec, into streams; stops early when the queue is
+        // empty. Returns how many were accepted.
+        size_t     acceptBatch(vector<TCPStream*>& streams, size_t max);
+
+        int        getDescriptor();
 
     private:
     TCPAcceptor() {}
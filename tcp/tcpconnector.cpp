@@ -1,4 +1,5 @@
 #include "tcpconnector.h"
+#include <errno.h>
 #include <string.h>
 #include <netdb.h>
 #include <arpa/inet.h>
@@ -14,6 +15,24 @@ TCPStream* TCPConnector::connect(int port, const char* server) {
     }
     int sd = socket(AF_INET, SOCK_STREAM, 0);
     if (::connect(sd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(sd);
+        return NULL;
+    }
+    return new TCPStream(sd, &address);
+}
+
+TCPStream* TCPConnector::connectNonBlocking(int port, const char* server) {
+    struct sockaddr_in address;
+
+    memset (&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (resolveHost(server, &(address.sin_addr)) != 0) {
+        inet_pton(PF_INET, server, &(address.sin_addr));
+    }
+    int sd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (::connect(sd, (struct sockaddr*)&address, sizeof(address)) != 0 && errno != EINPROGRESS) {
+        close(sd);
         return NULL;
     }
     return new TCPStream(sd, &address);
@@ -1,9 +1,14 @@
+#pragma once
 #include <netinet/in.h>
 #include "tcpstream.h"
 
 class TCPConnector {
     public:
         TCPStream* connect(int port, const char* server);
+        // Starts a non-blocking connect and returns at once: the stream
+        // turns writable when the connect completes, and SO_ERROR then
+        // tells whether it succeeded. NULL if it failed outright.
+        TCPStream* connectNonBlocking(int port, const char* server);
 
     private:
         int resolveHost(const char* host, struct in_addr* addr);
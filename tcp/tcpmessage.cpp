@@ -0,0 +1,92 @@
+#include "tcpmessage.h"
+#include <string.h>
+#include <arpa/inet.h>
+
+// Reflected polynomial 0xEDB88320
+struct CRCTable {
+    uint32_t entries[256];
+
+    CRCTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+// Built on first use, safely from any thread
+static const uint32_t* crcTable() {
+    static const CRCTable table;
+    return table.entries;
+}
+
+// crc continues an earlier result, so a checksum can span several buffers
+uint32_t crc32(const char* data, size_t len, uint32_t crc) {
+    const uint32_t* table = crcTable();
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc = table[(crc ^ (uint8_t)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void put16(char* out, uint16_t value) {
+    value = htons(value);
+    memcpy(out, &value, sizeof(value));
+}
+
+static void put32(char* out, uint32_t value) {
+    value = htonl(value);
+    memcpy(out, &value, sizeof(value));
+}
+
+static uint16_t get16(const char* in) {
+    uint16_t value;
+    memcpy(&value, in, sizeof(value));
+    return ntohs(value);
+}
+
+static uint32_t get32(const char* in) {
+    uint32_t value;
+    memcpy(&value, in, sizeof(value));
+    return ntohl(value);
+}
+
+void encodeMessageHeader(char* out, uint16_t type, uint32_t sequence, const char* payload, uint32_t len) {
+    put16(out, MESSAGE_MAGIC);
+    put16(out + 2, type);
+    put32(out + 4, len);
+    put32(out + 8, sequence);
+    put32(out + 12, crc32(payload, len, crc32(out, 12)));
+}
+
+void appendMessage(string& out, uint16_t type, uint32_t sequence, const char* payload, uint32_t len) {
+    char header[MESSAGE_HEADER_SIZE];
+    encodeMessageHeader(header, type, sequence, payload, len);
+    out.append(header, sizeof(header));
+    out.append(payload, len);
+}
+
+ssize_t parseMessage(const char* data, size_t len, MessageView& message) {
+    // The magic is checked as soon as it is there, so garbage is refused
+    // without waiting for a header's worth of it
+    if (len >= 1 && (uint8_t)data[0] != (MESSAGE_MAGIC >> 8)) return -1;
+    if (len < MESSAGE_HEADER_SIZE) return 0;
+    if (get16(data) != MESSAGE_MAGIC) return -1;
+
+    uint32_t length = get32(data + 4);
+    if (length > MAX_MESSAGE_LENGTH) return -1;
+    if (len < MESSAGE_HEADER_SIZE + length) return 0;
+
+    const char* payload = data + MESSAGE_HEADER_SIZE;
+    if (crc32(payload, length, crc32(data, 12)) != get32(data + 12)) return -1;
+
+    message.type = get16(data + 2);
+    message.sequence = get32(data + 8);
+    message.payload = payload;
+    message.length = length;
+    return MESSAGE_HEADER_SIZE + length;
+}
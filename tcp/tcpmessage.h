@@ -0,0 +1,63 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <sys/types.h>
+
+using namespace std;
+
+/*
+    Framed messages over a TCP byte stream. Every message is a fixed
+    16-byte header followed by its payload; header fields are in network
+    byte order:
+
+        magic     uint16  MESSAGE_MAGIC, never a printable byte first, so a
+                          server can tell framed clients from line-based ones
+        type      uint16  MessageType
+        length    uint32  payload bytes, at most MAX_MESSAGE_LENGTH
+        sequence  uint32  chosen by the requester, echoed in the response,
+                          so many requests can be in flight on a connection
+        crc       uint32  CRC32 (IEEE) of the first 12 header bytes and the
+                          payload
+
+    A reader may hold any prefix of a message, or several messages:
+    parseMessage() takes whole messages off the front of what has arrived.
+*/
+
+static const uint16_t MESSAGE_MAGIC = 0xC51F;
+static const size_t MESSAGE_HEADER_SIZE = 16;
+static const uint32_t MAX_MESSAGE_LENGTH = 16 << 20;
+
+enum MessageType {
+    MESSAGE_REQUEST = 1,
+    MESSAGE_RESPONSE = 2,
+    MESSAGE_ERROR = 3
+};
+
+// A parsed message; payload points into the buffer it was parsed from
+struct MessageView {
+    uint16_t    type;
+    uint32_t    sequence;
+    const char* payload;
+    uint32_t    length;
+};
+
+// A received message that owns its payload
+struct TCPMessage {
+    uint16_t type;
+    uint32_t sequence;
+    string   payload;
+};
+
+uint32_t crc32(const char* data, size_t len, uint32_t crc=0);
+
+// Writes the header for payload into out (MESSAGE_HEADER_SIZE bytes)
+void encodeMessageHeader(char* out, uint16_t type, uint32_t sequence, const char* payload, uint32_t len);
+
+// Appends a whole message to out
+void appendMessage(string& out, uint16_t type, uint32_t sequence, const char* payload, uint32_t len);
+
+// Parses the message at the front of data: returns the bytes it takes up,
+// 0 if more bytes are needed, -1 if data does not start with a valid
+// message (bad magic, oversized, or CRC mismatch)
+ssize_t parseMessage(const char* data, size_t len, MessageView& message);
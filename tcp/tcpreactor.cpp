@@ -0,0 +1,731 @@
+#include "tcpreactor.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include "tcpuring.h"
+
+// URING user_data: the connection's address, low bits the operation
+enum {
+    OP_ACCEPT = 1,
+    OP_RECEIVE = 2,
+    OP_SEND = 3,
+    OP_WAKEUP = 4,
+    OP_CANCEL = 5,
+    OP_MASK = 7
+};
+
+static uint64_t tag(void* connection, int op) {
+    return (uint64_t)(uintptr_t)connection | op;
+}
+
+// Replies go out as soon as they are written: a pipelined reply must not
+// wait for the client's delayed ACK of the one before
+void TCPReactor::noDelay(int sd) {
+    int on = 1;
+    m_syscalls++;
+    setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+TCPReactor::Connection::Connection(TCPReactor* reactor, TCPStream* stream)
+    : m_reactor(reactor), m_stream(stream), m_outputOffset(0), m_closing(false), m_paused(false), m_inflight(0),
+      m_receiving(false), m_shutdown(false), m_waitingForSlot(false), m_sendSlot(-1), m_sendLength(0), m_sendDone(0) {}
+
+TCPReactor::Connection::~Connection() {
+    delete m_stream;
+}
+
+TCPStream* TCPReactor::Connection::getStream() {
+    return m_stream;
+}
+
+size_t TCPReactor::Connection::pendingOutput() {
+    return m_output.size() - m_outputOffset;
+}
+
+void TCPReactor::Connection::close() {
+    m_closing = true;
+}
+
+void TCPReactor::Connection::send(const char* buffer, size_t len) {
+    if (m_closing) return;
+    m_output.append(buffer, len);
+}
+
+void TCPReactor::Connection::sendMessage(uint16_t type, uint32_t sequence, const char* payload, uint32_t len) {
+    if (m_closing) return;
+    appendMessage(m_output, type, sequence, payload, len);
+}
+
+// EPOLL: writes pending output until the socket would block; false if the
+// peer is gone
+bool TCPReactor::Connection::flush() {
+    while (m_outputOffset < m_output.size()) {
+        m_reactor->m_syscalls++;
+        ssize_t n = ::send(m_stream->getDescriptor(), m_output.data() + m_outputOffset,
+                           m_output.size() - m_outputOffset, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;  // EPOLLOUT resumes
+            m_closing = true;
+            return false;
+        }
+        m_outputOffset += n;
+    }
+    m_output.clear();
+    m_outputOffset = 0;
+    return true;
+}
+
+TCPReactor::TCPReactor(TCPAcceptor* acceptor, Handler handler, Engine engine)
+    : m_acceptor(acceptor), m_handler(handler), m_engine(engine), m_epoll(-1), m_running(true),
+      m_acceptPending(false), m_accepted(0), m_requests(0), m_syscalls(0), m_uring(NULL),
+      m_recvBuffers(NULL), m_sendBuffers(NULL), m_accepting(false), m_wakeValue(0) {
+    if (m_engine == URING) {
+        // Blocking: io_uring fails a read of a non-blocking fd that has
+        // nothing to read yet instead of waiting for it
+        m_wakeup = eventfd(0, EFD_CLOEXEC);
+        return;  // the ring is set up by the thread that runs it
+    }
+    m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    m_readBuffer.resize(READ_SIZE);
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+
+    // data.ptr NULL marks the listener, the reactor itself the wakeup fd
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLET;
+    event.data.ptr = NULL;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_acceptor->getDescriptor(), &event);
+    event.events = EPOLLIN;
+    event.data.ptr = this;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+}
+
+TCPReactor::~TCPReactor() {
+    for (auto& entry : m_connections) {
+        delete entry.second;
+    }
+    close(m_wakeup);
+    if (m_epoll >= 0) close(m_epoll);
+}
+
+int TCPReactor::run() {
+    return m_engine == URING ? runUring() : runEpoll();
+}
+
+void TCPReactor::stop() {
+    m_running = false;
+    uint64_t one = 1;
+    ssize_t written = write(m_wakeup, &one, sizeof(one));
+    (void)written;
+}
+
+TCPReactor::Engine TCPReactor::getEngine() {
+    return m_engine;
+}
+
+size_t TCPReactor::getConnections() {
+    return m_connections.size();
+}
+
+size_t TCPReactor::getAccepted() {
+    return m_accepted;
+}
+
+size_t TCPReactor::getRequests() {
+    return m_requests;
+}
+
+size_t TCPReactor::getSyscalls() {
+    return m_syscalls;
+}
+
+// Runs the handler over data until it stops consuming, or its replies
+// pass OUTPUT_LIMIT; returns the bytes consumed
+size_t TCPReactor::consume(Connection* connection, const char* data, size_t len) {
+    size_t offset = 0;
+    while (offset < len && !connection->m_closing && connection->pendingOutput() <= OUTPUT_LIMIT) {
+        size_t used = m_handler(*connection, data + offset, len - offset);
+        if (used == 0) break;
+        offset += used;
+        m_requests++;
+    }
+    return offset;
+}
+
+int TCPReactor::runEpoll() {
+    if (m_epoll < 0 || m_wakeup < 0) {
+        perror("epoll setup failed");
+        return -1;
+    }
+
+    vector<struct epoll_event> events(MAX_EVENTS);
+
+    while (m_running) {
+        // Listener backlog left from the last pass: poll, don't wait
+        m_syscalls++;
+        int n = epoll_wait(m_epoll, events.data(), events.size(), m_acceptPending ? 0 : -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait() failed");
+            return -1;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            void* ptr = events[i].data.ptr;
+            if (ptr == NULL) {
+                m_acceptPending = true;
+                continue;
+            }
+            if (ptr == this) {
+                uint64_t count;
+                while (read(m_wakeup, &count, sizeof(count)) > 0) {}
+                continue;
+            }
+
+            Connection* connection = static_cast<Connection*>(ptr);
+            uint32_t flags = events[i].events;
+            if (flags & (EPOLLERR | EPOLLHUP)) {
+                connection->m_closing = true;
+            } else {
+                if ((flags & (EPOLLIN | EPOLLRDHUP)) && !connection->m_paused) readFrom(connection);
+                if ((flags & EPOLLOUT) && !connection->m_closing) {
+                    connection->flush();
+                    // Drained enough: what arrived meanwhile is still
+                    // queued, and edge triggering won't report it again
+                    if (connection->m_paused && connection->pendingOutput() <= OUTPUT_LIMIT) readFrom(connection);
+                }
+            }
+            if (connection->m_closing) closeConnection(connection);
+        }
+
+        if (m_acceptPending) acceptConnections();
+    }
+    return 0;
+}
+
+void TCPReactor::acceptConnections() {
+    m_batch.clear();
+    size_t accepted = m_acceptor->acceptBatch(m_batch, ACCEPT_BATCH);
+    // A full batch may have left more queued; edge-triggered epoll will
+    // not report them again, so the next pass polls
+    m_acceptPending = accepted == ACCEPT_BATCH;
+    m_syscalls += accepted + (m_acceptPending ? 0 : 1);
+
+    for (size_t i = 0; i < m_batch.size(); ++i) {
+        noDelay(m_batch[i]->getDescriptor());
+        Connection* connection = new Connection(this, m_batch[i]);
+        struct epoll_event event;
+        // Both directions from the start: with edge triggering EPOLLOUT only
+        // fires when the socket drains, so it never needs re-arming
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = connection;
+        m_syscalls++;
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_batch[i]->getDescriptor(), &event) != 0) {
+            perror("epoll_ctl() failed");
+            delete connection;
+            continue;
+        }
+        m_connections[m_batch[i]->getDescriptor()] = connection;
+    }
+    m_accepted.fetch_add(m_batch.size(), memory_order_relaxed);
+}
+
+// Reads until the socket runs dry (edge triggering reports it once),
+// handing each read to the handler. Replies piling up past OUTPUT_LIMIT
+// stop it early with the rest left in the socket; EPOLLOUT resumes.
+void TCPReactor::readFrom(Connection* connection) {
+    int sd = connection->m_stream->getDescriptor();
+    string& input = connection->m_input;
+    bool eof = false;
+
+    connection->m_paused = false;
+    while (!connection->m_closing) {
+        // What was just read, or held back by the output limit
+        input.erase(0, consume(connection, input.data(), input.size()));
+        if (input.size() > INPUT_LIMIT) {
+            connection->m_closing = true;
+            break;
+        }
+        if (connection->pendingOutput() > OUTPUT_LIMIT) {
+            connection->flush();
+            if (connection->pendingOutput() > OUTPUT_LIMIT) {
+                connection->m_paused = true;
+                return;
+            }
+            continue;
+        }
+
+        m_syscalls++;
+        ssize_t n = read(sd, m_readBuffer.data(), m_readBuffer.size());
+        if (n > 0) {
+            input.append(m_readBuffer.data(), n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) eof = true;
+        break;
+    }
+
+    if (!connection->m_closing) connection->flush();
+
+    if (eof) connection->m_closing = true;
+}
+
+void TCPReactor::closeConnection(Connection* connection) {
+    // Closing the fd removes it from the epoll set
+    m_syscalls++;
+    m_connections.erase(connection->m_stream->getDescriptor());
+    delete connection;
+}
+
+int TCPReactor::runUring() {
+    if (!setupUring()) {
+        perror("io_uring setup failed");
+        teardownUring();
+        return -1;
+    }
+
+    armAccept();
+    armWakeup();
+    int result = 0;
+    bool draining = false;
+
+    while (true) {
+        if (!m_running && !draining) {
+            // Cancel the accept and shut every connection down, then run
+            // until their last completions are in: the kernel must be done
+            // with every buffer before they are freed
+            draining = true;
+            struct io_uring_sqe* sqe = nextSqe();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = tag(NULL, OP_ACCEPT);
+            sqe->user_data = tag(NULL, OP_CANCEL);
+
+            vector<Connection*> open;
+            for (auto& entry : m_connections) {
+                open.push_back(entry.second);
+            }
+            for (size_t i = 0; i < open.size(); ++i) {
+                open[i]->m_closing = true;
+                closeUring(open[i]);
+            }
+        }
+        if (draining && m_connections.empty() && !m_accepting) break;
+
+        // Everything queued since the last pass goes in with the wait
+        m_syscalls++;
+        int submitted = m_uring->submit(1);
+        if (submitted < 0 && submitted != -EINTR && submitted != -EAGAIN && submitted != -EBUSY) {
+            errno = -submitted;
+            perror("io_uring_enter() failed");
+            result = -1;
+            break;
+        }
+
+        struct io_uring_cqe* cqe;
+        while ((cqe = m_uring->peek()) != NULL) {
+            Connection* connection = (Connection*)(uintptr_t)(cqe->user_data & ~(uint64_t)OP_MASK);
+            switch (cqe->user_data & OP_MASK) {
+                case OP_ACCEPT:
+                    onAccept(cqe);
+                    break;
+                case OP_RECEIVE:
+                    onReceive(connection, cqe);
+                    break;
+                case OP_SEND:
+                    onSend(connection, cqe);
+                    break;
+                case OP_WAKEUP:
+                    if (m_running) armWakeup();
+                    break;
+            }
+            m_uring->seen();
+        }
+        m_recvBuffers->publish();
+    }
+
+    teardownUring();
+    return result;
+}
+
+bool TCPReactor::setupUring() {
+    // Completions run on this thread when it waits, not by interrupting it,
+    // where the kernel supports it
+    unsigned flags[] = {
+        IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+        IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN,
+        0
+    };
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); ++i) {
+        m_uring = new IOUring(URING_ENTRIES, flags[i]);
+        if (m_uring->isValid()) break;
+        delete m_uring;
+        m_uring = NULL;
+    }
+    if (m_uring == NULL) return false;
+    m_syscalls++;
+
+    m_recvBuffers = new IOUringBufferRing(*m_uring, 0, RECV_BUFFERS, RECV_BUFFER_SIZE);
+    if (!m_recvBuffers->isValid()) return false;
+
+    // One registered region, handed out in SEND_SLOT_SIZE slots
+    void* memory = mmap(NULL, SEND_SLOTS * SEND_SLOT_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return false;
+    m_sendBuffers = (char*)memory;
+    struct iovec region;
+    region.iov_base = m_sendBuffers;
+    region.iov_len = SEND_SLOTS * SEND_SLOT_SIZE;
+    int registered = m_uring->registerBuffers(&region, 1);
+    if (registered < 0) {
+        errno = -registered;
+        return false;
+    }
+    for (unsigned i = 0; i < SEND_SLOTS; ++i) {
+        m_freeSlots.push_back(SEND_SLOTS - 1 - i);
+    }
+    return true;
+}
+
+void TCPReactor::teardownUring() {
+    // The ring goes first: closing it releases the kernel's hold on the
+    // buffers before their memory is unmapped
+    delete m_uring;
+    m_uring = NULL;
+    delete m_recvBuffers;
+    m_recvBuffers = NULL;
+    if (m_sendBuffers != NULL) munmap(m_sendBuffers, SEND_SLOTS * SEND_SLOT_SIZE);
+    m_sendBuffers = NULL;
+    m_freeSlots.clear();
+    m_slotWaiters.clear();
+}
+
+struct io_uring_sqe* TCPReactor::nextSqe() {
+    struct io_uring_sqe* sqe;
+    while ((sqe = m_uring->getSqe()) == NULL) {
+        // Queue full: hand it to the kernel without waiting
+        m_syscalls++;
+        m_uring->submit(0);
+    }
+    return sqe;
+}
+
+// One SQE that keeps producing a completion per accepted connection
+void TCPReactor::armAccept() {
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = m_acceptor->getDescriptor();
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->user_data = tag(NULL, OP_ACCEPT);
+    m_accepting = true;
+}
+
+// One SQE that keeps receiving into buffers the kernel takes from the ring
+void TCPReactor::armReceive(Connection* connection) {
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = connection->m_stream->getDescriptor();
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->user_data = tag(connection, OP_RECEIVE);
+    connection->m_receiving = true;
+    connection->m_inflight++;
+}
+
+void TCPReactor::armWakeup() {
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = m_wakeup;
+    sqe->addr = (uint64_t)(uintptr_t)&m_wakeValue;
+    sqe->len = sizeof(m_wakeValue);
+    sqe->user_data = tag(NULL, OP_WAKEUP);
+}
+
+void TCPReactor::onAccept(struct io_uring_cqe* cqe) {
+    if (cqe->res >= 0) {
+        int sd = cqe->res;
+        struct sockaddr_in address;
+        socklen_t len = sizeof(address);
+        memset(&address, 0, sizeof(address));
+        m_syscalls++;
+        getpeername(sd, (struct sockaddr*)&address, &len);
+        noDelay(sd);
+
+        Connection* connection = new Connection(this, new TCPStream(sd, &address));
+        m_connections[sd] = connection;
+        m_accepted.fetch_add(1, memory_order_relaxed);
+        if (m_running) {
+            armReceive(connection);
+        } else {
+            connection->m_closing = true;
+            closeUring(connection);
+        }
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        m_accepting = false;
+        if (m_running) armAccept();
+    }
+}
+
+void TCPReactor::onReceive(Connection* connection, struct io_uring_cqe* cqe) {
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        connection->m_receiving = false;
+        connection->m_inflight--;
+    }
+
+    if (cqe->res > 0) {
+        unsigned short id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+        const char* data = m_recvBuffers->getBuffer(id);
+        size_t len = cqe->res;
+        string& input = connection->m_input;
+        if (connection->m_closing) {
+            // Shut down already: nobody is listening
+        } else if (input.empty()) {
+            // Straight from the kernel's buffer; only a partial command
+            // is copied
+            size_t used = consume(connection, data, len);
+            input.append(data + used, len - used);
+        } else {
+            input.append(data, len);
+            input.erase(0, consume(connection, input.data(), input.size()));
+        }
+        if (input.size() > INPUT_LIMIT) connection->m_closing = true;
+        m_recvBuffers->recycle(id);
+        if (!connection->m_closing) {
+            submitSend(connection);
+            if (connection->pendingOutput() > OUTPUT_LIMIT) pauseReceive(connection);
+        }
+    } else if (cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+        // 0 is end of stream. ENOBUFS: every buffer was in use, so the
+        // receive stopped; it is re-armed once they are published again.
+        // ECANCELED: pauseReceive stopped it.
+        connection->m_closing = true;
+    }
+
+    if (connection->m_closing) {
+        closeUring(connection);
+    } else if (!connection->m_receiving && !connection->m_paused) {
+        armReceive(connection);
+    }
+}
+
+// Cancels the multishot receive of a client whose replies are past
+// OUTPUT_LIMIT; completions already on their way are still buffered
+void TCPReactor::pauseReceive(Connection* connection) {
+    if (connection->m_paused) return;
+    connection->m_paused = true;
+    if (!connection->m_receiving) return;
+
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = tag(connection, OP_RECEIVE);
+    sqe->user_data = tag(NULL, OP_CANCEL);
+}
+
+// Once sends have drained the output below OUTPUT_LIMIT: handles the
+// input held back and receives again
+void TCPReactor::resumeReceive(Connection* connection) {
+    if (!connection->m_paused || connection->pendingOutput() > OUTPUT_LIMIT) return;
+    connection->m_paused = false;
+
+    string& input = connection->m_input;
+    input.erase(0, consume(connection, input.data(), input.size()));
+    if (connection->m_closing) return;
+
+    submitSend(connection);
+    if (connection->pendingOutput() > OUTPUT_LIMIT) {
+        pauseReceive(connection);
+    } else if (!connection->m_receiving) {
+        armReceive(connection);
+    }
+}
+
+// Copies the next chunk of output into a free registered slot and
+// writes it from there; one write per connection in flight keeps the
+// bytes in order
+void TCPReactor::submitSend(Connection* connection) {
+    if (connection->m_sendSlot >= 0 || connection->m_shutdown) return;  // onSend continues
+    size_t pending = connection->pendingOutput();
+    if (pending == 0) return;
+
+    if (m_freeSlots.empty()) {
+        if (!connection->m_waitingForSlot) {
+            connection->m_waitingForSlot = true;
+            m_slotWaiters.push_back(connection);
+        }
+        return;
+    }
+    int slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+
+    size_t len = pending < SEND_SLOT_SIZE ? pending : SEND_SLOT_SIZE;
+    memcpy(m_sendBuffers + slot * SEND_SLOT_SIZE, connection->m_output.data() + connection->m_outputOffset, len);
+    connection->m_outputOffset += len;
+    if (connection->m_outputOffset == connection->m_output.size()) {
+        connection->m_output.clear();
+        connection->m_outputOffset = 0;
+    }
+
+    connection->m_sendSlot = slot;
+    connection->m_sendLength = len;
+    connection->m_sendDone = 0;
+    queueWrite(connection);
+}
+
+void TCPReactor::queueWrite(Connection* connection) {
+    struct io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = connection->m_stream->getDescriptor();
+    sqe->addr = (uint64_t)(uintptr_t)(m_sendBuffers + connection->m_sendSlot * SEND_SLOT_SIZE + connection->m_sendDone);
+    sqe->len = (uint32_t)(connection->m_sendLength - connection->m_sendDone);
+    sqe->off = 0;  // sockets have no position; anything else is ESPIPE
+    sqe->buf_index = 0;
+    sqe->user_data = tag(connection, OP_SEND);
+    connection->m_inflight++;
+}
+
+void TCPReactor::onSend(Connection* connection, struct io_uring_cqe* cqe) {
+    connection->m_inflight--;
+    if (cqe->res < 0) {
+        connection->m_closing = true;
+    } else {
+        connection->m_sendDone += cqe->res;
+        if (connection->m_sendDone < connection->m_sendLength && !connection->m_closing) {
+            queueWrite(connection);  // short write: the rest of the slot
+            return;
+        }
+    }
+
+    int slot = connection->m_sendSlot;
+    connection->m_sendSlot = -1;
+    releaseSlot(slot);
+
+    if (!connection->m_closing) {
+        submitSend(connection);
+        resumeReceive(connection);
+    }
+    if (connection->m_closing) closeUring(connection);
+}
+
+void TCPReactor::releaseSlot(int slot) {
+    m_freeSlots.push_back(slot);
+    while (!m_freeSlots.empty() && !m_slotWaiters.empty()) {
+        Connection* waiter = m_slotWaiters.front();
+        m_slotWaiters.pop_front();
+        waiter->m_waitingForSlot = false;
+        submitSend(waiter);
+    }
+}
+
+// Shuts the socket down, which ends its receive and any write in flight;
+// the connection is freed with its last completion
+void TCPReactor::closeUring(Connection* connection) {
+    int sd = connection->m_stream->getDescriptor();
+    if (!connection->m_shutdown) {
+        connection->m_shutdown = true;
+        m_syscalls++;
+        shutdown(sd, SHUT_RDWR);
+        if (connection->m_waitingForSlot) {
+            for (size_t i = 0; i < m_slotWaiters.size(); ++i) {
+                if (m_slotWaiters[i] == connection) {
+                    m_slotWaiters.erase(m_slotWaiters.begin() + i);
+                    break;
+                }
+            }
+            connection->m_waitingForSlot = false;
+        }
+    }
+    if (connection->m_inflight == 0) {
+        m_connections.erase(sd);
+        delete connection;
+    }
+}
+
+TCPReactorPool::TCPReactorPool(int port, const char* address, int backlog, int reactors, TCPReactor::Handler handler,
+                               TCPReactor::Engine engine)
+    : m_port(port), m_address(address), m_backlog(backlog), m_handler(handler), m_engine(engine), m_published(0),
+      m_stopped(false) {
+    if (reactors <= 0) {
+        reactors = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    for (int i = 0; i < reactors; ++i) {
+        m_acceptors.push_back(new TCPAcceptor(m_port, m_address.c_str(), m_backlog, true));
+    }
+    m_reactors.reserve(reactors);  // never reallocated under a concurrent stop()
+}
+
+TCPReactorPool::~TCPReactorPool() {
+    for (size_t i = 0; i < m_reactors.size(); ++i) {
+        delete m_reactors[i];
+    }
+    for (size_t i = 0; i < m_acceptors.size(); ++i) {
+        delete m_acceptors[i];
+    }
+}
+
+int TCPReactorPool::run() {
+    for (size_t i = 0; i < m_acceptors.size(); ++i) {
+        // The epoll engine needs non-blocking listeners, io_uring waits
+        // for connections itself
+        if (m_acceptors[i]->start(m_engine == TCPReactor::EPOLL) != 0) {
+            return -1;
+        }
+        m_reactors.push_back(new TCPReactor(m_acceptors[i], m_handler, m_engine));
+        m_published.store(m_reactors.size());
+    }
+
+    // A stop() that came in while the reactors were being made only saw
+    // those published by then; stopping the rest here means none is
+    // missed, and a reactor stopped before it runs returns at once
+    if (m_stopped) {
+        for (size_t i = 0; i < m_reactors.size(); ++i) {
+            m_reactors[i]->stop();
+        }
+    }
+
+    int cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    vector<int> results(m_reactors.size(), 0);
+    vector<thread> threads;
+    for (size_t i = 0; i < m_reactors.size(); ++i) {
+        threads.push_back(thread([this, i, cpus, &results]() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % cpus, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            results[i] = m_reactors[i]->run();
+        }));
+    }
+
+    int result = 0;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+        if (results[i] != 0) result = -1;
+    }
+    return result;
+}
+
+void TCPReactorPool::stop() {
+    m_stopped = true;
+    size_t published = m_published.load();
+    for (size_t i = 0; i < published; ++i) {
+        m_reactors[i]->stop();
+    }
+}
+
+int TCPReactorPool::getReactors() {
+    return (int)m_acceptors.size();
+}
+
+TCPReactor* TCPReactorPool::getReactor(int reactor) {
+    return reactor < (int)m_reactors.size() ? m_reactors[reactor] : NULL;
+}
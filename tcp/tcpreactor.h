@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <linux/io_uring.h>
+#include "tcpacceptor.h"
+#include "tcpmessage.h"
+#include "tcpstream.h"
+
+using namespace std;
+
+class IOUring;
+class IOUringBufferRing;
+
+/*
+    Single-threaded event loop serving every connection of one listener,
+    on one of two I/O engines chosen at construction:
+
+    EPOLL   an edge-triggered epoll set over non-blocking sockets; one
+            read()/send() syscall per buffer moved, accept4 in batches of
+            up to ACCEPT_BATCH per loop pass so a connect storm cannot
+            starve established clients
+    URING   io_uring: one multishot accept, one multishot recv per
+            connection filling buffers the kernel picks from a provided
+            buffer ring, and sends from registered (fixed) buffers. Every
+            operation queued during a loop pass is submitted, and the
+            next completions waited for, in a single io_uring_enter.
+            Sends are fixed-buffer writes, which have no MSG_NOSIGNAL:
+            the process must ignore SIGPIPE, or a client that goes away
+            mid-reply kills it.
+
+    Each connection has an input buffer for what the handler has not
+    consumed yet and an output buffer for what the socket has not taken.
+    The handler sees all buffered input and returns how much of it it
+    consumed; the rest waits for more bytes. A client that does not read
+    its replies is not served further: past OUTPUT_LIMIT bytes of pending
+    output the reactor stops reading from it and calling the handler, and
+    carries on once the socket has drained the output below the limit.
+*/
+class TCPReactor {
+    public:
+        enum Engine { EPOLL, URING };
+
+        class Connection {
+            TCPReactor* m_reactor;
+            TCPStream*  m_stream;
+            string      m_input;
+            string      m_output;
+            size_t      m_outputOffset;
+            bool        m_closing;
+            bool        m_paused;       // output over OUTPUT_LIMIT, not reading
+            // URING: operations in flight, and the send buffer in use
+            int         m_inflight;
+            bool        m_receiving;
+            bool        m_shutdown;
+            bool        m_waitingForSlot;
+            int         m_sendSlot;
+            size_t      m_sendLength;
+            size_t      m_sendDone;
+
+            public:
+                friend class TCPReactor;
+
+                // Queues data after any pending output. Everything queued
+                // goes out once the handler returns, so replies to
+                // pipelined requests share syscalls; what the socket does
+                // not take at once follows as it drains.
+                void send(const char* buffer, size_t len);
+                // Queues a framed message (see tcpmessage.h)
+                void sendMessage(uint16_t type, uint32_t sequence, const char* payload, uint32_t len);
+                // Closes once the handler returns; pending output is dropped
+                void close();
+
+                TCPStream* getStream();
+                size_t     pendingOutput();
+
+            private:
+                Connection(TCPReactor* reactor, TCPStream* stream);
+                ~Connection();
+                bool flush();
+        };
+
+        // Returns the bytes of data consumed, 0 to wait for more
+        typedef function<size_t(Connection& connection, const char* data, size_t len)> Handler;
+
+        static const size_t ACCEPT_BATCH = 64;
+        static const size_t MAX_EVENTS = 1024;
+        static const size_t READ_SIZE = 64 * 1024;
+        static const size_t INPUT_LIMIT = 1 << 20;   // unconsumed bytes before a client is dropped
+        static const size_t OUTPUT_LIMIT = 1 << 20;  // unsent bytes before a client is not read from
+        static const unsigned URING_ENTRIES = 4096;
+        static const unsigned RECV_BUFFERS = 1024;   // provided buffer ring, power of two
+        static const size_t RECV_BUFFER_SIZE = 4096;
+        static const unsigned SEND_SLOTS = 512;      // registered send buffers
+        static const size_t SEND_SLOT_SIZE = 8192;
+
+        // acceptor must outlive the reactor, started non-blocking for EPOLL
+        // and blocking for URING
+        TCPReactor(TCPAcceptor* acceptor, Handler handler, Engine engine=EPOLL);
+        ~TCPReactor();
+
+        // Serves until stop(), even one made before run(); returns 0, or
+        // -1 if the engine cannot be set up or fails
+        int    run();
+        // From any thread, a signal handler, or the handler
+        void   stop();
+
+        Engine getEngine();
+        size_t getConnections();
+        // Connections accepted since construction; readable from any thread
+        size_t getAccepted();
+        // Handler calls that consumed input, and the syscalls made serving
+        // them; read once run() has returned
+        size_t getRequests();
+        size_t getSyscalls();
+
+    private:
+        TCPAcceptor*         m_acceptor;
+        Handler              m_handler;
+        Engine               m_engine;
+        int                  m_epoll;
+        int                  m_wakeup;      // eventfd that interrupts the wait for stop()
+        atomic<bool>         m_running;
+        bool                 m_acceptPending;
+        unordered_map<int, Connection*> m_connections;  // by descriptor
+        atomic<size_t>       m_accepted;
+        size_t               m_requests;
+        size_t               m_syscalls;
+        vector<TCPStream*>   m_batch;
+        vector<char>         m_readBuffer;
+
+        // URING
+        IOUring*             m_uring;
+        IOUringBufferRing*   m_recvBuffers;
+        char*                m_sendBuffers;
+        vector<int>          m_freeSlots;
+        deque<Connection*>   m_slotWaiters;
+        bool                 m_accepting;
+        uint64_t             m_wakeValue;
+
+        void noDelay(int sd);
+
+        int  runEpoll();
+        void acceptConnections();
+        void readFrom(Connection* connection);
+        void closeConnection(Connection* connection);
+        size_t consume(Connection* connection, const char* data, size_t len);
+
+        int  runUring();
+        bool setupUring();
+        void teardownUring();
+        struct io_uring_sqe* nextSqe();
+        void armAccept();
+        void armReceive(Connection* connection);
+        void pauseReceive(Connection* connection);
+        void resumeReceive(Connection* connection);
+        void armWakeup();
+        void submitSend(Connection* connection);
+        void queueWrite(Connection* connection);
+        void onAccept(struct io_uring_cqe* cqe);
+        void onReceive(Connection* connection, struct io_uring_cqe* cqe);
+        void onSend(Connection* connection, struct io_uring_cqe* cqe);
+        void releaseSlot(int slot);
+        void closeUring(Connection* connection);
+
+        TCPReactor(const TCPReactor&);
+        TCPReactor& operator=(const TCPReactor&);
+};
+
+/*
+    One TCPReactor per thread, each pinned to its own CPU with its own
+    SO_REUSEPORT listener on the same port. They share nothing: the
+    kernel spreads new connections across the listeners, and a connection
+    stays on the reactor that accepted it. The handler runs on every
+    reactor thread concurrently.
+*/
+class TCPReactorPool {
+    public:
+        // reactors 0: one per online CPU
+        TCPReactorPool(int port, const char* address, int backlog, int reactors, TCPReactor::Handler handler,
+                       TCPReactor::Engine engine=TCPReactor::EPOLL);
+        ~TCPReactorPool();
+
+        // Binds every listener, then serves until stop(); returns 0, or -1
+        // if a listener cannot be bound or a reactor fails
+        int    run();
+        // From any thread, or a signal handler; also before run() or while
+        // it is still setting up, which then serves nothing
+        void   stop();
+
+        int         getReactors();
+        TCPReactor* getReactor(int reactor);
+
+    private:
+        int                  m_port;
+        string               m_address;
+        int                  m_backlog;
+        TCPReactor::Handler  m_handler;
+        TCPReactor::Engine   m_engine;
+        vector<TCPAcceptor*> m_acceptors;
+        vector<TCPReactor*>  m_reactors;
+        atomic<size_t>       m_published;   // m_reactors stop() may use
+        atomic<bool>         m_stopped;
+
+        TCPReactorPool(const TCPReactorPool&);
+        TCPReactorPool& operator=(const TCPReactorPool&);
+};
@@ -1,7 +1,10 @@
 #include "tcpstream.h"
+#include <errno.h>
+#include <poll.h>
 #include <arpa/inet.h>
+#include <sys/uio.h>
 
-TCPStream::TCPStream(int sd, struct sockaddr_in* address) : m_sd(sd) {
+TCPStream::TCPStream(int sd, struct sockaddr_in* address) : m_sd(sd), m_receivedOffset(0) {
     char ip[50];
     inet_ntop(PF_INET, (struct in_addr*)&(address->sin_addr.s_addr), ip, sizeof(ip) - 1);
 
@@ -21,6 +24,10 @@ int TCPStream::getPeerPort() {
     return m_peerPort;
 }
 
+int TCPStream::getDescriptor() {
+    return m_sd;
+}
+
 ssize_t TCPStream::send(const char* buffer, ssize_t len) {
     return write(m_sd, buffer, len);
 }
@@ -28,3 +35,65 @@ ssize_t TCPStream::send(const char* buffer, ssize_t len) {
 ssize_t TCPStream::receive(char* buffer, ssize_t len) {
     return read(m_sd, buffer, len);
 }
+
+ssize_t TCPStream::sendMessage(uint16_t type, uint32_t sequence, const char* payload, uint32_t len) {
+    char header[MESSAGE_HEADER_SIZE];
+    encodeMessageHeader(header, type, sequence, payload, len);
+
+    // Header and payload in one syscall, resumed after short writes
+    struct iovec parts[2] = {{header, sizeof(header)}, {(void*)payload, len}};
+    struct iovec* part = parts;
+    int count = 2;
+    size_t total = sizeof(header) + len;
+    size_t left = total;
+    while (left > 0) {
+        ssize_t n = writev(m_sd, part, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                struct pollfd pfd = {m_sd, POLLOUT, 0};
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            return -1;
+        }
+        left -= n;
+        while (count > 0 && (size_t)n >= part->iov_len) {
+            n -= part->iov_len;
+            part++;
+            count--;
+        }
+        if (count > 0) {
+            part->iov_base = (char*)part->iov_base + n;
+            part->iov_len -= n;
+        }
+    }
+    return total;
+}
+
+ssize_t TCPStream::recvMessage(TCPMessage& message) {
+    while (true) {
+        MessageView view;
+        ssize_t used = parseMessage(m_received.data() + m_receivedOffset, m_received.size() - m_receivedOffset, view);
+        if (used < 0) {
+            errno = EBADMSG;
+            return -1;
+        }
+        if (used > 0) {
+            message.type = view.type;
+            message.sequence = view.sequence;
+            message.payload.assign(view.payload, view.length);
+            m_receivedOffset += used;
+            return used;
+        }
+
+        // Partial message: move it to the front, then read more behind it
+        m_received.erase(0, m_receivedOffset);
+        m_receivedOffset = 0;
+        char buffer[64 * 1024];
+        ssize_t n = read(m_sd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return n;
+        m_received.append(buffer, n);
+    }
+}
@@ -1,7 +1,9 @@
+#pragma once
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <string>
+#include "tcpmessage.h"
 
 using namespace std;
 
@@ -9,18 +11,34 @@ class TCPStream {
     int m_sd;
     string m_peerIP;
     int m_peerPort;
+    string m_received;        // bytes read past the last whole message
+    size_t m_receivedOffset;
 
     public:
         friend class TCPAcceptor;
         friend class TCPConnector;
+        friend class TCPReactor;
 
         ~TCPStream();
 
         ssize_t send(const char* buffer, ssize_t len);
         ssize_t receive(char* buffer, ssize_t len);
 
+        // Framed messages (see tcpmessage.h). sendMessage writes the whole
+        // message, waiting for the socket if it is non-blocking; returns
+        // the bytes written or -1.
+        ssize_t sendMessage(uint16_t type, uint32_t sequence, const char* payload, uint32_t len);
+        // Reads until a whole message is in, keeping any bytes after it for
+        // the next call, so pipelined responses can be read one by one.
+        // Returns the message's size with its header (never 0, even for an
+        // empty payload); 0 when the peer closed; -1 on error
+        // (errno EBADMSG for a corrupt message, EAGAIN when a non-blocking
+        // socket has no whole message yet).
+        ssize_t recvMessage(TCPMessage& message);
+
         string getPeerIP();
         int getPeerPort();
+        int getDescriptor();
 
     private:
         TCPStream(int sd, struct sockaddr_in* address);
@@ -0,0 +1,226 @@
+#include "tcpuring.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+// The kernel reads the SQ tail and writes the CQ tail concurrently
+static unsigned loadAcquire(const unsigned* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void storeRelease(unsigned* p, unsigned value) {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+IOUring::IOUring(unsigned entries, unsigned flags)
+    : m_fd(-1), m_entries(0), m_sqQueued(0), m_sqSubmitted(0), m_rings(MAP_FAILED),
+      m_ringsSize(0), m_sqesSize(0), m_enters(0) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = flags;
+    m_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (m_fd < 0) return;
+
+    // One mapping for both rings: every kernel this code needs
+    // (multishot recv is 6.0+) has IORING_FEAT_SINGLE_MMAP
+    size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    m_ringsSize = sqSize > cqSize ? sqSize : cqSize;
+    m_rings = mmap(NULL, m_ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(NULL, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+    if (m_rings == MAP_FAILED || sqes == MAP_FAILED || !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        if (sqes != MAP_FAILED) munmap(sqes, m_sqesSize);
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    char* base = (char*)m_rings;
+    m_entries = params.sq_entries;
+    m_sqMask = *(unsigned*)(base + params.sq_off.ring_mask);
+    m_sqHead = (unsigned*)(base + params.sq_off.head);
+    m_sqTail = (unsigned*)(base + params.sq_off.tail);
+    m_sqes = (struct io_uring_sqe*)sqes;
+    m_cqMask = *(unsigned*)(base + params.cq_off.ring_mask);
+    m_cqHead = (unsigned*)(base + params.cq_off.head);
+    m_cqTail = (unsigned*)(base + params.cq_off.tail);
+    m_cqes = (struct io_uring_cqe*)(base + params.cq_off.cqes);
+
+    // SQ slot i always holds SQE i, so only the tail ever moves
+    unsigned* array = (unsigned*)(base + params.sq_off.array);
+    for (unsigned i = 0; i < m_entries; ++i) array[i] = i;
+    m_sqQueued = m_sqSubmitted = *m_sqTail;
+}
+
+IOUring::~IOUring() {
+    if (m_fd < 0) return;
+    munmap(m_sqes, m_sqesSize);
+    munmap(m_rings, m_ringsSize);
+    close(m_fd);
+}
+
+bool IOUring::isValid() {
+    return m_fd >= 0;
+}
+
+struct io_uring_sqe* IOUring::getSqe() {
+    if (m_sqQueued - loadAcquire(m_sqHead) >= m_entries) return NULL;
+    struct io_uring_sqe* sqe = &m_sqes[m_sqQueued & m_sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+    m_sqQueued++;
+    return sqe;
+}
+
+int IOUring::submit(unsigned waitFor) {
+    unsigned count = m_sqQueued - m_sqSubmitted;
+    if (count == 0 && waitFor == 0) return 0;
+
+    storeRelease(m_sqTail, m_sqQueued);
+    m_enters++;
+    int result = (int)syscall(__NR_io_uring_enter, m_fd, count, waitFor,
+                              waitFor > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    if (result < 0) return -errno;
+    m_sqSubmitted += result;
+    return result;
+}
+
+struct io_uring_cqe* IOUring::peek() {
+    unsigned head = *m_cqHead;
+    if (head == loadAcquire(m_cqTail)) return NULL;
+    return &m_cqes[head & m_cqMask];
+}
+
+void IOUring::seen() {
+    storeRelease(m_cqHead, *m_cqHead + 1);
+}
+
+int IOUring::registerBuffers(const struct iovec* buffers, unsigned count) {
+    int result = (int)syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers, count);
+    return result < 0 ? -errno : result;
+}
+
+int IOUring::registerBufferRing(struct io_uring_buf_ring* ring, unsigned entries, unsigned short group) {
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)ring;
+    reg.ring_entries = entries;
+    reg.bgid = group;
+    int result = (int)syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING, &reg, 1);
+    return result < 0 ? -errno : result;
+}
+
+int IOUring::unregisterBufferRing(unsigned short group) {
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = group;
+    int result = (int)syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+    return result < 0 ? -errno : result;
+}
+
+uint64_t IOUring::getEnters() {
+    return m_enters;
+}
+
+IOUringBufferRing::IOUringBufferRing(IOUring& uring, unsigned short group, unsigned count, size_t size)
+    : m_uring(uring), m_group(group), m_ring(NULL), m_buffers(NULL), m_count(count), m_size(size), m_tail(0),
+      m_valid(false), m_legacy(false) {
+    // count must be a power of two; the ring must be page aligned
+    size_t ringSize = count * sizeof(struct io_uring_buf);
+    void* memory = mmap(NULL, ringSize + count * size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return;
+    m_ring = (struct io_uring_buf_ring*)memory;
+    m_buffers = (char*)memory + ringSize;
+
+    if (m_uring.registerBufferRing(m_ring, count, group) == 0) {
+        for (unsigned i = 0; i < count; ++i) recycle((unsigned short)i);
+        publish();
+        if (probe()) {
+            m_valid = true;
+            return;
+        }
+        m_uring.unregisterBufferRing(group);
+    }
+
+    m_legacy = true;
+    provide(0, count);
+    m_valid = m_uring.submit(0) >= 0;
+}
+
+IOUringBufferRing::~IOUringBufferRing() {
+    if (m_ring != NULL) munmap(m_ring, m_count * (sizeof(struct io_uring_buf) + m_size));
+}
+
+// One byte through a pipe, read into a buffer of the ring; the ring must
+// be otherwise idle
+bool IOUringBufferRing::probe() {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) return false;
+    bool ok = write(fds[1], "x", 1) == 1;
+
+    struct io_uring_sqe* sqe = ok ? m_uring.getSqe() : NULL;
+    if (sqe != NULL) {
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fds[0];
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = m_group;
+        ok = m_uring.submit(1) == 1;
+    }
+    struct io_uring_cqe* cqe = ok ? m_uring.peek() : NULL;
+    ok = cqe != NULL && cqe->res == 1;
+    if (ok) {
+        recycle(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        publish();
+    }
+    if (cqe != NULL) m_uring.seen();
+
+    close(fds[0]);
+    close(fds[1]);
+    return ok;
+}
+
+void IOUringBufferRing::provide(unsigned short id, unsigned count) {
+    struct io_uring_sqe* sqe;
+    while ((sqe = m_uring.getSqe()) == NULL) {
+        m_uring.submit(0);
+    }
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = (int)count;
+    sqe->addr = (uint64_t)(uintptr_t)getBuffer(id);
+    sqe->len = (uint32_t)m_size;
+    sqe->off = id;
+    sqe->buf_group = m_group;
+    sqe->user_data = 0;  // completion carries nothing to act on
+}
+
+bool IOUringBufferRing::isValid() {
+    return m_valid;
+}
+
+bool IOUringBufferRing::isRing() {
+    return !m_legacy;
+}
+
+char* IOUringBufferRing::getBuffer(unsigned short id) {
+    return m_buffers + (size_t)id * m_size;
+}
+
+void IOUringBufferRing::recycle(unsigned short id) {
+    if (m_legacy) {
+        provide(id, 1);
+        return;
+    }
+    struct io_uring_buf* buf = &m_ring->bufs[m_tail & (m_count - 1)];
+    buf->addr = (uint64_t)(uintptr_t)getBuffer(id);
+    buf->len = (uint32_t)m_size;
+    buf->bid = id;
+    m_tail++;
+}
+
+void IOUringBufferRing::publish() {
+    if (m_legacy) return;  // the PROVIDE_BUFFERS SQEs go with the next submit
+    __atomic_store_n(&m_ring->tail, m_tail, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/*
+    Minimal io_uring over the raw syscalls (no liburing): one submission
+    and one completion queue mapped into this process. Queue SQEs with
+    getSqe(), hand them all to the kernel with one submit(), which can
+    also wait for completions, then walk the CQEs with peek()/seen().
+    Single-threaded.
+*/
+class IOUring {
+    int                   m_fd;
+    unsigned              m_entries;
+    unsigned              m_sqMask;
+    unsigned*             m_sqHead;
+    unsigned*             m_sqTail;
+    unsigned              m_sqQueued;     // local tail, published by submit()
+    unsigned              m_sqSubmitted;
+    struct io_uring_sqe*  m_sqes;
+    unsigned              m_cqMask;
+    unsigned*             m_cqHead;
+    unsigned*             m_cqTail;
+    struct io_uring_cqe*  m_cqes;
+    void*                 m_rings;
+    size_t                m_ringsSize;
+    size_t                m_sqesSize;
+    uint64_t              m_enters;
+
+    public:
+        // flags: IORING_SETUP_*; check isValid() (the kernel may refuse
+        // the flags, or io_uring altogether)
+        IOUring(unsigned entries, unsigned flags=0);
+        ~IOUring();
+
+        bool isValid();
+
+        // A zeroed SQE, or NULL when the queue is full (submit() first)
+        struct io_uring_sqe* getSqe();
+        // Submits everything queued and waits for at least waitFor
+        // completions, in one io_uring_enter. Returns how many SQEs the
+        // kernel took, or -errno.
+        int submit(unsigned waitFor=0);
+
+        // Next completion, or NULL; seen() releases it
+        struct io_uring_cqe* peek();
+        void seen();
+
+        int registerBuffers(const struct iovec* buffers, unsigned count);
+        int registerBufferRing(struct io_uring_buf_ring* ring, unsigned entries, unsigned short group);
+        int unregisterBufferRing(unsigned short group);
+
+        // io_uring_enter calls so far
+        uint64_t getEnters();
+
+    private:
+        IOUring(const IOUring&);
+        IOUring& operator=(const IOUring&);
+};
+
+/*
+    Provided buffers: count buffers of size bytes that the kernel picks
+    from for IOSQE_BUFFER_SELECT reads (e.g. multishot recv) in group. A
+    completion names its buffer; recycle() hands it back, and publish()
+    makes recycled buffers visible to the kernel in one store.
+
+    They live in a buffer ring shared with the kernel. Where the kernel
+    accepts the ring but never hands its buffers out (seen on some
+    virtualized kernels: every read fails with ENOBUFS), a probe read
+    catches it and the buffers are provided the older way instead, one
+    IORING_OP_PROVIDE_BUFFERS per recycle(), which rides along with the
+    next submit.
+*/
+class IOUringBufferRing {
+    IOUring&                  m_uring;
+    unsigned short            m_group;
+    struct io_uring_buf_ring* m_ring;
+    char*                     m_buffers;
+    unsigned                  m_count;
+    size_t                    m_size;
+    unsigned short            m_tail;
+    bool                      m_valid;
+    bool                      m_legacy;
+
+    public:
+        IOUringBufferRing(IOUring& uring, unsigned short group, unsigned count, size_t size);
+        ~IOUringBufferRing();
+
+        bool  isValid();
+        // false when the fallback to IORING_OP_PROVIDE_BUFFERS is in use
+        bool  isRing();
+        char* getBuffer(unsigned short id);
+        void  recycle(unsigned short id);
+        void  publish();
+
+    private:
+        bool  probe();
+        void  provide(unsigned short id, unsigned count);
+
+        IOUringBufferRing(const IOUringBufferRing&);
+        IOUringBufferRing& operator=(const IOUringBufferRing&);
+};